@@ -0,0 +1,131 @@
+#pragma once
+
+#include "constants.hpp"
+#include "point2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace geompp {
+class Executor;
+}
+
+// Many queries at once: a span of points against one geometry, or a span of geometries against one query, run in
+// chunks across threads. Each query has two forms: one returns the results in a new vector, the other writes them
+// into an output span of the size of the input and allocates nothing.
+// The results are the ones of the single queries (DistanceTo, Location, Contains, Intersection), in input order.
+namespace geompp::batch {
+
+struct Options {
+  int threads = 0;  // <= 0 means all those of the executor, 1 runs on the calling thread only
+  int chunk = 0;    // queries a thread takes at a time, 0 to size the chunks by the cache
+  int decimal_precision = DP_THREE;
+  Executor* executor = nullptr;  // nullptr for Executor::Default()
+};
+
+// Calls fn(first, last) over [0, size) in chunks of options.chunk (or of as many items of item_bytes as fit in half the
+// L1 cache), on up to options.threads threads of the executor, each taking the next chunk as it is done with its last
+// one, so that the slower chunks do not hold up the others. One thread, or one chunk, runs on the calling thread
+// without starting the executor. The first exception thrown by fn is rethrown, once all threads stopped.
+void for_each_chunk(int size, Options const& options, std::size_t item_bytes,
+                    std::function<void(int first, int last)> const& fn);
+
+namespace detail {
+
+// the results of the query of each input, into out
+template <typename In, typename Out, typename Query>
+void map(std::span<In const> in, std::span<Out> out, Options const& options, Query const& query) {
+  if (out.size() != in.size()) {
+    throw std::runtime_error("the output span must have the size of the input");
+  }
+  for_each_chunk(static_cast<int>(in.size()), options, sizeof(In) + sizeof(Out), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      out[i] = query(in[i]);
+    }
+  });
+}
+
+}  // namespace detail
+
+#pragma region Points
+
+template <typename Geometry>
+void DistanceTo(std::span<Point2D const> points, Geometry const& geometry, std::span<double> out,
+                Options const& options = {}) {
+  int dp = options.decimal_precision;
+  detail::map(points, out, options, [&geometry, dp](Point2D const& point) { return geometry.DistanceTo(point, dp); });
+}
+
+template <typename Geometry>
+std::vector<double> DistanceTo(std::span<Point2D const> points, Geometry const& geometry, Options const& options = {}) {
+  std::vector<double> out(points.size());
+  DistanceTo(points, geometry, std::span<double>(out), options);
+  return out;
+}
+
+template <typename Geometry>
+void Location(std::span<Point2D const> points, Geometry const& geometry, std::span<double> out,
+              Options const& options = {}) {
+  int dp = options.decimal_precision;
+  detail::map(points, out, options, [&geometry, dp](Point2D const& point) { return geometry.Location(point, dp); });
+}
+
+template <typename Geometry>
+std::vector<double> Location(std::span<Point2D const> points, Geometry const& geometry, Options const& options = {}) {
+  std::vector<double> out(points.size());
+  Location(points, geometry, std::span<double>(out), options);
+  return out;
+}
+
+// 1 if the geometry contains the point, 0 if not (bytes, as the bits of a std::vector<bool> can not be written by
+// different threads)
+template <typename Geometry>
+void Contains(std::span<Point2D const> points, Geometry const& geometry, std::span<std::uint8_t> out,
+              Options const& options = {}) {
+  int dp = options.decimal_precision;
+  detail::map(points, out, options, [&geometry, dp](Point2D const& point) -> std::uint8_t {
+    return geometry.Contains(point, dp) ? 1 : 0;
+  });
+}
+
+template <typename Geometry>
+std::vector<std::uint8_t> Contains(std::span<Point2D const> points, Geometry const& geometry,
+                                   Options const& options = {}) {
+  std::vector<std::uint8_t> out(points.size());
+  Contains(points, geometry, std::span<std::uint8_t>(out), options);
+  return out;
+}
+
+#pragma endregion
+
+#pragma region Geometries
+
+// geometries[i].Intersection(query) for each geometry, e.g. many LineSegment2D against one Line2D
+template <typename Geometry, typename Query>
+void Intersection(std::span<Geometry const> geometries, Query const& query,
+                  std::span<typename Geometry::ReturnSet> out, Options const& options = {}) {
+  int dp = options.decimal_precision;
+  detail::map(geometries, out, options,
+              [&query, dp](Geometry const& geometry) { return geometry.Intersection(query, dp); });
+}
+
+template <typename Geometry, typename Query>
+std::vector<typename Geometry::ReturnSet> Intersection(std::span<Geometry const> geometries, Query const& query,
+                                                       Options const& options = {}) {
+  std::vector<typename Geometry::ReturnSet> out(geometries.size());
+  Intersection(geometries, query, std::span<typename Geometry::ReturnSet>(out), options);
+  return out;
+}
+
+template <typename Geometry, typename Query>
+std::vector<typename Geometry::ReturnSet> Intersection(std::vector<Geometry> const& geometries, Query const& query,
+                                                       Options const& options = {}) {
+  return Intersection(std::span<Geometry const>(geometries), query, options);
+}
+
+#pragma endregion
+
+}  // namespace geompp::batch
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "constants.hpp"
+#include "point2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geompp {
+
+class Ray2D;
+
+// axis aligned box, stored as plain coordinates (cheap to copy in bulk, i.e. in index nodes)
+class BoundingBox2D {
+ public:
+  static inline BoundingBox2D Make(Point2D const& min, Point2D const& max) {
+    return {std::min(min.x(), max.x()), std::min(min.y(), max.y()), std::max(min.x(), max.x()),
+            std::max(min.y(), max.y())};
+  }
+  // contains nothing, the neutral element of Union
+  static inline BoundingBox2D Empty() {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    return {inf, inf, -inf, -inf};
+  }
+
+  inline Point2D Min() const { return {MIN_X, MIN_Y}; }
+  inline Point2D Max() const { return {MAX_X, MAX_Y}; }
+  inline double MinX() const { return MIN_X; }
+  inline double MinY() const { return MIN_Y; }
+  inline double MaxX() const { return MAX_X; }
+  inline double MaxY() const { return MAX_Y; }
+  inline double Width() const { return MAX_X - MIN_X; }
+  inline double Height() const { return MAX_Y - MIN_Y; }
+  inline bool IsEmpty() const { return MIN_X > MAX_X || MIN_Y > MAX_Y; }
+
+  inline BoundingBox2D Union(BoundingBox2D const& other) const {
+    return {std::min(MIN_X, other.MIN_X), std::min(MIN_Y, other.MIN_Y), std::max(MAX_X, other.MAX_X),
+            std::max(MAX_Y, other.MAX_Y)};
+  }
+  inline BoundingBox2D Union(Point2D const& point) const {
+    return {std::min(MIN_X, point.x()), std::min(MIN_Y, point.y()), std::max(MAX_X, point.x()),
+            std::max(MAX_Y, point.y())};
+  }
+
+  // exact tests, no tolerance: boxes are used to prune candidates, not to answer queries
+  inline bool Contains(Point2D const& point) const {
+    return MIN_X <= point.x() && point.x() <= MAX_X && MIN_Y <= point.y() && point.y() <= MAX_Y;
+  }
+  inline bool Intersects(BoundingBox2D const& other) const {
+    return MIN_X <= other.MAX_X && other.MIN_X <= MAX_X && MIN_Y <= other.MAX_Y && other.MIN_Y <= MAX_Y;
+  }
+  // 0 if the point is inside, not rounded
+  inline double DistanceTo(Point2D const& point) const {
+    double dx = std::max({MIN_X - point.x(), 0.0, point.x() - MAX_X});
+    double dy = std::max({MIN_Y - point.y(), 0.0, point.y() - MAX_Y});
+    return std::sqrt(dx * dx + dy * dy);
+  }
+  // grown by margin on every side
+  inline BoundingBox2D Expand(double margin) const {
+    return {MIN_X - margin, MIN_Y - margin, MAX_X + margin, MAX_Y + margin};
+  }
+
+  bool AlmostEquals(BoundingBox2D const& other, int decimal_precision = DP_THREE) const {
+    return Min().AlmostEquals(other.Min(), decimal_precision) && Max().AlmostEquals(other.Max(), decimal_precision);
+  }
+
+ private:
+  double MIN_X, MIN_Y, MAX_X, MAX_Y;
+
+  BoundingBox2D(double min_x, double min_y, double max_x, double max_y)
+      : MIN_X(min_x), MIN_Y(min_y), MAX_X(max_x), MAX_Y(max_y) {}
+};
+
+#pragma region Query Boxes
+
+// How far a query at a precision can reach out of the boxes of some segments, to prune the boxes without missing
+// anything that the linear scan finds: LineSegment2D::Contains accepts the points at h = 0.5 / 10^dp from the line
+// of the segment and up to h * max(length, 1 / length) beyond its end points (the location is a fraction of the
+// length, and its sign is rounded)
+inline double segment_reach(double length) { return std::max(length, 1 / length); }
+
+// the box widened by h * (reach + 1), plus some slack for the rounding errors on the coordinates
+BoundingBox2D widen_box(BoundingBox2D const& box, double reach, int decimal_precision);
+
+// the line through origin along dir has points within the box (on its corners or between them)
+bool box_crosses_line(BoundingBox2D const& box, Point2D const& origin, Vector2D const& dir);
+
+// some point of the box is ahead of the ray at the precision
+bool box_ahead_of_ray(BoundingBox2D const& box, Ray2D const& ray, int decimal_precision);
+
+#pragma endregion
+
+}  // namespace geompp
\ No newline at end of file
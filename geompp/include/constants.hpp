@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 
 namespace geompp {
 
@@ -10,6 +11,17 @@ const int DP_THREE = 3;
 const int DP_SIX = 6;
 const int DP_NINE = 9;
 
+// in place of a decimal precision: use the exact predicates (see predicates.hpp) instead of a rounding tolerance
+struct ExactPredicates {};
+inline constexpr ExactPredicates EXACT{};
+
+#pragma endregion
+
+#pragma region Binary
+
+// byte order of the WKB (Well-Known Binary) output, with the values of its byte order flag
+enum class Endian : std::uint8_t { BIG = 0, LITTLE = 1 };
+
 #pragma endregion
 
 }  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "point2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace geompp {
+
+// Uniform grid over the edges of closed rings (edge k = [knots[k], knots[k + 1]], for all knots but the last of each
+// ring), about one cell per edge: each cell lists the edges that cross it (walked column by column, not their boxes),
+// and keeps the winding number of the rings about its center. The winding number about a point is the one of the
+// center of its cell, changed by the edges crossed on the way from there (vertically to the row of the point, then
+// horizontally to it): only the edges of one cell are read, with the exact predicates, so a query costs about O(1)
+// for the rings of short edges.
+class EdgeGrid {
+ public:
+  // rings[i] are the knots [rings[i], rings[i + 1]), the last one of each ring the same as its first
+  static EdgeGrid Make(std::vector<Point2D> const& knots, std::vector<int> const& rings);
+
+  inline BoundingBox2D const& Box() const { return BOX; }
+  inline int Columns() const { return COLUMNS; }
+  inline int Rows() const { return ROWS; }
+  // the edges listed, summed over the cells: about the number of edges plus their lengths in cells
+  inline int Entries() const { return static_cast<int>(EDGES.size()); }
+
+  // the winding number of the rings about the point (0 out of the box), the same as the one counted on all the edges
+  // when the point is not on any; nullopt when the way from the center of its cell runs into a knot or along an edge,
+  // for the caller to count them all
+  std::optional<int> WindingNumber(std::vector<Point2D> const& knots, Point2D const& point) const;
+
+  // calls fn(k) on the edges of the cells that touch the box (an edge may come more than once), until fn returns true;
+  // returns whether it did
+  template <typename Fn>
+  bool Any(BoundingBox2D const& box, Fn&& fn) const {
+    if (!box.Intersects(BOX)) {
+      return false;
+    }
+    int c0 = Column(box.MinX()), c1 = Column(box.MaxX());
+    int r0 = Row(box.MinY()), r1 = Row(box.MaxY());
+    for (int r = r0; r <= r1; ++r) {
+      for (int c = c0; c <= c1; ++c) {
+        int cell = r * COLUMNS + c;
+        for (int i = OFFSETS[cell]; i < OFFSETS[cell + 1]; ++i) {
+          if (fn(EDGES[i])) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  static constexpr int ON_EDGE = std::numeric_limits<int>::min();  // the winding number of a center on an edge
+
+  BoundingBox2D BOX = BoundingBox2D::Empty();
+  int COLUMNS = 0, ROWS = 0;
+  double CELL_WIDTH = 0, CELL_HEIGHT = 0;
+  std::vector<int> OFFSETS;   // cell i (= row * COLUMNS + column) has the edges [OFFSETS[i], OFFSETS[i + 1])
+  std::vector<int> EDGES;     // by cell
+  std::vector<int> WINDINGS;  // about the center of each cell, or ON_EDGE
+
+  // the same function maps the points and the edges to the cells (monotonic, clamped to the grid), so that an edge
+  // crossing the way between a point and a center of the same cell is always listed in that cell
+  inline int Column(double x) const {
+    return std::clamp(static_cast<int>(std::floor((x - BOX.MinX()) / CELL_WIDTH)), 0, COLUMNS - 1);
+  }
+  inline int Row(double y) const {
+    return std::clamp(static_cast<int>(std::floor((y - BOX.MinY()) / CELL_HEIGHT)), 0, ROWS - 1);
+  }
+  inline Point2D Center(int column, int row) const {
+    return {BOX.MinX() + (column + 0.5) * CELL_WIDTH, BOX.MinY() + (row + 0.5) * CELL_HEIGHT};
+  }
+  // the rows [first, second] of the cells of the column that the edge a-b crosses, widened by a few ulps for the
+  // rounding of Column and Row (first > second when it does not reach the column)
+  std::pair<int, int> EdgeRows(Point2D const& a, Point2D const& b, int column) const;
+};
+
+}  // namespace geompp
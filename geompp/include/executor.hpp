@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geompp {
+
+// Work stealing thread pool for fork/join parallelism, shared by the parallel algorithms of the library.
+// Each worker has a queue of tasks: Join pushes one half of the work on the queue of the calling thread and runs the
+// other half itself, the idle workers steal the oldest (largest) tasks of the others. A thread waiting for a task
+// stolen from it runs other tasks in the meantime, instead of blocking, so nested parallel calls (a parallel_for
+// inside a parallel_for) never run more threads than the pool has. The threads outside the pool share one more queue.
+class Executor {
+ public:
+  // threads: the threads that run the tasks, counting the one waiting for them (the caller of Join, parallel_for, ...),
+  // so threads - 1 workers; <= 0 means one per hardware thread. pin binds each worker to a processor of its own.
+  explicit Executor(int threads = 0, bool pin = false);
+  Executor(Executor const&) = delete;
+  Executor& operator=(Executor const&) = delete;
+  ~Executor();  // the workers finish the queued tasks first
+
+  // the pool of the library, one thread per hardware thread, started on first use
+  static Executor& Default();
+
+  inline int Concurrency() const { return static_cast<int>(WORKERS.size()) + 1; }
+
+  // runs a() and b(), in parallel if a worker is free, and returns when both are done; if they throw, the exception
+  // of a (or else of b) is rethrown
+  template <typename A, typename B>
+  void Join(A&& a, B&& b) {
+    if (WORKERS.empty()) {
+      a();
+      b();
+      return;
+    }
+    FnTask<B> task(b);
+    Push(&task);
+    std::exception_ptr error;
+    try {
+      a();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (Reclaim(&task)) {
+      task.Run();
+    } else {
+      Wait(&task);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    if (task.error) {
+      std::rethrow_exception(task.error);
+    }
+  }
+
+#pragma region Collection Operations
+
+  // fn(i) for i in [first, last), split in halves down to ranges of at most grain items (0: about 4 per thread)
+  template <typename Fn>
+  void parallel_for(int first, int last, Fn&& fn, int grain = 0) {
+    Split(first, last, Grain(last - first, grain), [&fn](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        fn(i);
+      }
+    });
+  }
+
+  // reduce(... reduce(reduce(identity, map(first)), map(first + 1)) ..., map(last - 1)), computed by ranges in
+  // parallel: reduce must be associative, with identity as neutral element
+  template <typename T, typename Map, typename Reduce>
+  T parallel_reduce(int first, int last, T identity, Map&& map, Reduce&& reduce, int grain = 0) {
+    return ReduceRange(first, last, Grain(last - first, grain), identity, map, reduce);
+  }
+
+  // std::sort of [first, last) by comp: halves sorted in parallel, then merged, down to ranges of grain items
+  template <typename RandomIt, typename Compare = std::less<>>
+  void parallel_sort(RandomIt first, RandomIt last, Compare comp = {}, int grain = 0) {
+    int size = static_cast<int>(last - first);
+    SortRange(first, last, comp, std::max(SORT_MIN_GRAIN, Grain(size, grain)));
+  }
+
+#pragma endregion
+
+ private:
+  struct Task {
+    virtual void Run() = 0;
+    std::atomic<bool> done{false};
+    std::exception_ptr error;
+  };
+  // a task on the stack of the thread that pushed it, which waits for it to be done before leaving
+  template <typename Fn>
+  struct FnTask : Task {
+    explicit FnTask(Fn& fn) : fn(fn) {}
+    void Run() override {
+      try {
+        fn();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      done.store(true, std::memory_order_release);
+    }
+    Fn& fn;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task*> tasks;
+  };
+
+  static constexpr int SORT_MIN_GRAIN = 1 << 12;
+
+  std::vector<std::unique_ptr<Queue>> QUEUES;  // one per worker, then the one of the threads outside the pool
+  std::vector<std::thread> WORKERS;
+  std::atomic<int> PENDING{0};  // tasks in the queues
+  std::mutex SLEEP_MUTEX;
+  std::condition_variable WAKE;
+  bool STOP = false;
+
+  int Self() const;  // the queue of the calling thread
+  void Push(Task* task);
+  bool Reclaim(Task* task);  // takes the task back from the queue of the calling thread, unless it was stolen
+  bool RunOne(int self);     // the newest task of the own queue, or else the oldest of another one
+  void Wait(Task* task);
+  void Work(int index, bool pin);
+
+  inline int Grain(int size, int grain) const { return grain > 0 ? grain : std::max(1, size / (4 * Concurrency())); }
+
+  template <typename Range>
+  void Split(int first, int last, int grain, Range const& range) {
+    if (last - first <= grain) {
+      range(first, last);
+      return;
+    }
+    int mid = first + (last - first) / 2;
+    Join([&] { Split(first, mid, grain, range); }, [&] { Split(mid, last, grain, range); });
+  }
+
+  template <typename T, typename Map, typename Reduce>
+  T ReduceRange(int first, int last, int grain, T const& identity, Map& map, Reduce& reduce) {
+    if (last - first <= grain) {
+      T result = identity;
+      for (int i = first; i < last; ++i) {
+        result = reduce(result, map(i));
+      }
+      return result;
+    }
+    int mid = first + (last - first) / 2;
+    T left = identity, right = identity;
+    Join([&] { left = ReduceRange(first, mid, grain, identity, map, reduce); },
+         [&] { right = ReduceRange(mid, last, grain, identity, map, reduce); });
+    return reduce(left, right);
+  }
+
+  template <typename RandomIt, typename Compare>
+  void SortRange(RandomIt first, RandomIt last, Compare& comp, int grain) {
+    if (last - first <= grain) {
+      std::sort(first, last, comp);
+      return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+    Join([&] { SortRange(first, mid, comp, grain); }, [&] { SortRange(mid, last, comp, grain); });
+    std::inplace_merge(first, mid, last, comp);
+  }
+};
+
+}  // namespace geompp
\ No newline at end of file
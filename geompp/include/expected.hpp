@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#ifdef __cpp_lib_expected
+#include <expected>
+#endif
+
+namespace geompp {
+
+// why a TryMake / TryFromWkt gave no geometry: a plain enum, no message is built
+enum class GeomError : std::uint8_t {
+  POINTS_TOO_CLOSE,  // the two points of a line or segment are equal at the precision
+  ZERO_DIRECTION,    // the direction of a line or ray is almost zero at the precision
+  TOO_FEW_POINTS,    // less than 2 unique non-collinear consecutive points for a polyline
+  BAD_WKT,           // the text is not the WKT of the geometry
+  BAD_PRECISION,     // a decimal precision above the digits of the coordinate type (MAX_DECIMAL_PRECISION)
+  DEGENERATE_RING,   // less than 3 unique non-collinear points in a ring of a polygon, or no area at the precision
+};
+
+inline char const* to_string(GeomError error) {
+  switch (error) {
+    case GeomError::POINTS_TOO_CLOSE:
+      return "the points are too close";
+    case GeomError::ZERO_DIRECTION:
+      return "the direction is almost zero";
+    case GeomError::TOO_FEW_POINTS:
+      return "less than 2 unique non-collinear consecutive points";
+    case GeomError::BAD_WKT:
+      return "bad WKT";
+    case GeomError::BAD_PRECISION:
+      return "the decimal precision is above the digits of the coordinates";
+    case GeomError::DEGENERATE_RING:
+      return "a ring has less than 3 unique non-collinear points";
+  }
+  return "unknown error";
+}
+
+#ifdef __cpp_lib_expected
+
+template <typename T, typename E>
+using expected = std::expected<T, E>;
+template <typename E>
+using unexpected = std::unexpected<E>;
+template <typename E>
+using bad_expected_access = std::bad_expected_access<E>;
+
+#else
+
+// The part of C++23 std::expected the library uses, for C++20: a value or an error, built in place (no assignment
+// operator of T is called), same names and semantics as the standard one. An assignment that throws leaves the
+// expected as it was, as the standard's reinit-expected does.
+
+template <typename E>
+class unexpected {
+ public:
+  constexpr explicit unexpected(E error) : ERROR(std::move(error)) {}
+  constexpr E const& error() const& { return ERROR; }
+
+ private:
+  E ERROR;
+};
+
+template <typename E>
+class bad_expected_access : public std::exception {
+ public:
+  explicit bad_expected_access(E error) : ERROR(std::move(error)) {}
+  char const* what() const noexcept override { return "bad access to expected without a value"; }
+  E const& error() const& { return ERROR; }
+
+ private:
+  E ERROR;
+};
+
+template <typename T, typename E>
+class expected {
+ public:
+  using value_type = T;
+  using error_type = E;
+
+  expected(T const& value) : HAS_VALUE(true) { std::construct_at(&VALUE, value); }
+  expected(T&& value) : HAS_VALUE(true) { std::construct_at(&VALUE, std::move(value)); }
+  expected(unexpected<E> const& error) : HAS_VALUE(false) { std::construct_at(&ERROR, error.error()); }
+  expected(expected const& other) : HAS_VALUE(other.HAS_VALUE) { ConstructFrom(other); }
+  expected(expected&& other) noexcept(NOTHROW_MOVE) : HAS_VALUE(other.HAS_VALUE) {
+    ConstructFrom(std::move(other));
+  }
+  expected& operator=(expected const& other) {
+    if (this != &other) {
+      AssignFrom(other);
+    }
+    return *this;
+  }
+  expected& operator=(expected&& other) noexcept(NOTHROW_MOVE) {
+    if (this != &other) {
+      AssignFrom(std::move(other));
+    }
+    return *this;
+  }
+  ~expected() { Destroy(); }
+
+  inline bool has_value() const { return HAS_VALUE; }
+  inline explicit operator bool() const { return HAS_VALUE; }
+
+  inline T const& operator*() const& { return VALUE; }
+  inline T& operator*() & { return VALUE; }
+  inline T&& operator*() && { return std::move(VALUE); }
+  inline T const* operator->() const { return &VALUE; }
+  inline T* operator->() { return &VALUE; }
+
+  T const& value() const& {
+    Check();
+    return VALUE;
+  }
+  T& value() & {
+    Check();
+    return VALUE;
+  }
+  T&& value() && {
+    Check();
+    return std::move(VALUE);
+  }
+  inline E const& error() const& { return ERROR; }
+
+  template <typename U>
+  T value_or(U&& other) const& {
+    return HAS_VALUE ? VALUE : static_cast<T>(std::forward<U>(other));
+  }
+
+ private:
+  static constexpr bool NOTHROW_MOVE =
+      std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>;
+
+  bool HAS_VALUE;
+  union {
+    T VALUE;
+    E ERROR;
+  };
+
+  void Check() const {
+    if (!HAS_VALUE) {
+      throw bad_expected_access<E>(ERROR);
+    }
+  }
+  template <typename Other>
+  void ConstructFrom(Other&& other) {
+    if (HAS_VALUE) {
+      std::construct_at(&VALUE, std::forward<Other>(other).VALUE);
+    } else {
+      std::construct_at(&ERROR, std::forward<Other>(other).ERROR);
+    }
+  }
+  template <typename Other>
+  void AssignFrom(Other&& other) {
+    if (HAS_VALUE && other.HAS_VALUE) {
+      Reinit(&VALUE, &VALUE, std::forward<Other>(other).VALUE);
+    } else if (HAS_VALUE) {
+      Reinit(&ERROR, &VALUE, std::forward<Other>(other).ERROR);
+    } else if (other.HAS_VALUE) {
+      Reinit(&VALUE, &ERROR, std::forward<Other>(other).VALUE);
+    } else {
+      Reinit(&ERROR, &ERROR, std::forward<Other>(other).ERROR);
+    }
+    HAS_VALUE = other.HAS_VALUE;
+  }
+  // replaces the old object by a new one built from arg: the old one is destroyed only once nothing can throw, or
+  // is put back if the new one throws
+  template <typename New, typename Old, typename Arg>
+  static void Reinit(New* fresh, Old* old, Arg&& arg) {
+    if constexpr (std::is_nothrow_constructible_v<New, Arg>) {
+      std::destroy_at(old);
+      std::construct_at(fresh, std::forward<Arg>(arg));
+    } else if constexpr (std::is_nothrow_move_constructible_v<New>) {
+      New temp(std::forward<Arg>(arg));
+      std::destroy_at(old);
+      std::construct_at(fresh, std::move(temp));
+    } else {
+      Old backup(std::move(*old));
+      std::destroy_at(old);
+      try {
+        std::construct_at(fresh, std::forward<Arg>(arg));
+      } catch (...) {
+        std::construct_at(old, std::move(backup));
+        throw;
+      }
+    }
+  }
+  void Destroy() {
+    if (HAS_VALUE) {
+      std::destroy_at(&VALUE);
+    } else {
+      std::destroy_at(&ERROR);
+    }
+  }
+};
+
+#endif
+
+}  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "point2d.hpp"
+#include "point_buffer2d.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace geompp {
+
+// Static KD-tree over points, bulk loaded and immutable. The tree is implicit: the points are reordered so that the
+// median of each range [first, last) splits it along the axis of its largest spread, at (first + last) / 2, down to
+// leaves of at most LEAF_SIZE points, stored as a structure of arrays like PointBuffer2D.
+// Unlike Point2D::DistanceTo the queries work on exact, squared distances (no rounding), and return the indices of the
+// points in the input collection. Ties are broken by the smallest index, so the results do not depend on the build.
+// With threads > 1 the build and the batch queries are split in up to threads parts, run on Executor::Default();
+// threads <= 0 means as many as the executor has.
+class KDTree2D {
+ public:
+  static KDTree2D Make(std::vector<Point2D> const& points, int threads = 1);
+  static KDTree2D Make(PointBuffer2D const& points, int threads = 1);
+  KDTree2D(KDTree2D const&) = default;
+  KDTree2D(KDTree2D&&) = default;
+  ~KDTree2D() = default;
+
+  static constexpr int LEAF_SIZE = 16;
+
+  inline int Size() const { return static_cast<int>(XS.size()); }
+  // BoundingBox2D::Empty() if there are no points
+  BoundingBox2D BoundingBox() const;
+
+#pragma region Queries
+
+  struct Neighbour {
+    int index;
+    double squared_distance;
+  };
+
+  // the nearest point (throws if there are no points)
+  Neighbour Nearest(Point2D const& point) const;
+  // the k nearest points (or all of them, if less than k), by increasing distance, then index
+  std::vector<Neighbour> KNearest(Point2D const& point, int k) const;
+  // the points within the radius (distance <= radius), by increasing index
+  std::vector<int> Within(Point2D const& point, double radius) const;
+
+  // the same queries for many points at once, split across threads, the results in the order of the queries
+  std::vector<Neighbour> Nearest(std::vector<Point2D> const& points, int threads = 1) const;
+  std::vector<std::vector<Neighbour>> KNearest(std::vector<Point2D> const& points, int k, int threads = 1) const;
+  std::vector<std::vector<int>> Within(std::vector<Point2D> const& points, double radius, int threads = 1) const;
+
+#pragma endregion
+
+ private:
+  std::vector<double> XS, YS;       // the points, in tree order
+  std::vector<int> INDICES;         // index in the input of each point
+  std::vector<std::uint8_t> AXES;   // split axis of the range whose median is at i (0 = x, 1 = y)
+
+  KDTree2D(std::vector<double> const& xs, std::vector<double> const& ys, int threads);
+
+  // the points are moved around by the build together with their index, then split into the arrays above
+  struct Entry {
+    double coords[2];
+    int index;
+  };
+  void Build(std::vector<Entry>& entries, int first, int last, int threads);
+
+  // the k nearest of the points in [first, last) so far, in a max heap of (squared distance, index)
+  void Search(Point2D const& point, int first, int last, int k, std::vector<std::pair<double, int>>& heap) const;
+  void Collect(Point2D const& point, double squared_radius, int first, int last, std::vector<int>& found) const;
+};
+
+}  // namespace geompp
\ No newline at end of file
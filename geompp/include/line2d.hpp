@@ -1,23 +1,31 @@
 #pragma once
 
 #include "constants.hpp"
+#include "expected.hpp"
 #include "point2d.hpp"
 #include "vector2d.hpp"
 
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace geompp {
 
 class Ray2D;
-class LineSegment2D;
 class Shape2D;
 
 class Line2D {
  public:
   static Line2D Make(Point2D const& p0, Point2D const& p1, int decimal_precision = DP_THREE);
   static Line2D Make(Point2D const& orig, Vector2D const& dir, int decimal_precision = DP_THREE);
+  // as Make, without throwing: the error instead of the line
+  static expected<Line2D, GeomError> TryMake(Point2D const& p0, Point2D const& p1, int decimal_precision = DP_THREE);
+  static expected<Line2D, GeomError> TryMake(Point2D const& orig, Vector2D const& dir,
+                                             int decimal_precision = DP_THREE);
   Line2D(Line2D const&) = default;
   Line2D(Line2D&&) = default;
   ~Line2D() = default;
@@ -32,10 +40,15 @@ class Line2D {
 
   std::string ToWkt(int decimal_precision = DP_THREE) const;
   static Line2D FromWkt(std::string const& wkt);
+  static expected<Line2D, GeomError> TryFromWkt(std::string_view wkt);  // as FromWkt, without throwing or logging
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
   static Line2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static Line2D FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static Line2D FromWkbFile(std::string const& path, int decimal_precision = DP_THREE);
 
-  Line2D& operator=(Line2D const& other);
+  Line2D& operator=(Line2D const&) = default;
 
 #pragma region Geometrical Operations
   bool Contains(Point2D const& point, int decimal_precision = DP_THREE) const;
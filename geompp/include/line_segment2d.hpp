@@ -1,62 +1,110 @@
 #pragma once
 
+#include "bounding_box2d.hpp"
 #include "constants.hpp"
+#include "expected.hpp"
 #include "point2d.hpp"
 #include "vector2d.hpp"
 
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace geompp {
 
 class Line2D;
 class Ray2D;
 
-class LineSegment2D {
+// The segment of two points of type T; the operations with the double geometries (Line2D, Ray2D, the boxes) and the
+// intersection kernels run in double, where the products of floats are exact, then round the points back to T.
+template <Scalar T>
+class BasicLineSegment2D {
  public:
-  static LineSegment2D Make(Point2D const& p0, Point2D const& p1, int decimal_precision = DP_THREE);
-  LineSegment2D(LineSegment2D const&) = default;
-  LineSegment2D(LineSegment2D&&) = default;
-  ~LineSegment2D() = default;
-
-  inline Point2D const& First() const { return P0; }
-  inline Point2D const& Last() const { return P1; }
-
-  bool AlmostEquals(LineSegment2D const& other, int decimal_precision = DP_THREE) const;
+  static BasicLineSegment2D Make(BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1,
+                                 int decimal_precision = DP_THREE);
+  // as Make, without throwing: the error instead of the segment
+  static expected<BasicLineSegment2D, GeomError> TryMake(BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1,
+                                                         int decimal_precision = DP_THREE);
+  // from the segment of the other scalar type, checked again at the precision (rounding to float can bring the points
+  // together)
+  template <Scalar U>
+  static BasicLineSegment2D Make(BasicLineSegment2D<U> const& other, int decimal_precision = DP_THREE) {
+    return Make(BasicPoint2D<T>(other.First()), BasicPoint2D<T>(other.Last()), decimal_precision);
+  }
+  template <Scalar U>
+  static expected<BasicLineSegment2D, GeomError> TryMake(BasicLineSegment2D<U> const& other,
+                                                         int decimal_precision = DP_THREE) {
+    return TryMake(BasicPoint2D<T>(other.First()), BasicPoint2D<T>(other.Last()), decimal_precision);
+  }
+  // from the float segment, exact
+  template <Scalar U>
+    requires(sizeof(U) < sizeof(T))
+  explicit BasicLineSegment2D(BasicLineSegment2D<U> const& other)
+      : P0(BasicPoint2D<T>(other.First())), P1(BasicPoint2D<T>(other.Last())) {}
+  BasicLineSegment2D(BasicLineSegment2D const&) = default;
+  BasicLineSegment2D(BasicLineSegment2D&&) = default;
+  ~BasicLineSegment2D() = default;
+
+  inline BasicPoint2D<T> const& First() const { return P0; }
+  inline BasicPoint2D<T> const& Last() const { return P1; }
+
+  bool AlmostEquals(BasicLineSegment2D const& other, int decimal_precision = DP_THREE) const;
   Line2D ToLine(int decimal_precision = DP_THREE) const;
   double Length() const;
-  double DistanceTo(Point2D const& point, int decimal_precision = DP_THREE) const;
-  double Location(Point2D const& point, int decimal_precision = DP_THREE) const;
-  Point2D Interpolate(double pct) const;
+  double DistanceTo(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  double Location(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  BasicPoint2D<T> Interpolate(double pct) const;
+  inline BoundingBox2D BoundingBox() const { return BoundingBox2D::Make(Point2D(P0), Point2D(P1)); }
 
   std::string ToWkt(int decimal_precision = DP_THREE) const;
-  static LineSegment2D FromWkt(std::string const& wkt);
+  static BasicLineSegment2D FromWkt(std::string const& wkt);
+  // as FromWkt, without throwing or logging
+  static expected<BasicLineSegment2D, GeomError> TryFromWkt(std::string_view wkt);
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
-  static LineSegment2D FromFile(std::string const& path);
+  static BasicLineSegment2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static BasicLineSegment2D FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static BasicLineSegment2D FromWkbFile(std::string const& path, int decimal_precision = DP_THREE);
 
-  LineSegment2D& operator=(LineSegment2D const& other);
+  BasicLineSegment2D& operator=(BasicLineSegment2D const&) = default;
 
 #pragma region Geometrical Operations
-  bool Contains(Point2D const& point, int decimal_precision = DP_THREE) const;
-  using ReturnSet = std::optional<std::variant<Point2D>>;
+  bool Contains(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  using ReturnSet = std::optional<std::variant<BasicPoint2D<T>>>;
   bool Intersects(Line2D const& line, int decimal_precision = DP_THREE) const;
   bool Intersects(Ray2D const& ray, int decimal_precision = DP_THREE) const;
-  bool Intersects(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
+  bool Intersects(BasicLineSegment2D const& segment, int decimal_precision = DP_THREE) const;
   ReturnSet Intersection(Line2D const& line, int decimal_precision = DP_THREE) const;
   ReturnSet Intersection(Ray2D const& ray, int decimal_precision = DP_THREE) const;
-  ReturnSet Intersection(LineSegment2D const& other, int decimal_precision = DP_THREE) const;
+  ReturnSet Intersection(BasicLineSegment2D const& other, int decimal_precision = DP_THREE) const;
+  bool Intersects(BasicLineSegment2D const& segment, ExactPredicates) const;
+  ReturnSet Intersection(BasicLineSegment2D const& other, ExactPredicates) const;  // parallel segments don't intersect
 #pragma endregion
 
  private:
-  Point2D P0, P1;
+  BasicPoint2D<T> P0, P1;
 
-  LineSegment2D(Point2D const& p0, Point2D const& p1);
+  BasicLineSegment2D(BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1);
+
+  friend class BasicPolyline2D<T>;  // builds its segments from knots that are already unique
+  friend class LineSegmentBuffer2D;
 };
 
+// defined in line_segment2d.cpp for these two only
+extern template class BasicLineSegment2D<double>;
+extern template class BasicLineSegment2D<float>;
+
 #pragma region Operator Overloading
 
-bool operator==(LineSegment2D const& lhs, LineSegment2D const& rhs);
+template <Scalar T>
+inline bool operator==(BasicLineSegment2D<T> const& lhs, BasicLineSegment2D<T> const& rhs) {
+  return lhs.AlmostEquals(rhs);
+}
 
 #pragma endregion
 
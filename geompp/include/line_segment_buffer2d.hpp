@@ -0,0 +1,54 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "constants.hpp"
+#include "line_segment2d.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geompp {
+
+// Segments stored as a structure of arrays (x0, y0, x1, y1), to test one segment against many at once.
+// The batch kernels use AVX2 (when built with GEOMPP_AVX2) or SSE2, and a scalar loop elsewhere (see simd.hpp).
+class LineSegmentBuffer2D {
+ public:
+  LineSegmentBuffer2D() = default;
+  static LineSegmentBuffer2D Make(std::vector<LineSegment2D> const& segments);
+  std::vector<LineSegment2D> ToSegments() const;
+
+  inline int Size() const { return static_cast<int>(X0.size()); }
+  LineSegment2D At(int i) const;
+
+  void Reserve(int size);
+  void PushBack(LineSegment2D const& segment);
+
+#pragma region Batch Operations
+
+  // segment against every At(i), with the tests of LineSegment2D::Intersection (parallel segments don't intersect,
+  // the ends are within the tolerance as Contains and Location find them) done on the parameters of the two segments,
+  // without building the lines; a hit may differ from LineSegment2D::Intersects only by the rounding of a bound:
+  //  - hits[i] = 1 if they intersect, 0 otherwise
+  //  - t[i] locates the intersection on segment: segment.First() + t[i] * (segment.Last() - segment.First())
+  //  - s[i] locates it on At(i), in the same way
+  // t and s are left unspecified where there is no hit
+  struct Intersections {
+    std::vector<std::uint8_t> hits;
+    std::vector<double> t, s;
+  };
+  Intersections Intersection(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
+  void Intersection(LineSegment2D const& segment, std::span<std::uint8_t> hits, std::span<double> t,
+                    std::span<double> s, int decimal_precision = DP_THREE) const;
+  std::vector<std::uint8_t> Intersects(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
+
+  // BoundingBox2D::Empty() if there are no segments
+  BoundingBox2D BoundingBox() const;
+
+#pragma endregion
+
+ private:
+  std::vector<double> X0, Y0, X1, Y1;
+};
+
+}  // namespace geompp
\ No newline at end of file
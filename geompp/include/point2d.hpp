@@ -1,66 +1,124 @@
 #pragma once
 
 #include "constants.hpp"
+#include "expected.hpp"
+#include "scalar.hpp"
+#include "vector2d.hpp"
 
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace geompp {
 
-class Vector2D;
-
-class Point2D {
+// two coordinates, trivially copyable (see the static_asserts below), with the arithmetic inline
+template <Scalar T>
+class BasicPoint2D {
  public:
-  Point2D(double x = 0.0, double y = 0.0);
-  Point2D(Point2D const&);
-  Point2D(Point2D&&) = default;
-  ~Point2D() = default;
+  constexpr BasicPoint2D(T x = 0.0, T y = 0.0) : X(x), Y(y) {}
+  // from the point of the other scalar type (float to double is exact, double to float rounds)
+  template <Scalar U>
+  explicit constexpr BasicPoint2D(BasicPoint2D<U> const& other)
+      : X(static_cast<T>(other.x())), Y(static_cast<T>(other.y())) {}
 
-  inline double x() const { return X; }
-  inline double y() const { return Y; }
+  inline constexpr T x() const { return X; }
+  inline constexpr T y() const { return Y; }
 
-  Vector2D ToVector();
-  bool AlmostEquals(Point2D const& other, int decimal_precision = DP_THREE) const;
-  double DistanceTo(Point2D const& other, int decimal_precision = DP_THREE) const;
+  inline constexpr BasicVector2D<T> ToVector() const { return {X, Y}; }
+  bool AlmostEquals(BasicPoint2D const& other, int decimal_precision = DP_THREE) const;
+  double DistanceTo(BasicPoint2D const& other, int decimal_precision = DP_THREE) const;
 
   std::string ToWkt(int decimal_precision = DP_THREE) const;
-  static Point2D FromWkt(std::string const& wkt);
+  static BasicPoint2D FromWkt(std::string const& wkt);
+  // as FromWkt, without throwing or logging
+  static expected<BasicPoint2D, GeomError> TryFromWkt(std::string_view wkt);
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
-  static Point2D FromFile(std::string const& path);
-
-  Point2D& operator=(Point2D const& other);
+  static BasicPoint2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static BasicPoint2D FromWkb(std::span<std::uint8_t const> wkb);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static BasicPoint2D FromWkbFile(std::string const& path);
 
-  static inline Point2D Origin() { return Point2D(); }
+  static inline constexpr BasicPoint2D Origin() { return BasicPoint2D(); }
 
 #pragma region Collection Operations
 
-  static std::vector<Point2D> remove_duplicates(std::vector<Point2D> const& points, int decimal_precision = DP_THREE);
+  // which duplicates to remove: the ones next to each other (as in a polyline), or any of them (as in a point cloud)
+  enum class Duplicates { CONSECUTIVE, GLOBAL };
+
+  // keeps the first of the points that are equal at the precision, in O(N) (expected, with a hash grid, if GLOBAL)
+  static std::vector<BasicPoint2D> remove_duplicates(std::vector<BasicPoint2D> const& points,
+                                                     int decimal_precision = DP_THREE,
+                                                     Duplicates mode = Duplicates::CONSECUTIVE);
 
-  static std::vector<Point2D> remove_collinear(std::vector<Point2D> const& points, int decimal_precision = DP_THREE);
+  static std::vector<BasicPoint2D> remove_collinear(std::vector<BasicPoint2D> const& points,
+                                                    int decimal_precision = DP_THREE);
+
+  // the consecutive duplicates and the collinear points removed in one pass, in place: each point is checked against
+  // the last two kept (the front of the vector, used as a stack), so nothing is allocated
+  static void remove_duplicates_and_collinear(std::vector<BasicPoint2D>& points, int decimal_precision = DP_THREE);
 
 #pragma endregion
 
  private:
-  double X, Y;
+  T X, Y;
 };
 
-#pragma region Operators Overloading
+// defined in point2d.cpp for these two only
+extern template class BasicPoint2D<double>;
+extern template class BasicPoint2D<float>;
 
-bool operator==(Point2D const& lhs, Point2D const& rhs);
-
-Point2D operator+(Point2D const& lhs, Vector2D const& rhs);
+#pragma region Operators Overloading
 
-Vector2D operator-(Point2D const& lhs, Point2D const& rhs);
-Point2D operator-(Point2D const& lhs, Vector2D const& rhs);
+// the scalar operands take the type of the point (std::type_identity_t: not deduced from them)
+
+template <Scalar T>
+inline bool operator==(BasicPoint2D<T> const& lhs, BasicPoint2D<T> const& rhs) { return lhs.AlmostEquals(rhs); }
+
+template <Scalar T>
+inline constexpr BasicPoint2D<T> operator+(BasicPoint2D<T> const& lhs, BasicVector2D<T> const& rhs) {
+  return {lhs.x() + rhs.x(), lhs.y() + rhs.y()};
+}
+template <Scalar T>
+inline constexpr BasicPoint2D<T> operator+(BasicVector2D<T> const& lhs, BasicPoint2D<T> const& rhs) {
+  return {lhs.x() + rhs.x(), lhs.y() + rhs.y()};
+}
+
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator-(BasicPoint2D<T> const& lhs, BasicPoint2D<T> const& rhs) {
+  return {lhs.x() - rhs.x(), lhs.y() - rhs.y()};
+}
+template <Scalar T>
+inline constexpr BasicPoint2D<T> operator-(BasicPoint2D<T> const& lhs, BasicVector2D<T> const& rhs) {
+  return {lhs.x() - rhs.x(), lhs.y() - rhs.y()};
+}
+
+template <Scalar T>
+inline constexpr BasicPoint2D<T> operator*(BasicPoint2D<T> const& lhs, std::type_identity_t<T> a) {
+  return {lhs.x() * a, lhs.y() * a};
+}
+template <Scalar T>
+inline constexpr BasicPoint2D<T> operator*(std::type_identity_t<T> a, BasicPoint2D<T> const& rhs) { return rhs * a; }
+template <Scalar T>
+BasicPoint2D<T> operator*(BasicPoint2D<T> const& lhs, BasicPoint2D<T> const& rhs) = delete;
+template <Scalar T>
+BasicPoint2D<T> operator+(BasicPoint2D<T> const& lhs, BasicPoint2D<T> const& rhs) = delete;
+
+template <Scalar T>
+BasicPoint2D<T> operator/(BasicPoint2D<T> const& lhs, BasicPoint2D<T> const& rhs) = delete;
 
-Point2D operator*(Point2D const& lhs, double a);
-Point2D operator*(double a, Point2D const& rhs);
-Point2D operator*(Point2D const& lhs, Point2D const& rhs) = delete;
-Point2D operator+(Point2D const& lhs, Point2D const& rhs) = delete;
+#pragma endregion
 
-Point2D operator/(Point2D const& lhs, Point2D const& rhs) = delete;
+template <Scalar T>
+inline constexpr BasicPoint2D<T> BasicVector2D<T>::ToPoint() const { return {X, Y}; }
 
-#pragma endregion
+// copied, stored and written (WKB, files, buffers) as two plain coordinates
+static_assert(std::is_trivially_copyable_v<Point2D> && std::is_standard_layout_v<Point2D>);
+static_assert(sizeof(Point2D) == 2 * sizeof(double) && alignof(Point2D) == alignof(double));
+static_assert(std::is_trivially_copyable_v<Point2Df> && sizeof(Point2Df) == 2 * sizeof(float));
 
 #pragma region Formatter
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "constants.hpp"
+#include "point2d.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geompp {
+
+
+// Points stored as a structure of arrays (all x, then all y), for batch operations over many points at once.
+// The batch kernels use AVX2 (when built with GEOMPP_AVX2) or SSE2, and a scalar loop elsewhere.
+class PointBuffer2D {
+ public:
+  PointBuffer2D() = default;
+  static PointBuffer2D Make(std::vector<Point2D> const& points);
+  std::vector<Point2D> ToPoints() const;
+
+  inline int Size() const { return static_cast<int>(XS.size()); }
+  inline Point2D At(int i) const { return {XS[i], YS[i]}; }
+  inline std::vector<double> const& Xs() const { return XS; }
+  inline std::vector<double> const& Ys() const { return YS; }
+
+  void Reserve(int size);
+  void PushBack(Point2D const& point);
+
+#pragma region Batch Operations
+
+  // distance of each point to the given one, not rounded (unlike Point2D::DistanceTo)
+  std::vector<double> DistancesTo(Point2D const& point) const;
+  void DistancesTo(Point2D const& point, std::span<double> out) const;
+
+  // 1 where At(i).AlmostEquals(point, decimal_precision), 0 elsewhere
+  std::vector<std::uint8_t> AlmostEquals(Point2D const& point, int decimal_precision = DP_THREE) const;
+  void AlmostEquals(Point2D const& point, std::span<std::uint8_t> out, int decimal_precision = DP_THREE) const;
+
+  // in place, as point + vector and point * a
+  void Translate(Vector2D const& v);
+  void Scale(double a);
+
+  // BoundingBox2D::Empty() if there are no points
+  BoundingBox2D BoundingBox() const;
+
+  // instruction set of the batch kernels: "avx2", "sse2" or "scalar"
+  static char const* Simd();
+
+#pragma endregion
+
+ private:
+  std::vector<double> XS, YS;
+};
+
+}  // namespace geompp
\ No newline at end of file
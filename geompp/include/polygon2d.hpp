@@ -0,0 +1,92 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "constants.hpp"
+#include "expected.hpp"
+#include "point2d.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace geompp {
+
+class EdgeGrid;
+
+// A polygon: its exterior ring and the holes in it, each ring closed (its last knot is its first one, as in WKT).
+// The rings turn counterclockwise for the exterior and clockwise for the holes (as in OGC Simple Features), so that the
+// winding number is 1 inside and 0 outside or in a hole.
+class Polygon2D {
+ public:
+  // the rings closed when they are not, without their duplicate and collinear knots at the precision, and turned as
+  // above; the holes are not checked to be in the exterior, nor the rings not to cross each other
+  static Polygon2D Make(std::vector<Point2D> const& exterior, std::vector<std::vector<Point2D>> const& holes = {},
+                        int decimal_precision = DP_THREE);
+  // as Make, without throwing: the error instead of the polygon
+  static expected<Polygon2D, GeomError> TryMake(std::vector<Point2D> const& exterior,
+                                                std::vector<std::vector<Point2D>> const& holes = {},
+                                                int decimal_precision = DP_THREE);
+  Polygon2D(Polygon2D const&) = default;
+  Polygon2D(Polygon2D&&) = default;
+  ~Polygon2D() = default;
+
+  inline int Size() const { return KNOTS.size(); }  // the knots of all the rings, the closing ones too
+  inline int Rings() const { return RINGS.size() - 1; }
+  inline std::span<Point2D const> Ring(int i) const { return {KNOTS.data() + RINGS[i], KNOTS.data() + RINGS[i + 1]}; }
+  inline std::span<Point2D const> Exterior() const { return Ring(0); }
+  inline int Holes() const { return Rings() - 1; }
+  inline std::span<Point2D const> Hole(int i) const { return Ring(i + 1); }
+
+  bool AlmostEquals(Polygon2D const& other, int decimal_precision = DP_THREE) const;
+  double Area() const;  // of the exterior, less the holes
+  BoundingBox2D BoundingBox() const;
+
+  std::string ToWkt(int decimal_precision = DP_THREE) const;
+  // at the precision of the text (the most decimal places written in any of its numbers)
+  static Polygon2D FromWkt(std::string const& wkt);
+  static expected<Polygon2D, GeomError> TryFromWkt(std::string_view wkt);  // as FromWkt, without throwing or logging
+  void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
+  static Polygon2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static Polygon2D FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static Polygon2D FromWkbFile(std::string const& path, int decimal_precision = DP_THREE);
+
+  Polygon2D& operator=(Polygon2D const&) = default;
+
+#pragma region Geometrical Operations
+  // inside and not in a hole, or on a ring at the precision (round_to(distance, decimal_precision) == 0): by the
+  // winding number of all the edges, in O(N), or with the edge grid of the polygons of more than GRID_MIN_SIZE edges,
+  // in about O(1) once it is built
+  bool Contains(Point2D const& point, int decimal_precision = DP_THREE) const;
+  // of the rings about the point, with the exact predicates, in O(N): 1 inside, 0 outside or in a hole, and for the
+  // points on a ring the one of the points just to their right
+  int WindingNumber(Point2D const& point) const;
+  // builds the edge grid now, instead of at the first Contains (it is shared by the copies, built once)
+  void Prepare() const;
+#pragma endregion
+
+ private:
+  std::vector<Point2D> KNOTS;
+  std::vector<int> RINGS;  // ring i has the knots [RINGS[i], RINGS[i + 1]), the exterior first
+
+  // edge grid for the polygons with more than GRID_MIN_SIZE edges, built by the first query that needs it and shared
+  // by the copies (the knots never change)
+  struct LazyGrid;
+  std::shared_ptr<LazyGrid> GRID;
+  static constexpr int GRID_MIN_SIZE = 64;
+  EdgeGrid const* Grid() const;  // nullptr for the smaller polygons
+
+  Polygon2D(std::vector<Point2D>&& knots, std::vector<int>&& rings);
+};
+
+#pragma region Operator Overloading
+
+bool operator==(Polygon2D const& lhs, Polygon2D const& rhs);
+
+#pragma endregion
+
+}  // namespace geompp
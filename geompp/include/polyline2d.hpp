@@ -1,19 +1,28 @@
 #pragma once
 
+#include "bounding_box2d.hpp"
 #include "constants.hpp"
+#include "expected.hpp"
+#include "line_segment2d.hpp"
 #include "point2d.hpp"
 #include "vector2d.hpp"
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 namespace geompp {
 
+class Executor;
 class Line2D;
 class Ray2D;
-class LineSegment2D;
+class SegmentBVH;
 
 namespace {
 int default_prec() {
@@ -22,59 +31,134 @@ int default_prec() {
 }
 }  // namespace
 
-class Polyline2D {
+// how Simplify picks the knots to drop:
+//  - DOUGLAS_PEUCKER keeps the knot of a run farthest from its chord, while it is farther than the tolerance (a length)
+//  - VISVALINGAM_WHYATT drops the knot of the smallest triangle with its neighbours, while the area of it is not above
+//    the tolerance (an area)
+enum class Simplification { DOUGLAS_PEUCKER, VISVALINGAM_WHYATT };
+
+// The polyline of knots of type T: the float ones keep the knots (and the lengths) in half the memory, and run the
+// queries on their segments (see BasicLineSegment2D), the sweeps and the segment hierarchy in double.
+template <Scalar T>
+class BasicPolyline2D {
  public:
   // TODO: it would be nice to use variadic templates,
   //       BUT they don't support the optional parameter decimal_precision,
   //       AND must be definied in the header!
-  static Polyline2D Make(std::vector<Point2D> const& points, int decimal_precision = DP_THREE);
-  Polyline2D(Polyline2D const&) = default;
-  Polyline2D(Polyline2D&&) = default;
-  ~Polyline2D() = default;
+  static BasicPolyline2D Make(std::vector<BasicPoint2D<T>> const& points, int decimal_precision = DP_THREE);
+  // the knots cleaned in place in the vector taken, which becomes the one of the polyline (no copy)
+  static BasicPolyline2D Make(std::vector<BasicPoint2D<T>>&& points, int decimal_precision = DP_THREE);
+  // as Make, without throwing: the error instead of the polyline
+  static expected<BasicPolyline2D, GeomError> TryMake(std::vector<BasicPoint2D<T>> const& points,
+                                                      int decimal_precision = DP_THREE);
+  static expected<BasicPolyline2D, GeomError> TryMake(std::vector<BasicPoint2D<T>>&& points,
+                                                      int decimal_precision = DP_THREE);
+  // from the polyline of the other scalar type, checked again at the precision (rounding to float can bring knots
+  // together)
+  template <Scalar U>
+  static BasicPolyline2D Make(BasicPolyline2D<U> const& other, int decimal_precision = DP_THREE) {
+    return Make(std::vector<BasicPoint2D<T>>(other.Knots().begin(), other.Knots().end()), decimal_precision);
+  }
+  template <Scalar U>
+  static expected<BasicPolyline2D, GeomError> TryMake(BasicPolyline2D<U> const& other,
+                                                      int decimal_precision = DP_THREE) {
+    return TryMake(std::vector<BasicPoint2D<T>>(other.Knots().begin(), other.Knots().end()), decimal_precision);
+  }
+  // from the float polyline, exact
+  template <Scalar U>
+    requires(sizeof(U) < sizeof(T))
+  explicit BasicPolyline2D(BasicPolyline2D<U> const& other)
+      : BasicPolyline2D(std::vector<BasicPoint2D<T>>(other.Knots().begin(), other.Knots().end())) {}
+  BasicPolyline2D(BasicPolyline2D const&) = default;
+  BasicPolyline2D(BasicPolyline2D&&) = default;
+  ~BasicPolyline2D() = default;
 
   inline int Size() const { return KNOTS.size(); }
-  // TODO: it would be nice to have a "generator" with coroutines that "yields" point by point
-
-  bool AlmostEquals(Polyline2D const& other, int decimal_precision = DP_THREE) const;
-  std::vector<LineSegment2D> ToSegments() const;
-  double Length() const;
-  double DistanceTo(Point2D const& point, int decimal_precision = DP_THREE) const;
-  double Location(Point2D const& point, int decimal_precision = DP_THREE) const;
-  Point2D Interpolate(double pct) const;
+  inline std::vector<BasicPoint2D<T>> const& Knots() const { return KNOTS; }
+
+  // lazy view of the segments between consecutive knots: no allocation, no check of the (already unique) knots
+  inline auto Segments() const {
+    return std::views::iota(0, Size() - 1) |
+           std::views::transform([this](int i) { return BasicLineSegment2D<T>(KNOTS[i], KNOTS[i + 1]); });
+  }
+
+  bool AlmostEquals(BasicPolyline2D const& other, int decimal_precision = DP_THREE) const;
+  std::vector<BasicLineSegment2D<T>> ToSegments() const;
+  inline double Length() const { return LENGTHS.back(); }
+  double DistanceTo(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  double Location(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  BasicPoint2D<T> Interpolate(double pct) const;
+  BoundingBox2D BoundingBox() const;
 
   std::string ToWkt(int decimal_precision = DP_THREE) const;
-  static Polyline2D FromWkt(std::string const& wkt);
+  static BasicPolyline2D FromWkt(std::string const& wkt);
+  // as FromWkt, without throwing or logging
+  static expected<BasicPolyline2D, GeomError> TryFromWkt(std::string_view wkt);
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
-  static Polyline2D FromFile(std::string const& path);
+  static BasicPolyline2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static BasicPolyline2D FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static BasicPolyline2D FromWkbFile(std::string const& path, int decimal_precision = DP_THREE);
 
-  Polyline2D& operator=(Polyline2D const& other);
+  BasicPolyline2D& operator=(BasicPolyline2D const&) = default;
 
 #pragma region Geometrical Operations
-  bool Contains(Point2D const& point, int decimal_precision = DP_THREE) const;
-  using MultiPoint = std::vector<Point2D>;
-  using ReturnSet = std::optional<std::variant<Point2D, MultiPoint>>;
+  bool Contains(BasicPoint2D<T> const& point, int decimal_precision = DP_THREE) const;
+  using MultiPoint = std::vector<BasicPoint2D<T>>;
+  using ReturnSet = std::optional<std::variant<BasicPoint2D<T>, MultiPoint>>;
   bool Intersects(Line2D const& line, int decimal_precision = DP_THREE) const;
   bool Intersects(Ray2D const& ray, int decimal_precision = DP_THREE) const;
-  bool Intersects(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
-  bool Intersects(Polyline2D const& other, int decimal_precision = DP_THREE) const;
+  bool Intersects(BasicLineSegment2D<T> const& segment, int decimal_precision = DP_THREE) const;
+  bool Intersects(BasicPolyline2D const& other, int decimal_precision = DP_THREE) const;
   ReturnSet Intersection(Line2D const& line, int decimal_precision = DP_THREE) const;
   ReturnSet Intersection(Ray2D const& ray, int decimal_precision = DP_THREE) const;
-  ReturnSet Intersection(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
-  ReturnSet Intersection(
-      Polyline2D const& other,
-      int decimal_precision = DP_THREE) const;  // TODO: this is the brute force O(N2), replace with the proper
-                                                // algorithm for intersection of a set of segments O(N*LogN)
+  ReturnSet Intersection(BasicLineSegment2D<T> const& segment, int decimal_precision = DP_THREE) const;
+  ReturnSet Intersection(BasicPolyline2D const& other,
+                         int decimal_precision = DP_THREE) const;  // sweep line, O((N+M+K)*Log(N+M))
+  bool Intersects(BasicPolyline2D const& other, ExactPredicates) const;
+  ReturnSet Intersection(BasicPolyline2D const& other, ExactPredicates) const;
+  // the same, with the segments of this polyline split in ranges swept in parallel on the executor, each against the
+  // segments of the other polyline near it
+  ReturnSet Intersection(BasicPolyline2D const& other, Executor& executor, int decimal_precision = DP_THREE) const;
+  ReturnSet Intersection(BasicPolyline2D const& other, Executor& executor, ExactPredicates) const;
+#pragma endregion
+
+#pragma region Simplification
+  // the knots of significance above the tolerance (always the two ends), checked again at the precision as by Make:
+  // throws when less than 2 are left (the ends of a closed polyline)
+  BasicPolyline2D Simplify(double tolerance, Simplification method = Simplification::DOUGLAS_PEUCKER,
+                           int decimal_precision = DP_THREE) const;
+  // of each knot, the tolerance up to which Simplify keeps it (infinity for the ends), never above the one of the knot
+  // that made it count: Simplify(tolerance) keeps the knots of significance > tolerance (see PolylinePyramid)
+  std::vector<double> Significance(Simplification method = Simplification::DOUGLAS_PEUCKER) const;
 #pragma endregion
 
  private:
-  std::vector<Point2D> KNOTS;
+  std::vector<BasicPoint2D<T>> KNOTS;
+  std::vector<double> LENGTHS;  // cumulative length of the polyline at each knot, in double for any T, LENGTHS[0] = 0
 
-  Polyline2D(std::vector<Point2D>&& points);
+  // segment hierarchy for the polylines with more than BVH_MIN_SIZE segments, built by the first query that needs it
+  // and shared by the copies (the knots never change)
+  struct LazyBVH;
+  std::shared_ptr<LazyBVH> BVH;
+  static constexpr int BVH_MIN_SIZE = 64;
+  SegmentBVH const* Bvh() const;  // nullptr for the smaller polylines
+
+  // the segments in double, for the sweeps
+  std::vector<LineSegment2D> WideSegments() const;
+
+  BasicPolyline2D(std::vector<BasicPoint2D<T>>&& points);
 };
 
+// defined in polyline2d.cpp for these two only
+extern template class BasicPolyline2D<double>;
+extern template class BasicPolyline2D<float>;
+
 #pragma region Operator Overloading
 
-bool operator==(Polyline2D const& lhs, Polyline2D const& rhs);
+template <Scalar T>
+inline bool operator==(BasicPolyline2D<T> const& lhs, BasicPolyline2D<T> const& rhs) { return lhs.AlmostEquals(rhs); }
 
 #pragma endregion
 
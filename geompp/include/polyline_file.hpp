@@ -0,0 +1,107 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "constants.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace geompp {
+
+// Columnar file of polylines (as in GeoArrow), made to be memory mapped and read in place:
+//  - header: magic "GEOMPPPL", version, coordinate layout, number of polylines and of vertices, section positions
+//  - coordinates: all the x then all the y (SEPARATE), or x, y of each vertex (INTERLEAVED)
+//  - offsets: N + 1 vertex indices, polyline i has the vertices [offsets[i], offsets[i + 1])
+//  - boxes: min x, min y, max x, max y of each polyline
+// All little endian, each section 8 byte aligned.
+enum class CoordinateLayout : std::uint32_t { SEPARATE = 0, INTERLEAVED = 1 };
+
+// read only view of one polyline of a PolylineFile, valid as long as the file is open
+class PolylineView {
+ public:
+  inline int Size() const { return SIZE; }
+  inline Point2D At(int i) const { return {XS[i * STRIDE], YS[i * STRIDE]}; }
+  inline BoundingBox2D const& BoundingBox() const { return BOX; }
+
+  std::vector<Point2D> ToPoints() const;
+  // cleaned by Polyline2D::Make at the precision, as any other knots: the file may not come from a Polyline2D
+  Polyline2D ToPolyline(int decimal_precision = DP_THREE) const;
+
+ private:
+  double const* XS;
+  double const* YS;
+  int STRIDE;  // 1 for SEPARATE, 2 for INTERLEAVED
+  int SIZE;
+  BoundingBox2D BOX;
+
+  PolylineView(double const* xs, double const* ys, int stride, int size, BoundingBox2D const& box);
+  friend class PolylineFile;
+};
+
+// a memory mapped PolylineFile: opening it reads (and checks) only the header, the pages of the polylines are loaded
+// by the system when they are first read
+class PolylineFile {
+ public:
+  static PolylineFile Open(std::string const& path);
+  PolylineFile(PolylineFile const&) = delete;
+  PolylineFile(PolylineFile&& other) noexcept;
+  ~PolylineFile();
+
+  static constexpr std::uint32_t VERSION = 1;
+
+  inline int Size() const { return SIZE; }
+  inline std::int64_t Vertices() const { return VERTICES; }
+  inline CoordinateLayout Layout() const { return LAYOUT; }
+  BoundingBox2D BoundingBox(int i) const;
+  PolylineView At(int i) const;
+
+  // the polylines whose bounding box intersects the window, by increasing index
+  std::vector<int> Window(BoundingBox2D const& window) const;
+
+  static void Write(std::string const& path, std::vector<Polyline2D> const& polylines,
+                    CoordinateLayout layout = CoordinateLayout::SEPARATE);
+
+ private:
+  void const* DATA = nullptr;  // the mapping
+  std::size_t BYTES = 0;
+  int SIZE = 0;
+  std::int64_t VERTICES = 0;
+  CoordinateLayout LAYOUT = CoordinateLayout::SEPARATE;
+  double const* XS = nullptr;
+  double const* YS = nullptr;
+  std::uint64_t const* OFFSETS = nullptr;
+  double const* BOXES = nullptr;
+
+  PolylineFile() = default;
+};
+
+// writes a PolylineFile one polyline at a time, without keeping the coordinates in memory: they go straight to the
+// file (the y of the SEPARATE layout to a temporary file until Close), only the offsets and boxes are kept until the
+// end, then written with the header by Close
+class PolylineFileWriter {
+ public:
+  static PolylineFileWriter Open(std::string const& path, CoordinateLayout layout = CoordinateLayout::SEPARATE);
+  PolylineFileWriter(PolylineFileWriter const&) = delete;
+  PolylineFileWriter(PolylineFileWriter&& other) noexcept;
+  ~PolylineFileWriter();  // closes the file, if not done yet
+
+  void Write(Polyline2D const& polyline);
+  void Close();
+
+ private:
+  std::ofstream OUT;
+  std::FILE* YS = nullptr;  // temporary, for SEPARATE
+  CoordinateLayout LAYOUT;
+  std::vector<std::uint64_t> OFFSETS{0};
+  std::vector<double> BOXES;
+  bool CLOSED = false;
+
+  PolylineFileWriter(std::string const& path, CoordinateLayout layout);
+};
+
+}  // namespace geompp
\ No newline at end of file
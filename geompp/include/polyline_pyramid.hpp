@@ -0,0 +1,38 @@
+#pragma once
+
+#include "constants.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+
+#include <vector>
+
+namespace geompp {
+
+// Levels of detail of a polyline: the significance of its knots (see Polyline2D::Significance) computed once, and the
+// knots ranked by it, so that the polyline at any tolerance is a prefix of the ranking. At(tolerance) reads only the K
+// knots it keeps, in O(log N + K log K), without any distance or area computed again.
+class PolylinePyramid {
+ public:
+  static PolylinePyramid Make(Polyline2D const& polyline, Simplification method = Simplification::DOUGLAS_PEUCKER);
+
+  inline int Size() const { return KNOTS.size(); }
+  inline Simplification Method() const { return METHOD; }
+
+  // the number of knots kept at the tolerance (before the check at the precision of At)
+  int Count(double tolerance) const;
+  // the smallest tolerance that keeps at most that many knots (2 at least, the ends): the levels of a pyramid of
+  // Size(), Size() / 2, Size() / 4, ... knots are Tolerance(Size() >> level)
+  double Tolerance(int knots) const;
+  // the same as polyline.Simplify(tolerance, Method(), decimal_precision)
+  Polyline2D At(double tolerance, int decimal_precision = DP_THREE) const;
+
+ private:
+  Simplification METHOD;
+  std::vector<Point2D> KNOTS;       // of the polyline, in its order
+  std::vector<int> RANKING;         // the indices of the knots, by decreasing significance
+  std::vector<double> SIGNIFICANCE;  // of the knots of the ranking, decreasing
+
+  PolylinePyramid() = default;
+};
+
+}  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "constants.hpp"
+#include "point2d.hpp"
+
+namespace geompp {
+
+#pragma region Robust Predicates
+
+// Filtered exact predicates (after J. R. Shewchuk): the floating point result is returned when its sign is certain,
+// otherwise the determinant is recomputed with exact expansion arithmetic. The sign is always right, no matter how
+// close to degenerate the input is, with no decimal precision involved.
+
+// > 0 if a, b, c are in counterclockwise order, < 0 if clockwise, 0 if collinear
+double orient2d(Point2D const& a, Point2D const& b, Point2D const& c);
+
+// > 0 if d is inside the circle through a, b, c (in counterclockwise order), < 0 if outside, 0 if cocircular
+double incircle(Point2D const& a, Point2D const& b, Point2D const& c, Point2D const& d);
+
+// sign of orient2d: 1, -1, 0
+int orientation(Point2D const& a, Point2D const& b, Point2D const& c);
+
+// the closed segments [p0, p1] and [q0, q1] share at least one point
+bool segments_intersect(Point2D const& p0, Point2D const& p1, Point2D const& q0, Point2D const& q1);
+
+#pragma endregion
+
+}  // namespace geompp
\ No newline at end of file
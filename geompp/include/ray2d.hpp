@@ -1,22 +1,28 @@
 #pragma once
 
 #include "constants.hpp"
+#include "expected.hpp"
 #include "point2d.hpp"
 #include "vector2d.hpp"
 
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace geompp {
 
 class Line2D;
-class LineSegment2D;
 class Shape2D;
 
 class Ray2D {
  public:
   static Ray2D Make(Point2D const& orig, Vector2D const& dir, int decimal_precision = DP_THREE);
+  // as Make, without throwing: the error instead of the ray
+  static expected<Ray2D, GeomError> TryMake(Point2D const& orig, Vector2D const& dir, int decimal_precision = DP_THREE);
   Ray2D(Ray2D const&) = default;
   Ray2D(Ray2D&&) = default;
   ~Ray2D() = default;
@@ -31,10 +37,15 @@ class Ray2D {
 
   std::string ToWkt(int decimal_precision = DP_THREE) const;
   static Ray2D FromWkt(std::string const& wkt);
+  static expected<Ray2D, GeomError> TryFromWkt(std::string_view wkt);  // as FromWkt, without throwing or logging
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
   static Ray2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static Ray2D FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static Ray2D FromWkbFile(std::string const& path, int decimal_precision = DP_THREE);
 
-  Ray2D& operator=(Ray2D const& other);
+  Ray2D& operator=(Ray2D const&) = default;
 
 #pragma region Geometrical Operations
   bool Contains(Point2D const& point, int decimal_precision = DP_THREE) const;
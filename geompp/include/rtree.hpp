@@ -0,0 +1,86 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "constants.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+
+#include <vector>
+
+namespace geompp {
+
+class Line2D;
+class Ray2D;
+
+// Static R-tree, bulk loaded with Sort-Tile-Recursive (STR): the boxes are sorted by x into vertical slices, then by
+// y within each slice, and packed into nodes of NODE_SIZE children, level by level up to the root. The nodes are in
+// one flat array (root first, then each level), the children of a node next to each other.
+// The queries prune the boxes and then refine the candidates with the methods of the geometries (at the precision),
+// returning their indices in the input collection.
+// Instantiated for LineSegment2D (SegmentRTree) and Polyline2D (PolylineRTree).
+template <typename Geometry>
+class RTree {
+ public:
+  static RTree Make(std::vector<Geometry> const& items);
+  static RTree Make(std::vector<Geometry>&& items);
+  RTree(RTree const&) = default;
+  RTree(RTree&&) = default;
+  ~RTree() = default;
+
+  static constexpr int NODE_SIZE = 16;
+
+  inline int Size() const { return ITEMS.size(); }
+  inline Geometry const& At(int i) const { return ITEMS[i]; }
+  inline std::vector<Geometry> const& Items() const { return ITEMS; }
+  // BoundingBox2D::Empty() if there are no items
+  BoundingBox2D BoundingBox() const;
+
+#pragma region Queries
+
+  // the items whose bounding box intersects the window, by increasing index
+  std::vector<int> Window(BoundingBox2D const& window) const;
+
+  // the items that intersect the geometry, by increasing index
+  std::vector<int> Intersecting(Line2D const& line, int decimal_precision = DP_THREE) const;
+  std::vector<int> Intersecting(Ray2D const& ray, int decimal_precision = DP_THREE) const;
+  std::vector<int> Intersecting(LineSegment2D const& segment, int decimal_precision = DP_THREE) const;
+
+  // the k items nearest to the point (or all of them, if less than k), by increasing distance, then index
+  struct Neighbour {
+    int index;
+    double distance;  // At(index).DistanceTo(point, decimal_precision)
+  };
+  std::vector<Neighbour> Nearest(Point2D const& point, int k, int decimal_precision = DP_THREE) const;
+
+#pragma endregion
+
+ private:
+  struct Node {
+    BoundingBox2D box;
+    double reach;     // the largest segment_reach of its items (see bounding_box2d.hpp)
+    int first;        // first child: in NODES, or in the entries for the leaves
+    int count;        // number of children
+    bool leaf;
+  };
+
+  std::vector<Geometry> ITEMS;
+  std::vector<int> ENTRIES;  // item indices, in the order of the leaves
+  std::vector<BoundingBox2D> ENTRY_BOXES;
+  std::vector<double> ENTRY_REACHES;
+  std::vector<Node> NODES;   // NODES[0] is the root
+
+  explicit RTree(std::vector<Geometry>&& items);
+
+  // indices of the items in the leaves reached through the nodes where overlaps(box, reach) is true
+  template <typename Overlaps>
+  std::vector<int> Candidates(Overlaps&& overlaps) const;
+};
+
+extern template class RTree<LineSegment2D>;
+extern template class RTree<Polyline2D>;
+
+using SegmentRTree = RTree<LineSegment2D>;
+using PolylineRTree = RTree<Polyline2D>;
+
+}  // namespace geompp
\ No newline at end of file
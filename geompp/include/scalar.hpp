@@ -0,0 +1,38 @@
+#pragma once
+
+#include <concepts>
+#include <limits>
+
+namespace geompp {
+
+// The coordinate type of the point, vector, segment and polyline templates: double (Point2D, ...), or float
+// (Point2Df, ...) for the large datasets where half the memory matters more than the digits. The geometries of one
+// type convert to the other explicitly; float to double is exact.
+template <typename T>
+concept Scalar = std::same_as<T, double> || std::same_as<T, float>;
+
+// the highest decimal precision the coordinates of the type can hold (6 for float, 15 for double): a Make at a higher
+// one would compare digits that were never stored
+template <Scalar T>
+inline constexpr int MAX_DECIMAL_PRECISION = std::numeric_limits<T>::digits10;
+
+template <Scalar T>
+class BasicVector2D;
+template <Scalar T>
+class BasicPoint2D;
+template <Scalar T>
+class BasicLineSegment2D;
+template <Scalar T>
+class BasicPolyline2D;
+
+using Vector2D = BasicVector2D<double>;
+using Point2D = BasicPoint2D<double>;
+using LineSegment2D = BasicLineSegment2D<double>;
+using Polyline2D = BasicPolyline2D<double>;
+
+using Vector2Df = BasicVector2D<float>;
+using Point2Df = BasicPoint2D<float>;
+using LineSegment2Df = BasicLineSegment2D<float>;
+using Polyline2Df = BasicPolyline2D<float>;
+
+}  // namespace geompp
\ No newline at end of file
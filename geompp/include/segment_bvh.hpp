@@ -0,0 +1,95 @@
+#pragma once
+
+#include "bounding_box2d.hpp"
+#include "point2d.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace geompp {
+
+// Bounding volume hierarchy over the segments between consecutive knots (segment i = [knots[i], knots[i + 1]]).
+// Each node covers a range of consecutive segments, split in half down to leaves of at most LEAF_SIZE segments:
+// consecutive segments of a polyline are close to each other, so the ranges give tight boxes without any sorting.
+class SegmentBVH {
+ public:
+  static SegmentBVH Make(std::vector<Point2D> const& knots);
+
+  struct Node {
+    BoundingBox2D box;
+    double reach;      // max(length, 1 / length) of its segments, see Polyline2D for how it widens the box
+    int first, last;   // segments [first, last)
+    int left, right;   // children, -1 for the leaves
+  };
+
+  static constexpr int LEAF_SIZE = 8;
+
+  inline int Size() const { return NODES.empty() ? 0 : NODES[0].last; }
+  inline std::vector<Node> const& Nodes() const { return NODES; }
+
+  // calls fn(i) on the segments of the leaves reached through the nodes where overlaps(node) is true, by increasing
+  // i, until fn returns true; returns whether it did
+  template <typename Overlaps, typename Fn>
+  bool Any(Overlaps&& overlaps, Fn&& fn) const {
+    std::vector<int> stack{0};
+    while (!stack.empty()) {
+      auto const& node = NODES[stack.back()];
+      stack.pop_back();
+      if (!overlaps(node)) {
+        continue;
+      }
+      if (node.left < 0) {
+        for (int i = node.first; i < node.last; ++i) {
+          if (fn(i)) {
+            return true;
+          }
+        }
+      } else {
+        stack.push_back(node.right);
+        stack.push_back(node.left);
+      }
+    }
+    return false;
+  }
+
+  // branch and bound: the smallest distance(i) over all segments, skipping the nodes whose lower_bound(node) is
+  // already greater than the best so far, and visiting first the child with the smallest bound
+  template <typename Bound, typename Distance>
+  double Minimum(Bound&& lower_bound, Distance&& distance) const {
+    double best = std::numeric_limits<double>::infinity();
+    std::vector<std::pair<int, double>> stack{{0, lower_bound(NODES[0])}};
+    while (!stack.empty()) {
+      auto [n, bound] = stack.back();
+      stack.pop_back();
+      if (bound > best) {
+        continue;
+      }
+      auto const& node = NODES[n];
+      if (node.left < 0) {
+        for (int i = node.first; i < node.last; ++i) {
+          best = std::min(best, distance(i));
+        }
+        continue;
+      }
+      double bound_left = lower_bound(NODES[node.left]);
+      double bound_right = lower_bound(NODES[node.right]);
+      if (bound_left <= bound_right) {
+        stack.emplace_back(node.right, bound_right);
+        stack.emplace_back(node.left, bound_left);
+      } else {
+        stack.emplace_back(node.left, bound_left);
+        stack.emplace_back(node.right, bound_right);
+      }
+    }
+    return best;
+  }
+
+ private:
+  std::vector<Node> NODES;  // NODES[0] is the root
+
+  int Build(std::vector<Point2D> const& knots, int first, int last);
+};
+
+}  // namespace geompp
\ No newline at end of file
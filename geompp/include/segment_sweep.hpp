@@ -0,0 +1,47 @@
+#pragma once
+
+#include "constants.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+
+#include <vector>
+
+namespace geompp {
+
+// Bentley-Ottmann sweep line over a set of segments: finds all the K intersecting pairs of N segments
+// in O((N+K)*LogN), instead of testing all the N2 pairs one by one
+class SegmentSweep {
+ public:
+  struct Crossing {
+    int first;   // index of the first segment (in the "red" set, when sweeping two sets)
+    int second;  // index of the second segment (in the "blue" set, when sweeping two sets)
+    Point2D point;
+  };
+
+  // all the pairs of segments of the set
+  static SegmentSweep Make(std::vector<LineSegment2D> const& segments);
+  // only the pairs made of one "red" and one "blue" segment (i.e. the segments of two polylines)
+  static SegmentSweep Make(std::vector<LineSegment2D> const& red, std::vector<LineSegment2D> const& blue);
+  SegmentSweep(SegmentSweep const&) = default;
+  SegmentSweep(SegmentSweep&&) = default;
+  ~SegmentSweep() = default;
+
+  inline int Size() const { return SEGMENTS.size(); }
+
+  bool Intersects(int decimal_precision = DP_THREE) const;
+  bool Intersects(ExactPredicates) const;
+  // sorted by first, then second segment index (the same order of a double loop over the segments)
+  std::vector<Crossing> Intersection(int decimal_precision = DP_THREE) const;
+  std::vector<Crossing> Intersection(ExactPredicates) const;
+
+ private:
+  std::vector<LineSegment2D> SEGMENTS;
+  std::vector<int> GROUPS;  // 0 = red, 1 = blue, empty if all the pairs are wanted
+  int NUM_RED;
+
+  SegmentSweep(std::vector<LineSegment2D>&& segments, std::vector<int>&& groups, int num_red);
+
+  std::vector<Crossing> Run(int decimal_precision, bool exact, bool stop_at_first) const;
+};
+
+}  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+// Instruction set of the batch kernels (PointBuffer2D, LineSegmentBuffer2D), chosen at compile time:
+//  - GEOMPP_SIMD_AVX2, 4 doubles per lane, when built with GEOMPP_AVX2
+//  - GEOMPP_SIMD_SSE2, 2 doubles per lane, on any x86-64
+//  - neither: the scalar loops only (GEOMPP_NO_SIMD forces them)
+// Only the library sources include it: the macros follow the flags of the including translation unit.
+
+#if defined(GEOMPP_NO_SIMD)
+#elif defined(__AVX2__)
+#define GEOMPP_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOMPP_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace geompp {
+
+// "avx2", "sse2" or "scalar"
+constexpr char const* simd_instruction_set() {
+#if defined(GEOMPP_SIMD_AVX2)
+  return "avx2";
+#elif defined(GEOMPP_SIMD_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace geompp
\ No newline at end of file
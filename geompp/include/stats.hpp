@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hot path instrumentation, built with GEOMPP_PROFILE (the cmake option of the same name), else compiled out:
+//  - GEOMPP_PROFILE_SCOPE("name") counts the calls of the enclosing block, and the cycles spent in it
+//  - GEOMPP_PROFILE_COUNT("name") counts an event (an early out, a failure, ...)
+// Each thread adds to counters of its own, without locks or shared cache lines; stats::Snapshot() sums them on demand.
+// The probes of the same name (in different places) add to the same entry.
+
+namespace geompp::stats {
+
+#ifdef GEOMPP_PROFILE
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+struct Entry {
+  std::string name;
+  std::uint64_t calls = 0;   // or events, for GEOMPP_PROFILE_COUNT
+  std::uint64_t cycles = 0;  // 0 for GEOMPP_PROFILE_COUNT
+};
+
+// the counters of all the threads (those alive, and those already finished), by name; empty without GEOMPP_PROFILE
+std::vector<Entry> Snapshot();
+
+// sets all the counters back to zero (the counts of probes running meanwhile on other threads may be lost)
+void Reset();
+
+// a table of the snapshot, one line per entry: name, calls, cycles, cycles per call
+std::string Dump(std::vector<Entry> const& entries);
+
+// time stamp counter where there is one (x86), else the steady clock in nanoseconds
+std::uint64_t cycles();
+
+// one place in the code, registered (given an index into the counters of each thread) on first use
+class Probe {
+ public:
+  explicit Probe(char const* name);
+  Probe(Probe const&) = delete;
+  Probe& operator=(Probe const&) = delete;
+
+  void Add(std::uint64_t cycles = 0) const;
+
+ private:
+  int INDEX;  // -1 when there were too many probes
+};
+
+// counts a call of the probe, and the cycles until the end of the scope
+class ScopeTimer {
+ public:
+  explicit ScopeTimer(Probe const& probe) : PROBE(probe), START(cycles()) {}
+  ScopeTimer(ScopeTimer const&) = delete;
+  ScopeTimer& operator=(ScopeTimer const&) = delete;
+  ~ScopeTimer() { PROBE.Add(cycles() - START); }
+
+ private:
+  Probe const& PROBE;
+  std::uint64_t START;
+};
+
+}  // namespace geompp::stats
+
+#define GEOMPP_PROFILE_CONCAT_(a, b) a##b
+#define GEOMPP_PROFILE_CONCAT(a, b) GEOMPP_PROFILE_CONCAT_(a, b)
+
+#ifdef GEOMPP_PROFILE
+#define GEOMPP_PROFILE_SCOPE(name)                                                              \
+  static ::geompp::stats::Probe const GEOMPP_PROFILE_CONCAT(geompp_probe_, __LINE__)(name);     \
+  ::geompp::stats::ScopeTimer const GEOMPP_PROFILE_CONCAT(geompp_timer_, __LINE__)(             \
+      GEOMPP_PROFILE_CONCAT(geompp_probe_, __LINE__))
+#define GEOMPP_PROFILE_COUNT(name)                          \
+  do {                                                      \
+    static ::geompp::stats::Probe const geompp_probe(name); \
+    geompp_probe.Add();                                     \
+  } while (0)
+#else
+#define GEOMPP_PROFILE_SCOPE(name)
+#define GEOMPP_PROFILE_COUNT(name) \
+  do {                             \
+  } while (0)
+#endif
\ No newline at end of file
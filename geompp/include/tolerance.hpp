@@ -0,0 +1,83 @@
+#pragma once
+
+#include "constants.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace geompp {
+
+#pragma region Tolerance
+
+// any decimal precision, only known at runtime
+const int DP_ANY = std::numeric_limits<int>::min();
+
+// 10^decimal_precision, exact and without calling pow() for the usual precisions
+constexpr double power_of_ten(int decimal_precision) {
+  constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  if (decimal_precision >= 0 && decimal_precision <= 22) {
+    return powers[decimal_precision];
+  }
+  return pow(10, decimal_precision);
+}
+
+// Comparisons of a value with zero (or an integer bound) at a decimal precision, with the same results of
+// round_to(x, decimal_precision) compared with it, but without rounding: round(x * 10^d) == 0 <=> |x * 10^d| < 0.5
+//  - Tolerance<DP_THREE>, Tolerance<DP_SIX>, ... have their scale fixed at compile time
+//  - Tolerance<> takes the precision at runtime
+template <int DecimalPrecision = DP_ANY>
+class Tolerance {
+ public:
+  constexpr Tolerance()
+    requires(DecimalPrecision != DP_ANY)
+      : SCALE(FIXED_SCALE) {}
+  constexpr explicit Tolerance(int decimal_precision)
+    requires(DecimalPrecision == DP_ANY)
+      : SCALE(power_of_ten(decimal_precision)) {}
+
+  constexpr double Scale() const {
+    if constexpr (DecimalPrecision == DP_ANY) {
+      return SCALE;
+    } else {
+      return FIXED_SCALE;
+    }
+  }
+
+  constexpr bool IsZero(double x) const { return Abs(x * Scale()) < 0.5; }         // round_to(x) == 0
+  constexpr bool IsPositive(double x) const { return x * Scale() >= 0.5; }         // round_to(x) > 0
+  constexpr bool IsNegative(double x) const { return x * Scale() <= -0.5; }        // round_to(x) < 0
+  constexpr bool IsNonNegative(double x) const { return x * Scale() > -0.5; }      // round_to(x) >= 0
+  constexpr bool IsNonPositive(double x) const { return x * Scale() < 0.5; }       // round_to(x) <= 0
+  constexpr bool IsAbove(double x, int bound) const {  // round_to(x) > bound
+    double scaled_bound = bound * Scale();               // not an integer only for negative precisions
+    return x * Scale() >= (Scale() >= 1 ? scaled_bound : floor(scaled_bound)) + 0.5;
+  }
+  constexpr bool AlmostEquals(double a, double b) const { return IsZero(a - b); }  // round_to(a - b) == 0
+  constexpr int Sign(double x) const { return IsNonNegative(x) ? 1 : -1; }         // sign(x)
+
+ private:
+  static constexpr double FIXED_SCALE = power_of_ten(DecimalPrecision == DP_ANY ? 0 : DecimalPrecision);
+  double SCALE;
+
+  static constexpr double Abs(double x) { return x < 0 ? -x : x; }
+};
+
+// calls fn with the compile-time Tolerance of the common precisions, or with the runtime one for the others
+template <typename Fn>
+decltype(auto) with_tolerance(int decimal_precision, Fn&& fn) {
+  switch (decimal_precision) {
+    case DP_THREE:
+      return fn(Tolerance<DP_THREE>());
+    case DP_SIX:
+      return fn(Tolerance<DP_SIX>());
+    case DP_NINE:
+      return fn(Tolerance<DP_NINE>());
+    default:
+      return fn(Tolerance<>(decimal_precision));
+  }
+}
+
+#pragma endregion
+
+}  // namespace geompp
\ No newline at end of file
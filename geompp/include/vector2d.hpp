@@ -1,64 +1,108 @@
 #pragma once
 
+#include "expected.hpp"
+#include "scalar.hpp"
 #include "utils.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace geompp {
 
-class Point2D;
-
-class Vector2D {
+// two coordinates, trivially copyable (see the static_asserts below), with the arithmetic inline
+template <Scalar T>
+class BasicVector2D {
  public:
-  Vector2D(double x = 0.0, double y = 0.0);
-  Vector2D(Vector2D const&) = default;
-  Vector2D(Vector2D&&) = default;
-  ~Vector2D() = default;
+  constexpr BasicVector2D(T x = 0.0, T y = 0.0) : X(x), Y(y) {}
+  // from the vector of the other scalar type (float to double is exact, double to float rounds)
+  template <Scalar U>
+  explicit constexpr BasicVector2D(BasicVector2D<U> const& other)
+      : X(static_cast<T>(other.x())), Y(static_cast<T>(other.y())) {}
 
-  double inline const x() const { return X; }
-  double inline const y() const { return Y; }
+  inline constexpr T x() const { return X; }
+  inline constexpr T y() const { return Y; }
 
-  Point2D ToPoint();
+  constexpr BasicPoint2D<T> ToPoint() const;  // in point2d.hpp
 
-  double Length() const;
-  bool AlmostEquals(Vector2D const& other, int decimal_precision = DP_THREE) const;
+  inline T Length() const { return std::sqrt(X * X + Y * Y); }
+  bool AlmostEquals(BasicVector2D const& other, int decimal_precision = DP_THREE) const;
   std::string ToWkt(int decimal_precision = DP_THREE) const;
-  static Vector2D FromWkt(std::string const& wkt);
+  static BasicVector2D FromWkt(std::string const& wkt);
+  // as FromWkt, without throwing or logging
+  static expected<BasicVector2D, GeomError> TryFromWkt(std::string_view wkt);
   void ToFile(std::string const& path, int decimal_precision = DP_THREE) const;
-  static Vector2D FromFile(std::string const& path);
-
-  Vector2D& operator=(Vector2D const& other);
+  static BasicVector2D FromFile(std::string const& path);
+  std::vector<std::uint8_t> ToWkb(Endian endian = Endian::LITTLE) const;
+  static BasicVector2D FromWkb(std::span<std::uint8_t const> wkb);
+  void ToWkbFile(std::string const& path, Endian endian = Endian::LITTLE) const;
+  static BasicVector2D FromWkbFile(std::string const& path);
 
-  double Dot(Vector2D const& v) const;
-  double Cross(Vector2D const& v) const;
-  Vector2D Perp() const;
-  Vector2D Normalize() const;
+  inline constexpr T Dot(BasicVector2D const& v) const { return X * v.X + Y * v.Y; }
+  inline constexpr T Cross(BasicVector2D const& v) const { return -Y * v.X + X * v.Y; }
+  inline constexpr BasicVector2D Perp() const { return {-Y, X}; }
+  inline BasicVector2D Normalize() const {
+    T len = Length();
+    return {X / len, Y / len};
+  }
 
-  Vector2D operator-();
+  inline constexpr BasicVector2D operator-() const { return {-X, -Y}; }
 
-  static inline Vector2D BasisX() { return Vector2D(1, 0); }
-  static inline Vector2D BasisY() { return Vector2D(0, 1); }
+  static inline constexpr BasicVector2D BasisX() { return BasicVector2D(1, 0); }
+  static inline constexpr BasicVector2D BasisY() { return BasicVector2D(0, 1); }
 
  private:
-  double X, Y;
+  T X, Y;
 };
 
-#pragma region Operator Overloading
-
-bool operator==(Vector2D const& lhs, Vector2D const& rhs);
+// defined in vector2d.cpp for these two only
+extern template class BasicVector2D<double>;
+extern template class BasicVector2D<float>;
 
-Point2D operator+(Vector2D const& lhs, Point2D const& point);
-Vector2D operator+(Vector2D const& lhs, Vector2D const& vec);
-
-Vector2D operator-(Vector2D const& lhs, Vector2D const& vec);
-
-Vector2D operator*(Vector2D const& lhs, double a);
-Vector2D operator*(double a, Vector2D const& rhs);
-double operator*(Vector2D const& lhs, Vector2D const& vec);
+#pragma region Operator Overloading
 
-Vector2D operator/(Vector2D const& lhs, Vector2D const& vec) = delete;
-Vector2D operator/(Vector2D const& lhs, double a);
+// the scalar operands take the type of the vector (std::type_identity_t: not deduced from them)
+
+template <Scalar T>
+inline bool operator==(BasicVector2D<T> const& lhs, BasicVector2D<T> const& rhs) { return lhs.AlmostEquals(rhs); }
+
+template <Scalar T>
+constexpr BasicPoint2D<T> operator+(BasicVector2D<T> const& lhs, BasicPoint2D<T> const& point);  // in point2d.hpp
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator+(BasicVector2D<T> const& lhs, BasicVector2D<T> const& vec) {
+  return {lhs.x() + vec.x(), lhs.y() + vec.y()};
+}
+
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator-(BasicVector2D<T> const& lhs, BasicVector2D<T> const& vec) {
+  return {lhs.x() - vec.x(), lhs.y() - vec.y()};
+}
+
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator*(BasicVector2D<T> const& lhs, std::type_identity_t<T> a) {
+  return {lhs.x() * a, lhs.y() * a};
+}
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator*(std::type_identity_t<T> a, BasicVector2D<T> const& rhs) { return rhs * a; }
+template <Scalar T>
+inline constexpr T operator*(BasicVector2D<T> const& lhs, BasicVector2D<T> const& vec) { return lhs.Dot(vec); }
+
+template <Scalar T>
+BasicVector2D<T> operator/(BasicVector2D<T> const& lhs, BasicVector2D<T> const& vec) = delete;
+template <Scalar T>
+inline constexpr BasicVector2D<T> operator/(BasicVector2D<T> const& lhs, std::type_identity_t<T> a) {
+  return {lhs.x() / a, lhs.y() / a};
+}
 
 #pragma endregion
 
+// copied, stored and written (WKB, files, buffers) as two plain coordinates
+static_assert(std::is_trivially_copyable_v<Vector2D> && std::is_standard_layout_v<Vector2D>);
+static_assert(sizeof(Vector2D) == 2 * sizeof(double) && alignof(Vector2D) == alignof(double));
+static_assert(std::is_trivially_copyable_v<Vector2Df> && sizeof(Vector2Df) == 2 * sizeof(float));
+
 }  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "constants.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace geompp {
+
+// ISO WKB (Well-Known Binary), 2D only: POINT, LINESTRING, POLYGON, MULTIPOINT and MULTILINESTRING, in either byte
+// order.
+// There is no WKB type for the infinite geometries: a Line2D is the LINESTRING of its two points, a Ray2D the
+// LINESTRING from its origin to origin + direction, and a Vector2D is a POINT.
+
+// appends the geometries to a byte array, each one with its own byte order flag and type
+class WkbWriter {
+ public:
+  explicit WkbWriter(Endian endian = Endian::LITTLE);
+
+  void Point(Point2D const& point);
+  void LineString(std::span<Point2D const> points);
+  void LineString(std::span<Point2Df const> points);  // written in double, as any WKB
+  void Polygon(std::span<std::span<Point2D const> const> rings);
+  // the header of a multi geometry: the count geometries that follow are its parts
+  void MultiPoint(int count);
+  void MultiLineString(int count);
+
+  inline std::vector<std::uint8_t> const& Bytes() const { return BYTES; }
+  inline std::vector<std::uint8_t> Release() { return std::move(BYTES); }
+
+ private:
+  Endian ENDIAN;
+  std::vector<std::uint8_t> BYTES;
+
+  void Header(std::uint32_t type);
+  void Write(std::uint32_t n);
+  void Write(double x);
+  template <Scalar T>
+  void WritePoints(std::span<BasicPoint2D<T> const> points);  // the count, then the points
+  template <Scalar T>
+  void LineStringOf(std::span<BasicPoint2D<T> const> points);
+};
+
+// decodes the geometries from a byte span, in order, without copies: throws std::runtime_error at the first one that
+// is not of the type expected, or when the bytes end too early
+class WkbReader {
+ public:
+  explicit WkbReader(std::span<std::uint8_t const> wkb);
+
+  Point2D Point();
+  std::vector<Point2D> LineString();
+  std::vector<std::vector<Point2D>> Polygon();  // the rings
+  // the number of parts of the multi geometry
+  int MultiPoint();
+  int MultiLineString();
+  void End();  // no bytes left
+
+ private:
+  std::span<std::uint8_t const> WKB;
+  std::size_t POS = 0;
+  bool SWAP = false;  // the byte order of the current geometry is not the native one
+
+  void Header(std::uint32_t type);
+  std::uint32_t ReadCount();
+  std::vector<Point2D> ReadPoints();  // the count, then the points
+  double ReadDouble();
+  void Need(std::size_t bytes) const;
+};
+
+#pragma region Collections
+
+// MULTIPOINT of the points, MULTILINESTRING of the segments or polylines
+std::vector<std::uint8_t> to_wkb(std::vector<Point2D> const& points, Endian endian = Endian::LITTLE);
+std::vector<std::uint8_t> to_wkb(std::vector<LineSegment2D> const& segments, Endian endian = Endian::LITTLE);
+std::vector<std::uint8_t> to_wkb(std::vector<Polyline2D> const& polylines, Endian endian = Endian::LITTLE);
+
+std::vector<Point2D> points_from_wkb(std::span<std::uint8_t const> wkb);
+std::vector<LineSegment2D> segments_from_wkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+std::vector<Polyline2D> polylines_from_wkb(std::span<std::uint8_t const> wkb, int decimal_precision = DP_THREE);
+
+#pragma endregion
+
+#pragma region Files
+
+void write_wkb_file(std::string const& path, std::span<std::uint8_t const> wkb);
+std::vector<std::uint8_t> read_wkb_file(std::string const& path);
+
+#pragma endregion
+
+}  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "point2d.hpp"
+#include "vector2d.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace geompp {
+
+// Single pass WKT lexer and parser over a string_view, without copies of the text: each FromWkt reads its tag,
+// brackets and numbers in order, and the reader throws std::runtime_error at the first token that does not match.
+// Without throwing (for the TryFromWkt), it keeps that first error instead, and the calls after it read nothing.
+// The numbers are parsed with std::from_chars, and the reader keeps the most decimal places written in any of them
+// (as in "1.250" -> 2, "1.5e-3" -> 4), for the geometries that take their precision from the text.
+class WktReader {
+ public:
+  explicit WktReader(std::string_view wkt, bool throws = true);
+
+  // the geometry name, in any case
+  void Tag(std::string_view tag);
+  void Expect(char c);
+  bool Accept(char c);  // skips c if it is the next token
+  double Number();
+  Point2D Point();    // "x y"
+  Vector2D Vector();  // "x y"
+  std::vector<Point2D> Points();  // "(x y, x y, ...)", at least one point
+  void End();  // nothing but spaces left
+
+  inline int DecimalPlaces() const { return DECIMAL_PLACES; }
+  inline bool Failed() const { return FAILED; }
+
+ private:
+  std::string_view WKT;
+  std::size_t POS = 0;
+  int DECIMAL_PLACES = 0;
+  bool THROWS;
+  bool FAILED = false;
+
+  void SkipSpaces();
+  void Fail(std::string_view expected);
+};
+
+}  // namespace geompp
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "constants.hpp"
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polygon2d.hpp"
+#include "polyline2d.hpp"
+#include "ray2d.hpp"
+#include "vector2d.hpp"
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace geompp {
+
+// the shortest text of round_to(x, decimal_precision) (as std::format("{}") of it), with std::to_chars, in buf
+// (large enough for any double); returns the number of characters written
+int format_number(double x, int decimal_precision, char (&buf)[32]);
+
+#pragma region Sinks
+
+// appends to a string
+class StringSink {
+ public:
+  explicit StringSink(std::string& out) : OUT(&out) {}
+  inline void Put(std::string_view text) { OUT->append(text); }
+
+ private:
+  std::string* OUT;
+};
+
+// writes into a fixed buffer, throws std::runtime_error when it is full
+class BufferSink {
+ public:
+  explicit BufferSink(std::span<char> buffer) : BUFFER(buffer) {}
+  inline void Put(std::string_view text) {
+    if (text.size() > BUFFER.size() - SIZE) {
+      throw std::runtime_error("the WKT does not fit in the buffer");
+    }
+    std::copy(text.begin(), text.end(), BUFFER.begin() + SIZE);
+    SIZE += text.size();
+  }
+  inline std::size_t Size() const { return SIZE; }
+  inline std::string_view View() const { return {BUFFER.data(), SIZE}; }
+
+ private:
+  std::span<char> BUFFER;
+  std::size_t SIZE = 0;
+};
+
+// copies to an output iterator of char
+template <typename OutputIt>
+class IteratorSink {
+ public:
+  explicit IteratorSink(OutputIt out) : OUT(out) {}
+  inline void Put(std::string_view text) { OUT = std::copy(text.begin(), text.end(), OUT); }
+  inline OutputIt Iterator() const { return OUT; }
+
+ private:
+  OutputIt OUT;
+};
+
+#pragma endregion
+
+// Writes the WKT of the geometries (as their ToWkt) one after the other into a sink, with the coordinates rounded at
+// the decimal precision: no intermediate strings, streams or std::format.
+template <typename Sink>
+class WktWriter {
+ public:
+  explicit WktWriter(Sink sink, int decimal_precision = DP_THREE)
+      : SINK(sink), DECIMAL_PRECISION(decimal_precision) {}
+
+  inline Sink& GetSink() { return SINK; }
+
+  template <Scalar T>
+  void Write(BasicPoint2D<T> const& point) { Single("POINT (", point.x(), point.y()); }
+  template <Scalar T>
+  void Write(BasicVector2D<T> const& vector) { Single("VECTOR (", vector.x(), vector.y()); }
+  void Write(Line2D const& line) { Pair("LINE (", line.First(), line.Last()); }
+  void Write(Ray2D const& ray) { Pair("RAY (", ray.Origin(), Point2D(ray.Direction().x(), ray.Direction().y())); }
+  template <Scalar T>
+  void Write(BasicLineSegment2D<T> const& segment) { Pair("LINESTRING (", segment.First(), segment.Last()); }
+  template <Scalar T>
+  void Write(BasicPolyline2D<T> const& polyline) {
+    auto const& knots = polyline.Knots();
+    if (knots.empty()) {
+      SINK.Put("LINESTRING EMPTY");
+      return;
+    }
+    SINK.Put("LINESTRING ");
+    Points(std::span<BasicPoint2D<T> const>(knots));
+  }
+  void Write(Polygon2D const& polygon) {
+    SINK.Put("POLYGON (");
+    for (int i = 0; i < polygon.Rings(); ++i) {
+      if (i > 0) {
+        SINK.Put(", ");
+      }
+      Points(polygon.Ring(i));
+    }
+    SINK.Put(")");
+  }
+
+  // the geometries, with the separator between them
+  template <typename Geometry>
+  void WriteAll(std::span<Geometry const> geometries, std::string_view separator = "\n") {
+    for (int i = 0; i < geometries.size(); ++i) {
+      if (i > 0) {
+        SINK.Put(separator);
+      }
+      Write(geometries[i]);
+    }
+  }
+
+ private:
+  Sink SINK;
+  int DECIMAL_PRECISION;
+
+  void Number(double x) {
+    char buf[32];
+    SINK.Put({buf, static_cast<std::size_t>(format_number(x, DECIMAL_PRECISION, buf))});
+  }
+  void Coordinates(double x, double y) {
+    Number(x);
+    SINK.Put(" ");
+    Number(y);
+  }
+  void Single(std::string_view tag, double x, double y) {
+    SINK.Put(tag);
+    Coordinates(x, y);
+    SINK.Put(")");
+  }
+  template <Scalar T>
+  void Points(std::span<BasicPoint2D<T> const> points) {  // "(x y, x y, ...)"
+    SINK.Put("(");
+    for (int i = 0; i < points.size(); ++i) {
+      if (i > 0) {
+        SINK.Put(", ");
+      }
+      Coordinates(points[i].x(), points[i].y());
+    }
+    SINK.Put(")");
+  }
+  template <Scalar T>
+  void Pair(std::string_view tag, BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1) {
+    SINK.Put(tag);
+    Coordinates(p0.x(), p0.y());
+    SINK.Put(", ");
+    Coordinates(p1.x(), p1.y());
+    SINK.Put(")");
+  }
+};
+
+#pragma region Batch Export
+
+// the most characters the WKT of the geometry can take, at any precision
+template <Scalar T>
+inline std::size_t max_wkt_size(BasicPoint2D<T> const&) { return 16 + 2 * 24; }
+template <Scalar T>
+inline std::size_t max_wkt_size(BasicVector2D<T> const&) { return 16 + 2 * 24; }
+inline std::size_t max_wkt_size(Line2D const&) { return 16 + 4 * 24; }
+inline std::size_t max_wkt_size(Ray2D const&) { return 16 + 4 * 24; }
+template <Scalar T>
+inline std::size_t max_wkt_size(BasicLineSegment2D<T> const&) { return 16 + 4 * 24; }
+template <Scalar T>
+inline std::size_t max_wkt_size(BasicPolyline2D<T> const& polyline) { return 16 + polyline.Size() * (2 * 24 + 3); }
+inline std::size_t max_wkt_size(Polygon2D const& polygon) {
+  return 16 + polygon.Rings() * 4 + polygon.Size() * (2 * 24 + 3);
+}
+
+// appends the WKT of all the geometries to the string, with the separator between them, reserving all the space it
+// can take at once
+template <typename Geometry>
+void append_wkt(std::string& out, std::span<Geometry const> geometries, int decimal_precision = DP_THREE,
+                std::string_view separator = "\n") {
+  std::size_t size = out.size();
+  for (auto const& geometry : geometries) {
+    size += max_wkt_size(geometry) + separator.size();
+  }
+  out.reserve(size);
+  WktWriter<StringSink>(StringSink(out), decimal_precision).WriteAll(geometries, separator);
+}
+
+template <typename Geometry>
+std::string to_wkt(std::vector<Geometry> const& geometries, int decimal_precision = DP_THREE,
+                   std::string_view separator = "\n") {
+  std::string out;
+  append_wkt(out, std::span<Geometry const>(geometries), decimal_precision, separator);
+  return out;
+}
+
+#pragma endregion
+
+}  // namespace geompp
\ No newline at end of file
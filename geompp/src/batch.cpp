@@ -0,0 +1,50 @@
+#include "batch.hpp"
+
+#include "executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace geompp::batch {
+
+namespace {
+
+// half of a usual L1 data cache, for the inputs and outputs of a chunk
+constexpr std::size_t CHUNK_BYTES = 16 * 1024;
+constexpr int MIN_CHUNK = 64;
+constexpr int MAX_CHUNK = 4096;
+
+}  // namespace
+
+void for_each_chunk(int size, Options const& options, std::size_t item_bytes,
+                    std::function<void(int first, int last)> const& fn) {
+  if (size <= 0) {
+    return;
+  }
+  int chunk = options.chunk;
+  if (chunk <= 0) {
+    chunk = std::clamp(static_cast<int>(CHUNK_BYTES / std::max<std::size_t>(item_bytes, 1)), MIN_CHUNK, MAX_CHUNK);
+  }
+  int chunks = (size + chunk - 1) / chunk;
+
+  std::atomic<int> next{0};
+  auto run = [&](int) {
+    for (int c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+      try {
+        fn(c * chunk, std::min(size, (c + 1) * chunk));
+      } catch (...) {
+        next = chunks;  // the others stop at their next chunk
+        throw;
+      }
+    }
+  };
+  if (options.threads == 1 || chunks == 1) {
+    run(0);
+    return;
+  }
+  auto& executor = options.executor ? *options.executor : Executor::Default();
+  int threads = std::min(options.threads > 0 ? options.threads : executor.Concurrency(), chunks);
+  executor.parallel_for(0, threads, run, 1);
+}
+
+}  // namespace geompp::batch
@@ -0,0 +1,41 @@
+#include "bounding_box2d.hpp"
+
+#include "ray2d.hpp"
+#include "tolerance.hpp"
+#include "vector2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geompp {
+
+#pragma region Query Boxes
+
+BoundingBox2D widen_box(BoundingBox2D const& box, double reach, int decimal_precision) {
+  double h = 0.5 / Tolerance(decimal_precision).Scale();
+  double magnitude = std::max({std::abs(box.MinX()), std::abs(box.MinY()), std::abs(box.MaxX()), std::abs(box.MaxY())});
+  return box.Expand(h * (reach + 1) * (1 + 1e-9) + 64 * std::numeric_limits<double>::epsilon() * magnitude);
+}
+
+bool box_crosses_line(BoundingBox2D const& box, Point2D const& origin, Vector2D const& dir) {
+  int above = 0, below = 0;
+  for (auto const& corner : {box.Min(), box.Max(), Point2D(box.MinX(), box.MaxY()), Point2D(box.MaxX(), box.MinY())}) {
+    double side = (corner - origin).Cross(dir);
+    above += side > 0;
+    below += side < 0;
+  }
+  return above < 4 && below < 4;
+}
+
+bool box_ahead_of_ray(BoundingBox2D const& box, Ray2D const& ray, int decimal_precision) {
+  auto const& o = ray.Origin();
+  auto const& d = ray.Direction();
+  double dot = std::max(d.x() * (box.MinX() - o.x()), d.x() * (box.MaxX() - o.x())) +
+               std::max(d.y() * (box.MinY() - o.y()), d.y() * (box.MaxY() - o.y()));
+  return Tolerance(decimal_precision).IsNonNegative(dot);
+}
+
+#pragma endregion
+
+}  // namespace geompp
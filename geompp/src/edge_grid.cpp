@@ -0,0 +1,181 @@
+#include "edge_grid.hpp"
+
+#include "predicates.hpp"
+#include "stats.hpp"
+
+#include <numeric>
+
+namespace geompp {
+
+namespace {
+
+// the crossing of the edge a-b with the ray from p to the right (Sunday): +1 for an edge going up with p on its left,
+// -1 for one going down with p on its right, the knots on the ray counted as above it
+int right_crossing(Point2D const& a, Point2D const& b, Point2D const& p) {
+  if (a.y() <= p.y()) {
+    if (b.y() > p.y() && orientation(a, b, p) > 0) {
+      return 1;
+    }
+  } else if (b.y() <= p.y() && orientation(a, b, p) < 0) {
+    return -1;
+  }
+  return 0;
+}
+
+// the same with the ray from p up (the one to the right, turned by 90 degrees): the same sum on all the edges for the
+// points not on them
+int up_crossing(Point2D const& a, Point2D const& b, Point2D const& p) {
+  if (b.x() < p.x()) {
+    if (p.x() <= a.x() && orientation(a, b, p) > 0) {
+      return 1;
+    }
+  } else if (a.x() < p.x() && orientation(a, b, p) < 0) {
+    return -1;
+  }
+  return 0;
+}
+
+bool on_edge(Point2D const& a, Point2D const& b, Point2D const& p) {
+  return std::min(a.x(), b.x()) <= p.x() && p.x() <= std::max(a.x(), b.x()) && std::min(a.y(), b.y()) <= p.y() &&
+         p.y() <= std::max(a.y(), b.y()) && orientation(a, b, p) == 0;
+}
+
+}  // namespace
+
+EdgeGrid EdgeGrid::Make(std::vector<Point2D> const& knots, std::vector<int> const& rings) {
+  GEOMPP_PROFILE_SCOPE("EdgeGrid::Make");
+  EdgeGrid grid;
+  std::vector<int> edges;
+  for (int r = 0; r + 1 < rings.size(); ++r) {
+    for (int k = rings[r]; k + 1 < rings[r + 1]; ++k) {
+      edges.push_back(k);
+    }
+  }
+  for (auto const& knot : knots) {
+    grid.BOX = grid.BOX.Union(knot);
+  }
+
+  // about one cell per edge, as square as the box allows
+  int n = std::max<int>(edges.size(), 1);
+  double width = grid.BOX.Width(), height = grid.BOX.Height();
+  if (width > 0 && height > 0) {
+    grid.COLUMNS = std::clamp(static_cast<int>(std::round(std::sqrt(n * width / height))), 1, n);
+    grid.ROWS = std::clamp(static_cast<int>(std::round(static_cast<double>(n) / grid.COLUMNS)), 1, n);
+  } else {
+    grid.COLUMNS = grid.ROWS = 1;
+  }
+  grid.CELL_WIDTH = width > 0 ? width / grid.COLUMNS : 1;
+  grid.CELL_HEIGHT = height > 0 ? height / grid.ROWS : 1;
+
+  // the edges of each cell, in two passes: the counts, then the edges
+  int cells = grid.COLUMNS * grid.ROWS;
+  // (an edge walks its columns, in each only the rows it crosses there: about as many cells as it is long in cells)
+  auto for_cells = [&grid, &knots](int k, auto&& fn) {
+    auto const& a = knots[k];
+    auto const& b = knots[k + 1];
+    int c0 = grid.Column(std::min(a.x(), b.x())), c1 = grid.Column(std::max(a.x(), b.x()));
+    for (int c = c0; c <= c1; ++c) {
+      auto [r0, r1] = grid.EdgeRows(a, b, c);
+      for (int r = r0; r <= r1; ++r) {
+        fn(r * grid.COLUMNS + c);
+      }
+    }
+  };
+  grid.OFFSETS.assign(cells + 1, 0);
+  for (int k : edges) {
+    for_cells(k, [&grid](int cell) { ++grid.OFFSETS[cell + 1]; });
+  }
+  std::partial_sum(grid.OFFSETS.begin(), grid.OFFSETS.end(), grid.OFFSETS.begin());
+  grid.EDGES.resize(grid.OFFSETS.back());
+  std::vector<int> next(grid.OFFSETS.begin(), grid.OFFSETS.end() - 1);
+  for (int k : edges) {
+    for_cells(k, [&grid, &next, k](int cell) { grid.EDGES[next[cell]++] = k; });
+  }
+
+  // the winding numbers about the centers, row by row from the left of the box (where it is 0), each center from the
+  // one before: the edges crossed on the way are in its cell, or in the cell before
+  grid.WINDINGS.assign(cells, 0);
+  for (int r = 0; r < grid.ROWS; ++r) {
+    Point2D from(grid.BOX.MinX() - grid.CELL_WIDTH, grid.Center(0, r).y());
+    int winding = 0;
+    for (int c = 0; c < grid.COLUMNS; ++c) {
+      int cell = r * grid.COLUMNS + c;
+      Point2D center = grid.Center(c, r);
+      auto cross = [&knots, &winding, &from, &center](int k) {
+        winding += right_crossing(knots[k], knots[k + 1], center) - right_crossing(knots[k], knots[k + 1], from);
+      };
+      bool on_any_edge = grid.Column(center.x()) != c || grid.Row(center.y()) != r;  // not in its cell, by rounding
+      for (int i = grid.OFFSETS[cell]; i < grid.OFFSETS[cell + 1]; ++i) {
+        int k = grid.EDGES[i];
+        cross(k);
+        on_any_edge = on_any_edge || on_edge(knots[k], knots[k + 1], center);
+      }
+      if (c > 0) {
+        for (int i = grid.OFFSETS[cell - 1]; i < grid.OFFSETS[cell]; ++i) {
+          int k = grid.EDGES[i];
+          auto [r0, r1] = grid.EdgeRows(knots[k], knots[k + 1], c);
+          if (r < r0 || r1 < r) {  // not in this cell
+            cross(k);
+          }
+        }
+      }
+
+      grid.WINDINGS[cell] = on_any_edge ? ON_EDGE : winding;
+      from = center;
+    }
+  }
+
+  return grid;
+}
+
+std::pair<int, int> EdgeGrid::EdgeRows(Point2D const& a, Point2D const& b, int column) const {
+  auto const& left = a.x() <= b.x() ? a : b;
+  auto const& right = a.x() <= b.x() ? b : a;
+  int c0 = Column(left.x()), c1 = Column(right.x());
+  if (column < c0 || c1 < column) {
+    return {1, 0};
+  }
+  int r0 = Row(std::min(a.y(), b.y())), r1 = Row(std::max(a.y(), b.y()));
+  if (c0 == c1) {
+    return {r0, r1};
+  }
+
+  // the part of the edge over the column (a little wider, for the points that Column puts in it by rounding), then
+  // its rows, a little wider for the rounding of y
+  constexpr double ulps = 8 * std::numeric_limits<double>::epsilon();
+  double slack = 1e-6 * CELL_WIDTH + ulps * (std::abs(BOX.MinX()) + std::abs(BOX.MaxX()));
+  double x0 = std::max(left.x(), BOX.MinX() + column * CELL_WIDTH - slack);
+  double x1 = std::min(right.x(), BOX.MinX() + (column + 1) * CELL_WIDTH + slack);
+  double slope = (right.y() - left.y()) / (right.x() - left.x());
+  double y0 = x0 == left.x() ? left.y() : left.y() + (x0 - left.x()) * slope;
+  double y1 = x1 == right.x() ? right.y() : left.y() + (x1 - left.x()) * slope;
+  double margin = 1e-6 * CELL_HEIGHT + ulps * (std::abs(left.y()) + std::abs(right.y()));
+  return {std::max(r0, Row(std::min(y0, y1) - margin)), std::min(r1, Row(std::max(y0, y1) + margin))};
+}
+
+std::optional<int> EdgeGrid::WindingNumber(std::vector<Point2D> const& knots, Point2D const& point) const {
+  if (!BOX.Contains(point)) {
+    return 0;
+  }
+  int cell = Row(point.y()) * COLUMNS + Column(point.x());
+  if (WINDINGS[cell] == ON_EDGE) {
+    return std::nullopt;
+  }
+
+  // from the center up (or down) to the corner, then to the right (or left) to the point
+  Point2D center = Center(Column(point.x()), Row(point.y()));
+  Point2D corner(center.x(), point.y());
+  int winding = WINDINGS[cell];
+  for (int i = OFFSETS[cell]; i < OFFSETS[cell + 1]; ++i) {
+    auto const& a = knots[EDGES[i]];
+    auto const& b = knots[EDGES[i] + 1];
+    if (on_edge(a, b, corner)) {
+      return std::nullopt;
+    }
+    winding += up_crossing(a, b, corner) - up_crossing(a, b, center);
+    winding += right_crossing(a, b, point) - right_crossing(a, b, corner);
+  }
+  return winding;
+}
+
+}  // namespace geompp
@@ -0,0 +1,144 @@
+#include "executor.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace geompp {
+
+namespace {
+
+// the executor and queue of the current thread, when it is a worker
+thread_local Executor const* current_executor = nullptr;
+thread_local int current_queue = -1;
+
+void pin_thread(int cpu) {
+#ifdef _WIN32
+  SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (cpu % (8 * sizeof(DWORD_PTR))));
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % CPU_SETSIZE, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;  // not supported, the workers are left to the system
+#endif
+}
+
+}  // namespace
+
+Executor::Executor(int threads, bool pin) {
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < threads; ++i) {
+    QUEUES.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 0; i < threads - 1; ++i) {
+    WORKERS.emplace_back(&Executor::Work, this, i, pin);
+  }
+}
+
+Executor::~Executor() {
+  {
+    std::lock_guard lock(SLEEP_MUTEX);
+    STOP = true;
+  }
+  WAKE.notify_all();
+  for (auto& worker : WORKERS) {
+    worker.join();
+  }
+}
+
+Executor& Executor::Default() {
+  static Executor executor;
+  return executor;
+}
+
+int Executor::Self() const {
+  return current_executor == this ? current_queue : static_cast<int>(QUEUES.size()) - 1;
+}
+
+void Executor::Push(Task* task) {
+  auto& queue = *QUEUES[Self()];
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  PENDING.fetch_add(1);
+  {
+    std::lock_guard lock(SLEEP_MUTEX);  // not to notify between the check and the wait of a worker
+  }
+  WAKE.notify_one();
+}
+
+bool Executor::Reclaim(Task* task) {
+  auto& queue = *QUEUES[Self()];
+  std::lock_guard lock(queue.mutex);
+  // the last one, but for the queue shared by the threads outside the pool
+  auto found = std::find(queue.tasks.rbegin(), queue.tasks.rend(), task);
+  if (found == queue.tasks.rend()) {
+    return false;
+  }
+  queue.tasks.erase(std::next(found).base());
+  PENDING.fetch_sub(1);
+  return true;
+}
+
+bool Executor::RunOne(int self) {
+  int n = static_cast<int>(QUEUES.size());
+  Task* task = nullptr;
+  for (int k = 0; k < n && !task; ++k) {
+    auto& queue = *QUEUES[(self + k) % n];
+    std::lock_guard lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      if (k == 0) {  // own: the newest, the smallest and still in cache
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+      } else {  // stolen: the oldest, the largest
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+      }
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  PENDING.fetch_sub(1);
+  task->Run();
+  return true;
+}
+
+void Executor::Wait(Task* task) {
+  int self = Self();
+  while (!task->done.load(std::memory_order_acquire)) {
+    if (!RunOne(self)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void Executor::Work(int index, bool pin) {
+  current_executor = this;
+  current_queue = index;
+  if (pin) {
+    pin_thread(index + 1);  // the first processor left to the main thread
+  }
+  while (true) {
+    if (RunOne(index)) {
+      continue;
+    }
+    std::unique_lock lock(SLEEP_MUTEX);
+    WAKE.wait(lock, [this] { return STOP || PENDING.load() > 0; });
+    if (STOP && PENDING.load() == 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace geompp
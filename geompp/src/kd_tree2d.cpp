@@ -0,0 +1,231 @@
+#include "kd_tree2d.hpp"
+
+#include "executor.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace geompp {
+
+namespace {
+
+// below this size a range is not worth a thread of its own
+constexpr int PARALLEL_MIN_SIZE = 1 << 15;
+
+int thread_count(int threads) { return threads > 0 ? threads : Executor::Default().Concurrency(); }
+
+// calls fn(i) for i in [0, size), in up to threads contiguous ranges run on the executor of the library
+template <typename Fn>
+void parallel_for(int size, int threads, Fn&& fn) {
+  threads = thread_count(threads);
+  Executor::Default().parallel_for(0, size, fn, std::max(1, (size + threads - 1) / threads));
+}
+
+}  // namespace
+
+#pragma region Constructors
+
+KDTree2D KDTree2D::Make(std::vector<Point2D> const& points, int threads) {
+  GEOMPP_PROFILE_SCOPE("KDTree2D::Make");
+  std::vector<double> xs, ys;
+  xs.reserve(points.size());
+  ys.reserve(points.size());
+  for (auto const& point : points) {
+    xs.push_back(point.x());
+    ys.push_back(point.y());
+  }
+  return KDTree2D(xs, ys, threads);
+}
+
+KDTree2D KDTree2D::Make(PointBuffer2D const& points, int threads) {
+  GEOMPP_PROFILE_SCOPE("KDTree2D::Make");
+  return KDTree2D(points.Xs(), points.Ys(), threads);
+}
+
+KDTree2D::KDTree2D(std::vector<double> const& xs, std::vector<double> const& ys, int threads) {
+  int n = xs.size();
+  std::vector<Entry> entries(n);
+  for (int i = 0; i < n; ++i) {
+    entries[i] = {{xs[i], ys[i]}, i};
+  }
+  AXES.resize(n, 0);
+  Build(entries, 0, n, thread_count(threads));
+
+  XS.reserve(n);
+  YS.reserve(n);
+  INDICES.reserve(n);
+  for (auto const& entry : entries) {
+    XS.push_back(entry.coords[0]);
+    YS.push_back(entry.coords[1]);
+    INDICES.push_back(entry.index);
+  }
+}
+
+void KDTree2D::Build(std::vector<Entry>& entries, int first, int last, int threads) {
+  if (last - first <= LEAF_SIZE) {
+    return;
+  }
+
+  double min[2] = {entries[first].coords[0], entries[first].coords[1]};
+  double max[2] = {min[0], min[1]};
+  for (int i = first + 1; i < last; ++i) {
+    for (int a : {0, 1}) {
+      min[a] = std::min(min[a], entries[i].coords[a]);
+      max[a] = std::max(max[a], entries[i].coords[a]);
+    }
+  }
+  int axis = max[1] - min[1] > max[0] - min[0] ? 1 : 0;
+  int mid = first + (last - first) / 2;
+  std::nth_element(entries.begin() + first, entries.begin() + mid, entries.begin() + last,
+                   [axis](Entry const& a, Entry const& b) { return a.coords[axis] < b.coords[axis]; });
+  AXES[mid] = axis;
+
+  if (threads > 1 && last - first >= PARALLEL_MIN_SIZE) {
+    int left = threads / 2, right = threads - left;
+    Executor::Default().Join([this, &entries, first, mid, left] { Build(entries, first, mid, left); },
+                             [this, &entries, mid, last, right] { Build(entries, mid + 1, last, right); });
+  } else {
+    Build(entries, first, mid, 1);
+    Build(entries, mid + 1, last, 1);
+  }
+}
+
+BoundingBox2D KDTree2D::BoundingBox() const {
+  auto box = BoundingBox2D::Empty();
+  for (int i = 0; i < Size(); ++i) {
+    box = box.Union(Point2D(XS[i], YS[i]));
+  }
+  return box;
+}
+
+#pragma endregion
+
+#pragma region Queries
+
+void KDTree2D::Search(Point2D const& point, int first, int last, int k,
+                      std::vector<std::pair<double, int>>& heap) const {
+  auto consider = [this, &point, k, &heap](int i) {
+    double dx = XS[i] - point.x(), dy = YS[i] - point.y();
+    std::pair<double, int> candidate{dx * dx + dy * dy, INDICES[i]};
+    if (heap.size() < k) {
+      heap.push_back(candidate);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (candidate < heap.front()) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = candidate;
+      std::push_heap(heap.begin(), heap.end());
+    }
+  };
+
+  if (last - first <= LEAF_SIZE) {
+    for (int i = first; i < last; ++i) {
+      consider(i);
+    }
+    return;
+  }
+
+  // the near side first, then the far side only if it can hold something as near as the k-th so far
+  int mid = first + (last - first) / 2;
+  double diff = AXES[mid] == 0 ? point.x() - XS[mid] : point.y() - YS[mid];
+  if (diff < 0) {
+    Search(point, first, mid, k, heap);
+  } else {
+    Search(point, mid + 1, last, k, heap);
+  }
+  consider(mid);
+  if (heap.size() < k || diff * diff <= heap.front().first) {
+    if (diff < 0) {
+      Search(point, mid + 1, last, k, heap);
+    } else {
+      Search(point, first, mid, k, heap);
+    }
+  }
+}
+
+void KDTree2D::Collect(Point2D const& point, double squared_radius, int first, int last,
+                       std::vector<int>& found) const {
+  auto consider = [this, &point, squared_radius, &found](int i) {
+    double dx = XS[i] - point.x(), dy = YS[i] - point.y();
+    if (dx * dx + dy * dy <= squared_radius) {
+      found.push_back(INDICES[i]);
+    }
+  };
+
+  if (last - first <= LEAF_SIZE) {
+    for (int i = first; i < last; ++i) {
+      consider(i);
+    }
+    return;
+  }
+
+  int mid = first + (last - first) / 2;
+  double diff = AXES[mid] == 0 ? point.x() - XS[mid] : point.y() - YS[mid];
+  if (diff <= 0 || diff * diff <= squared_radius) {
+    Collect(point, squared_radius, first, mid, found);
+  }
+  consider(mid);
+  if (diff >= 0 || diff * diff <= squared_radius) {
+    Collect(point, squared_radius, mid + 1, last, found);
+  }
+}
+
+KDTree2D::Neighbour KDTree2D::Nearest(Point2D const& point) const {
+  if (Size() == 0) {
+    throw std::runtime_error("cannot find the nearest point in an empty tree");
+  }
+  return KNearest(point, 1)[0];
+}
+
+std::vector<KDTree2D::Neighbour> KDTree2D::KNearest(Point2D const& point, int k) const {
+  std::vector<std::pair<double, int>> heap;
+  if (k <= 0) {
+    return {};
+  }
+  heap.reserve(std::min(k, Size()));
+  Search(point, 0, Size(), k, heap);
+
+  std::sort_heap(heap.begin(), heap.end());
+  std::vector<Neighbour> nearest;
+  nearest.reserve(heap.size());
+  for (auto const& [squared_distance, index] : heap) {
+    nearest.push_back({index, squared_distance});
+  }
+  return nearest;
+}
+
+std::vector<int> KDTree2D::Within(Point2D const& point, double radius) const {
+  std::vector<int> found;
+  if (radius >= 0) {
+    Collect(point, radius * radius, 0, Size(), found);
+  }
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+std::vector<KDTree2D::Neighbour> KDTree2D::Nearest(std::vector<Point2D> const& points, int threads) const {
+  if (Size() == 0 && !points.empty()) {
+    throw std::runtime_error("cannot find the nearest point in an empty tree");
+  }
+  std::vector<Neighbour> nearest(points.size());
+  parallel_for(points.size(), threads, [this, &points, &nearest](int i) { nearest[i] = Nearest(points[i]); });
+  return nearest;
+}
+
+std::vector<std::vector<KDTree2D::Neighbour>> KDTree2D::KNearest(std::vector<Point2D> const& points, int k,
+                                                                 int threads) const {
+  std::vector<std::vector<Neighbour>> nearest(points.size());
+  parallel_for(points.size(), threads, [this, &points, k, &nearest](int i) { nearest[i] = KNearest(points[i], k); });
+  return nearest;
+}
+
+std::vector<std::vector<int>> KDTree2D::Within(std::vector<Point2D> const& points, double radius, int threads) const {
+  std::vector<std::vector<int>> found(points.size());
+  parallel_for(points.size(), threads,
+               [this, &points, radius, &found](int i) { found[i] = Within(points[i], radius); });
+  return found;
+}
+
+#pragma endregion
+
+}  // namespace geompp
@@ -2,7 +2,12 @@
 
 #include "line_segment2d.hpp"
 #include "ray2d.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
 #include "utils.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
 #include <cmath>
 #include <format>
@@ -15,37 +20,48 @@ namespace geompp {
 #pragma region Constructors
 
 Line2D Line2D::Make(Point2D const& p0, Point2D const& p1, int decimal_precision) {
-  if (p0.AlmostEquals(p1, decimal_precision)) {
+  auto line = TryMake(p0, p1, decimal_precision);
+  if (!line) {
     throw std::runtime_error(std::format("point {} and {} are too close with {} decimals precision",
                                          p0.ToWkt(decimal_precision), p1.ToWkt(decimal_precision), decimal_precision));
   }
-  return {p0, p1};
+  return *std::move(line);
+}
+
+expected<Line2D, GeomError> Line2D::TryMake(Point2D const& p0, Point2D const& p1, int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Line2D::Make");
+  if (p0.AlmostEquals(p1, decimal_precision)) {
+    return unexpected(GeomError::POINTS_TOO_CLOSE);
+  }
+  return Line2D(p0, p1);
 }
 
 Line2D Line2D::Make(Point2D const& p0, Vector2D const& dir, int decimal_precision) {
-  if (round_to(dir.Length(), decimal_precision) == 0) {
+  auto line = TryMake(p0, dir, decimal_precision);
+  if (!line) {
     throw std::runtime_error(std::format("the direction is almost zero with {} decimals precision", decimal_precision));
   }
-  return {p0, dir};
+  return *std::move(line);
+}
+
+expected<Line2D, GeomError> Line2D::TryMake(Point2D const& p0, Vector2D const& dir, int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Line2D::Make");
+  if (Tolerance(decimal_precision).IsZero(dir.Length())) {
+    return unexpected(GeomError::ZERO_DIRECTION);
+  }
+  return Line2D(p0, dir);
 }
 
 Line2D::Line2D(Point2D const& p0, Point2D const& p1) : P0(p0), P1(p1), DIR((p1 - p0).Normalize()) {}
 
 Line2D::Line2D(Point2D const& orig, Vector2D const& dir) : P0(orig), DIR(dir.Normalize()), P1(orig + dir) {}
 
-Line2D& Line2D::operator=(Line2D const& other) {
-  if (this != &other) {
-    *this = other;
-  }
-  return *this;
-}
-
 bool Line2D::AlmostEquals(Line2D const& other, int decimal_precision) const {
   return P0.AlmostEquals(other.P0, decimal_precision) && P1.AlmostEquals(other.P1, decimal_precision);
 }
 
 double Line2D::DistanceTo(Point2D const& point, int decimal_precision) const {
-  return round_to(abs((point - P0).Perp().Dot(DIR)), decimal_precision);
+  return round_to(std::abs((point - P0).Perp().Dot(DIR)), decimal_precision);
 }
 
 Point2D Line2D::ProjectOnto(Point2D const& point, int decimal_precision) const {
@@ -63,12 +79,12 @@ bool operator==(Line2D const& lhs, Line2D const& rhs) { return lhs.AlmostEquals(
 #pragma region Geometrical Operations
 
 bool Line2D::Contains(Point2D const& point, int decimal_precision) const {
-  return round_to((point - P0).Cross(DIR), decimal_precision) == 0.0;
+  return Tolerance(decimal_precision).IsZero((point - P0).Cross(DIR));
 }
 
 bool Line2D::Intersects(Line2D const& other, int decimal_precision) const {
   // very easy to verify in 2D plane
-  return round_to(DIR.Cross(other.DIR), decimal_precision) != 0.0;
+  return !Tolerance(decimal_precision).IsZero(DIR.Cross(other.DIR));
 }
 
 bool Line2D::Intersects(Ray2D const& ray, int decimal_precision) const {
@@ -80,12 +96,14 @@ bool Line2D::Intersects(LineSegment2D const& segment, int decimal_precision) con
 }
 
 Line2D::ReturnSet Line2D::Intersection(Line2D const& other, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Line2D::Intersection");
   auto u = DIR;
   auto v = other.DIR;
   auto vp = v.Perp();
   auto w = (P0 - other.P0);
 
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (Tolerance(decimal_precision).IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("Line2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
@@ -94,10 +112,12 @@ Line2D::ReturnSet Line2D::Intersection(Line2D const& other, int decimal_precisio
 }
 
 Line2D::ReturnSet Line2D::Intersection(Ray2D const& ray, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Line2D::Intersection");
   return ray.Intersection(*this, decimal_precision);
 }
 
 Line2D::ReturnSet Line2D::Intersection(LineSegment2D const& segment, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Line2D::Intersection");
   return segment.Intersection(*this, decimal_precision);
 }
 
@@ -106,53 +126,36 @@ Line2D::ReturnSet Line2D::Intersection(LineSegment2D const& segment, int decimal
 #pragma region Formatting
 
 std::string Line2D::ToWkt(int decimal_precision) const {
-  return std::format("LINE ({} {}, {} {})", round_to(P0.x(), decimal_precision), round_to(P0.y(), decimal_precision),
-                     round_to(P1.x(), decimal_precision), round_to(P1.y(), decimal_precision));
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
 }
 
 Line2D Line2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_p1, end_p2;
-
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "LINE") {
-      throw std::runtime_error("geometry name");
-    }
-
-    end_p1 = wkt.substr(end_gtype + 1).find(',');
-    if (end_p1 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p1 = wkt.substr(end_gtype + 1, end_p1);
-
-    auto nums_p1 = geompp::tokenize_to_doubles(s_nums_p1);
-    if (nums_p1.size() != 2) {
-      throw std::runtime_error("numbers p1");
-    }
-
-    end_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1).find(')');
-    if (end_p2 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1, end_p2);
-
-    auto nums_p2 = geompp::tokenize_to_doubles(s_nums_p2);
-    if (nums_p2.size() != 2) {
-      throw std::runtime_error("numbers p2");
-    }
+  auto line = TryFromWkt(wkt);
+  if (!line) {
+    GEOMPP_PROFILE_COUNT("Line2D::FromWkt failed");
+    std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(line.error())));
+  }
+  return *std::move(line);
+}
 
-    return Make(Point2D{nums_p1[0], nums_p1[1]}, Point2D{nums_p2[0], nums_p2[1]});
+expected<Line2D, GeomError> Line2D::TryFromWkt(std::string_view wkt) {
+  WktReader reader(wkt, false);
+  reader.Tag("LINE");
+  reader.Expect('(');
+  auto p0 = reader.Point();
+  reader.Expect(',');
+  auto p1 = reader.Point();
+  reader.Expect(')');
+  reader.End();
 
-  } catch (...) {
-    std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
   }
 
-  throw std::runtime_error("failed to parse WKT");
+  return TryMake(p0, p1);
 }
 
 void Line2D::ToFile(std::string const& path, int decimal_precision) const {
@@ -207,6 +210,29 @@ Line2D Line2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+std::vector<std::uint8_t> Line2D::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  Point2D points[] = {P0, P1};
+  writer.LineString(points);
+  return writer.Release();
+}
+
+Line2D Line2D::FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  auto points = reader.LineString();
+  reader.End();
+  if (points.size() != 2) {
+    throw std::runtime_error(std::format("a line has 2 points, not {}", points.size()));
+  }
+  return Make(points[0], points[1], decimal_precision);
+}
+
+void Line2D::ToWkbFile(std::string const& path, Endian endian) const { write_wkb_file(path, ToWkb(endian)); }
+
+Line2D Line2D::FromWkbFile(std::string const& path, int decimal_precision) {
+  return FromWkb(read_wkb_file(path), decimal_precision);
+}
+
 #pragma endregion
 
 }  // namespace geompp
@@ -1,9 +1,16 @@
 #include "line_segment2d.hpp"
 
 #include "line2d.hpp"
+#include "predicates.hpp"
 #include "ray2d.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
 #include "utils.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
+#include <algorithm>
 #include <format>
 #include <fstream>
 #include <iostream>  // TODO: replace with logger lib
@@ -14,106 +21,137 @@ namespace geompp {
 
 #pragma region Constructors
 
-LineSegment2D LineSegment2D::Make(Point2D const& p0, Point2D const& p1, int decimal_precision) {
-  if (p0.AlmostEquals(p1, decimal_precision)) {
+template <Scalar T>
+BasicLineSegment2D<T> BasicLineSegment2D<T>::Make(BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1,
+                                                  int decimal_precision) {
+  auto segment = TryMake(p0, p1, decimal_precision);
+  if (!segment) {
+    if (segment.error() == GeomError::BAD_PRECISION) {
+      throw std::runtime_error(
+          std::format("{} decimals precision: {}", decimal_precision, to_string(segment.error())));
+    }
     throw std::runtime_error(std::format("point {} and {} are too close with {} decimals precision",
                                          p0.ToWkt(decimal_precision), p1.ToWkt(decimal_precision), decimal_precision));
   }
-  return {p0, p1};
+  return *std::move(segment);
 }
 
-LineSegment2D::LineSegment2D(Point2D const& p0, Point2D const& p1) : P0(p0), P1(p1) {}
-
-LineSegment2D& LineSegment2D::operator=(LineSegment2D const& other) {
-  if (this != &other) {
-    *this = other;
+template <Scalar T>
+expected<BasicLineSegment2D<T>, GeomError> BasicLineSegment2D<T>::TryMake(BasicPoint2D<T> const& p0,
+                                                                          BasicPoint2D<T> const& p1,
+                                                                          int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("LineSegment2D::Make");
+  if (decimal_precision > MAX_DECIMAL_PRECISION<T>) {
+    return unexpected(GeomError::BAD_PRECISION);
   }
-  return *this;
+  if (p0.AlmostEquals(p1, decimal_precision)) {
+    return unexpected(GeomError::POINTS_TOO_CLOSE);
+  }
+  return BasicLineSegment2D(p0, p1);
 }
 
-double LineSegment2D::Length() const { return (P1 - P0).Length(); }
+template <Scalar T>
+BasicLineSegment2D<T>::BasicLineSegment2D(BasicPoint2D<T> const& p0, BasicPoint2D<T> const& p1) : P0(p0), P1(p1) {}
+
+template <Scalar T>
+double BasicLineSegment2D<T>::Length() const { return (P1 - P0).Length(); }
 
-bool LineSegment2D::AlmostEquals(LineSegment2D const& other, int decimal_precision) const {
+template <Scalar T>
+bool BasicLineSegment2D<T>::AlmostEquals(BasicLineSegment2D const& other, int decimal_precision) const {
   return P0.AlmostEquals(other.P0, decimal_precision) && P1.AlmostEquals(other.P1, decimal_precision);
 }
 
-Line2D LineSegment2D::ToLine(int decimal_precision) const { return Line2D::Make(P0, P1, decimal_precision); }
+template <Scalar T>
+Line2D BasicLineSegment2D<T>::ToLine(int decimal_precision) const {
+  return Line2D::Make(Point2D(P0), Point2D(P1), decimal_precision);
+}
 
-double LineSegment2D::Location(Point2D const& point, int decimal_precision) const {
-  if (!ToLine().Contains(point, decimal_precision)) {
+template <Scalar T>
+double BasicLineSegment2D<T>::Location(BasicPoint2D<T> const& point, int decimal_precision) const {
+  if (!ToLine(decimal_precision).Contains(Point2D(point), decimal_precision)) {
     return std::numeric_limits<double>::infinity();
   }
   return sign((point - P0).Dot(P1 - P0), decimal_precision) * (point - P0).Length() / Length();
 }
 
-Point2D LineSegment2D::Interpolate(double pct) const {
+template <Scalar T>
+BasicPoint2D<T> BasicLineSegment2D<T>::Interpolate(double pct) const {
+  constexpr Tolerance<DP_NINE> tol;
+
   // the point is behind the polyline
-  if (round_to(pct, DP_NINE) < 0.0) {
+  if (tol.IsNegative(pct)) {
     return P0;
   }
 
   // the point is beyond the polyline
-  if (round_to(pct, DP_NINE) > 1.0) {
+  if (tol.IsAbove(pct, 1)) {
     return P1;
   }
 
   return P0 + pct * (P1 - P0);
 }
 
-double LineSegment2D::DistanceTo(Point2D const& point, int decimal_precision) const {
+template <Scalar T>
+double BasicLineSegment2D<T>::DistanceTo(BasicPoint2D<T> const& point, int decimal_precision) const {
   auto line_eqv = ToLine(decimal_precision);
-  auto proj = line_eqv.ProjectOnto(point, decimal_precision);
-  double loc = Location(proj, decimal_precision);
-  if (round_to(loc, decimal_precision) < 0) {
+  auto proj = line_eqv.ProjectOnto(Point2D(point), decimal_precision);
+  double loc = Location(BasicPoint2D<T>(proj), decimal_precision);
+  Tolerance tol(decimal_precision);
+  if (tol.IsNegative(loc)) {
     return P0.DistanceTo(point, decimal_precision);
 
-  } else if (round_to(loc, decimal_precision) > 1) {
+  } else if (tol.IsAbove(loc, 1)) {
     return P1.DistanceTo(point, decimal_precision);
   }
 
-  return line_eqv.DistanceTo(point, decimal_precision);
+  return line_eqv.DistanceTo(Point2D(point), decimal_precision);
 }
 
 #pragma endregion
 
-#pragma region Operator Overloading
-
-bool operator==(LineSegment2D const& lhs, LineSegment2D const& rhs) { return lhs.AlmostEquals(rhs); }
-
-#pragma endregion
-
 #pragma region Geometrical Operations
 
-bool LineSegment2D::Contains(Point2D const& point, int decimal_precision) const {
+template <Scalar T>
+bool BasicLineSegment2D<T>::Contains(BasicPoint2D<T> const& point, int decimal_precision) const {
   double t = Location(point, decimal_precision);
-  return round_to(t, decimal_precision) >= 0 && round_to(t - 1, decimal_precision) <= 0;
+  Tolerance tol(decimal_precision);
+  return tol.IsNonNegative(t) && tol.IsNonPositive(t - 1);
 }
 
-bool LineSegment2D::Intersects(Line2D const& line, int decimal_precision) const {
+template <Scalar T>
+bool BasicLineSegment2D<T>::Intersects(Line2D const& line, int decimal_precision) const {
   return Intersection(line, decimal_precision).has_value();
 }
 
-bool LineSegment2D::Intersects(Ray2D const& ray, int decimal_precision) const {
+template <Scalar T>
+bool BasicLineSegment2D<T>::Intersects(Ray2D const& ray, int decimal_precision) const {
   return Intersection(ray, decimal_precision).has_value();
 }
 
-bool LineSegment2D::Intersects(LineSegment2D const& other, int decimal_precision) const {
+template <Scalar T>
+bool BasicLineSegment2D<T>::Intersects(BasicLineSegment2D const& other, int decimal_precision) const {
   return Intersection(other, decimal_precision).has_value();
 }
 
-LineSegment2D::ReturnSet LineSegment2D::Intersection(Line2D const& line, int decimal_precision) const {
-  auto u = P1 - P0;
+template <Scalar T>
+typename BasicLineSegment2D<T>::ReturnSet BasicLineSegment2D<T>::Intersection(Line2D const& line,
+                                                                              int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("LineSegment2D::Intersection");
+  Tolerance tol(decimal_precision);
+  Point2D p0(P0), p1(P1);
+  auto u = p1 - p0;
   auto v = line.Direction();
   auto vp = v.Perp();
-  auto w = (P0 - line.First());
+  auto w = (p0 - line.First());
 
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (tol.IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("LineSegment2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
 
   // verify that the intersection is ahead of the ray
-  auto inter_p = P0 + t * u;
+  auto inter_p = BasicPoint2D<T>(p0 + t * u);
   if (!Contains(inter_p, decimal_precision)) {
     return std::nullopt;
   }
@@ -121,25 +159,31 @@ LineSegment2D::ReturnSet LineSegment2D::Intersection(Line2D const& line, int dec
   return inter_p;
 }
 
-LineSegment2D::ReturnSet LineSegment2D::Intersection(Ray2D const& ray, int decimal_precision) const {
-  auto u = P1 - P0;
+template <Scalar T>
+typename BasicLineSegment2D<T>::ReturnSet BasicLineSegment2D<T>::Intersection(Ray2D const& ray,
+                                                                              int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("LineSegment2D::Intersection");
+  Tolerance tol(decimal_precision);
+  Point2D p0(P0), p1(P1);
+  auto u = p1 - p0;
   auto up = u.Perp();  // equivalent (calc, on the other side)
   auto v = ray.Direction();
   auto vp = v.Perp();
-  auto w = (P0 - ray.Origin());
+  auto w = (p0 - ray.Origin());
 
   // testing on this ray
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (tol.IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("LineSegment2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
-  auto inter_t = P0 + t * u;
+  auto inter_t = BasicPoint2D<T>(p0 + t * u);
   if (!Contains(inter_t, decimal_precision)) {
     return std::nullopt;
   }
 
   // testing on the other ray
-  if (round_to(v * up, decimal_precision) == 0.0) {
+  if (tol.IsZero(v * up)) {
     return std::nullopt;
   }
   double s = (w * up) / (v * up);  // equivalent (calc on the other side)
@@ -151,29 +195,35 @@ LineSegment2D::ReturnSet LineSegment2D::Intersection(Ray2D const& ray, int decim
   return inter_t;
 }
 
-LineSegment2D::ReturnSet LineSegment2D::Intersection(LineSegment2D const& other, int decimal_precision) const {
-  auto u = P1 - P0;
+template <Scalar T>
+typename BasicLineSegment2D<T>::ReturnSet BasicLineSegment2D<T>::Intersection(BasicLineSegment2D const& other,
+                                                                              int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("LineSegment2D::Intersection");
+  Tolerance tol(decimal_precision);
+  Point2D p0(P0), p1(P1), q0(other.P0), q1(other.P1);
+  auto u = p1 - p0;
   auto up = u.Perp();  // equivalent (calc, on the other side)
-  auto v = (other.P1 - other.P0);
+  auto v = (q1 - q0);
   auto vp = v.Perp();
-  auto w = (P0 - other.P0);
+  auto w = (p0 - q0);
 
   // testing on this ray
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (tol.IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("LineSegment2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
-  auto inter_t = P0 + t * u;
+  auto inter_t = BasicPoint2D<T>(p0 + t * u);
   if (!Contains(inter_t, decimal_precision)) {
     return std::nullopt;
   }
 
   // testing on the other ray
-  if (round_to(v * up, decimal_precision) == 0.0) {
+  if (tol.IsZero(v * up)) {
     return std::nullopt;
   }
   double s = (w * up) / (v * up);  // equivalent (calc on the other side)
-  auto inter_s = other.P0 + s * v;
+  auto inter_s = BasicPoint2D<T>(q0 + s * v);
   if (!other.Contains(inter_s, decimal_precision)) {
     return std::nullopt;
   }
@@ -181,62 +231,72 @@ LineSegment2D::ReturnSet LineSegment2D::Intersection(LineSegment2D const& other,
   return inter_t;
 }
 
-#pragma endregion
-
-#pragma region Formatting
-
-std::string LineSegment2D::ToWkt(int decimal_precision) const {
-  return std::format("LINESTRING ({} {}, {} {})", round_to(P0.x(), decimal_precision),
-                     round_to(P0.y(), decimal_precision), round_to(P1.x(), decimal_precision),
-                     round_to(P1.y(), decimal_precision));
+template <Scalar T>
+bool BasicLineSegment2D<T>::Intersects(BasicLineSegment2D const& other, ExactPredicates) const {
+  return Intersection(other, EXACT).has_value();
 }
 
-LineSegment2D LineSegment2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_p1, end_p2;
-
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
+template <Scalar T>
+typename BasicLineSegment2D<T>::ReturnSet BasicLineSegment2D<T>::Intersection(BasicLineSegment2D const& other,
+                                                                              ExactPredicates) const {
+  GEOMPP_PROFILE_SCOPE("LineSegment2D::Intersection(EXACT)");
+  Point2D p0(P0), p1(P1), q0(other.P0), q1(other.P1);
+  if (!segments_intersect(p0, p1, q0, q1)) {
+    return std::nullopt;
+  }
+  if (orientation(p0, p1, q0) == 0 && orientation(p0, p1, q1) == 0) {
+    return std::nullopt;  // collinear
+  }
 
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "LINESTRING") {
-      throw std::runtime_error("geometry name");
-    }
+  auto u = p1 - p0;
+  auto v = q1 - q0;
+  double t = std::clamp((q0 - p0).Cross(v) / u.Cross(v), 0.0, 1.0);
 
-    end_p1 = wkt.substr(end_gtype + 1).find(',');
-    if (end_p1 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p1 = wkt.substr(end_gtype + 1, end_p1);
-
-    auto nums_p1 = geompp::tokenize_to_doubles(s_nums_p1);
-    if (nums_p1.size() != 2) {
-      throw std::runtime_error("numbers p1");
-    }
+  return BasicPoint2D<T>(p0 + t * u);
+}
 
-    end_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1).find(')');
-    if (end_p2 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1, end_p2);
+#pragma endregion
 
-    auto nums_p2 = geompp::tokenize_to_doubles(s_nums_p2);
-    if (nums_p2.size() != 2) {
-      throw std::runtime_error("numbers p2");
-    }
+#pragma region Formatting
 
-    return Make({nums_p1[0], nums_p1[1]}, {nums_p2[0], nums_p2[1]});
+template <Scalar T>
+std::string BasicLineSegment2D<T>::ToWkt(int decimal_precision) const {
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
+}
 
-  } catch (...) {
+template <Scalar T>
+BasicLineSegment2D<T> BasicLineSegment2D<T>::FromWkt(std::string const& wkt) {
+  auto segment = TryFromWkt(wkt);
+  if (!segment) {
+    GEOMPP_PROFILE_COUNT("LineSegment2D::FromWkt failed");
     std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(segment.error())));
   }
+  return *std::move(segment);
+}
 
-  throw std::runtime_error("failed to parse WKT");
+template <Scalar T>
+expected<BasicLineSegment2D<T>, GeomError> BasicLineSegment2D<T>::TryFromWkt(std::string_view wkt) {
+  WktReader reader(wkt, false);
+  reader.Tag("LINESTRING");
+  reader.Expect('(');
+  auto p0 = reader.Point();
+  reader.Expect(',');
+  auto p1 = reader.Point();
+  reader.Expect(')');
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  return TryMake(BasicPoint2D<T>(p0), BasicPoint2D<T>(p1));
 }
 
-void LineSegment2D::ToFile(std::string const& path, int decimal_precision) const {
+template <Scalar T>
+void BasicLineSegment2D<T>::ToFile(std::string const& path, int decimal_precision) const {
   try {
     std::string content = ToWkt(decimal_precision);
 
@@ -257,7 +317,8 @@ void LineSegment2D::ToFile(std::string const& path, int decimal_precision) const
   }
 }
 
-LineSegment2D LineSegment2D::FromFile(std::string const& path) {
+template <Scalar T>
+BasicLineSegment2D<T> BasicLineSegment2D<T>::FromFile(std::string const& path) {
   try {
     std::string content;
 
@@ -288,6 +349,38 @@ LineSegment2D LineSegment2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+template <Scalar T>
+std::vector<std::uint8_t> BasicLineSegment2D<T>::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  Point2D points[] = {Point2D(P0), Point2D(P1)};
+  writer.LineString(points);
+  return writer.Release();
+}
+
+template <Scalar T>
+BasicLineSegment2D<T> BasicLineSegment2D<T>::FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  auto points = reader.LineString();
+  reader.End();
+  if (points.size() != 2) {
+    throw std::runtime_error(std::format("a segment has 2 points, not {}", points.size()));
+  }
+  return Make(BasicPoint2D<T>(points[0]), BasicPoint2D<T>(points[1]), decimal_precision);
+}
+
+template <Scalar T>
+void BasicLineSegment2D<T>::ToWkbFile(std::string const& path, Endian endian) const {
+  write_wkb_file(path, ToWkb(endian));
+}
+
+template <Scalar T>
+BasicLineSegment2D<T> BasicLineSegment2D<T>::FromWkbFile(std::string const& path, int decimal_precision) {
+  return FromWkb(read_wkb_file(path), decimal_precision);
+}
+
 #pragma endregion
 
+template class BasicLineSegment2D<double>;
+template class BasicLineSegment2D<float>;
+
 }  // namespace geompp
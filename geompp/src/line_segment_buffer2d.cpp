@@ -0,0 +1,177 @@
+#include "line_segment_buffer2d.hpp"
+
+#include "simd.hpp"
+#include "tolerance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace geompp {
+
+LineSegmentBuffer2D LineSegmentBuffer2D::Make(std::vector<LineSegment2D> const& segments) {
+  LineSegmentBuffer2D buffer;
+  buffer.Reserve(segments.size());
+  for (auto const& segment : segments) {
+    buffer.PushBack(segment);
+  }
+  return buffer;
+}
+
+std::vector<LineSegment2D> LineSegmentBuffer2D::ToSegments() const {
+  std::vector<LineSegment2D> segments;
+  segments.reserve(X0.size());
+  for (int i = 0; i < X0.size(); ++i) {
+    segments.push_back(At(i));
+  }
+  return segments;
+}
+
+LineSegment2D LineSegmentBuffer2D::At(int i) const { return {{X0[i], Y0[i]}, {X1[i], Y1[i]}}; }
+
+void LineSegmentBuffer2D::Reserve(int size) {
+  X0.reserve(size);
+  Y0.reserve(size);
+  X1.reserve(size);
+  Y1.reserve(size);
+}
+
+void LineSegmentBuffer2D::PushBack(LineSegment2D const& segment) {
+  X0.push_back(segment.First().x());
+  Y0.push_back(segment.First().y());
+  X1.push_back(segment.Last().x());
+  Y1.push_back(segment.Last().y());
+}
+
+#pragma region Batch Operations
+
+LineSegmentBuffer2D::Intersections LineSegmentBuffer2D::Intersection(LineSegment2D const& segment,
+                                                                     int decimal_precision) const {
+  Intersections result{std::vector<std::uint8_t>(X0.size()), std::vector<double>(X0.size()),
+                       std::vector<double>(X0.size())};
+  Intersection(segment, result.hits, result.t, result.s, decimal_precision);
+  return result;
+}
+
+std::vector<std::uint8_t> LineSegmentBuffer2D::Intersects(LineSegment2D const& segment, int decimal_precision) const {
+  return Intersection(segment, decimal_precision).hits;
+}
+
+// With u = segment, v = other, w = segment.First() - other.First() and d = v.Cross(u) (zero when parallel):
+//    t = w.Cross(v) / d, s = w.Cross(u) / d
+// The segment intersects the other when d is not zero at the precision and the intersection is in both, as Contains
+// finds it: its Location on the segment is |t|, negative only when the sign of t * |u|^2 (the dot product Location
+// takes) rounds below zero, and it must be within [0, 1] at the precision; the same on the other with s and |v|^2.
+void LineSegmentBuffer2D::Intersection(LineSegment2D const& segment, std::span<std::uint8_t> hits,
+                                       std::span<double> t, std::span<double> s, int decimal_precision) const {
+  int n = Size();
+  if (hits.size() < n || t.size() < n || s.size() < n) {
+    throw std::runtime_error("output smaller than the buffer");
+  }
+
+  Tolerance tol(decimal_precision);
+  double qx = segment.First().x(), qy = segment.First().y();
+  double ux = segment.Last().x() - qx, uy = segment.Last().y() - qy;
+  double uu = ux * ux + uy * uy;
+  double const *x0 = X0.data(), *y0 = Y0.data(), *x1 = X1.data(), *y1 = Y1.data();
+  int i = 0;
+
+#if defined(GEOMPP_SIMD_AVX2)
+  __m256d vqx = _mm256_set1_pd(qx), vqy = _mm256_set1_pd(qy);
+  __m256d vux = _mm256_set1_pd(ux), vuy = _mm256_set1_pd(uy), vuu = _mm256_set1_pd(uu);
+  __m256d scale = _mm256_set1_pd(tol.Scale()), half = _mm256_set1_pd(0.5), mhalf = _mm256_set1_pd(-0.5);
+  __m256d one = _mm256_set1_pd(1.0), sign = _mm256_set1_pd(-0.0);
+  for (; i + 4 <= n; i += 4) {
+    __m256d ox = _mm256_loadu_pd(x0 + i), oy = _mm256_loadu_pd(y0 + i);
+    __m256d vx = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), ox), vy = _mm256_sub_pd(_mm256_loadu_pd(y1 + i), oy);
+    __m256d wx = _mm256_sub_pd(vqx, ox), wy = _mm256_sub_pd(vqy, oy);
+
+    __m256d d = _mm256_sub_pd(_mm256_mul_pd(vuy, vx), _mm256_mul_pd(vux, vy));  // v.Cross(u)
+    __m256d ti = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(wx, vy), _mm256_mul_pd(wy, vx)), d);
+    __m256d si = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(wx, vuy), _mm256_mul_pd(wy, vux)), d);
+
+    __m256d vv = _mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy));
+
+    // the locations: |t| (|s|), with the sign bit set where t * |u|^2 (s * |v|^2) is not non negative
+    __m256d tl = _mm256_or_pd(_mm256_andnot_pd(sign, ti),
+                              _mm256_andnot_pd(_mm256_cmp_pd(_mm256_mul_pd(_mm256_mul_pd(ti, vuu), scale), mhalf,
+                                                             _CMP_GT_OQ),
+                                               sign));
+    __m256d sl = _mm256_or_pd(_mm256_andnot_pd(sign, si),
+                              _mm256_andnot_pd(_mm256_cmp_pd(_mm256_mul_pd(_mm256_mul_pd(si, vv), scale), mhalf,
+                                                             _CMP_GT_OQ),
+                                               sign));
+    __m256d not_parallel = _mm256_cmp_pd(_mm256_andnot_pd(sign, _mm256_mul_pd(d, scale)), half, _CMP_GE_OQ);
+    __m256d t_in = _mm256_and_pd(_mm256_cmp_pd(_mm256_mul_pd(tl, scale), mhalf, _CMP_GT_OQ),
+                                 _mm256_cmp_pd(_mm256_mul_pd(_mm256_sub_pd(tl, one), scale), half, _CMP_LT_OQ));
+    __m256d s_in = _mm256_and_pd(_mm256_cmp_pd(_mm256_mul_pd(sl, scale), mhalf, _CMP_GT_OQ),
+                                 _mm256_cmp_pd(_mm256_mul_pd(_mm256_sub_pd(sl, one), scale), half, _CMP_LT_OQ));
+    int mask = _mm256_movemask_pd(_mm256_and_pd(not_parallel, _mm256_and_pd(t_in, s_in)));
+
+    _mm256_storeu_pd(t.data() + i, ti);
+    _mm256_storeu_pd(s.data() + i, si);
+    for (int k = 0; k < 4; ++k) {
+      hits[i + k] = (mask >> k) & 1;
+    }
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  __m128d vqx = _mm_set1_pd(qx), vqy = _mm_set1_pd(qy);
+  __m128d vux = _mm_set1_pd(ux), vuy = _mm_set1_pd(uy), vuu = _mm_set1_pd(uu);
+  __m128d scale = _mm_set1_pd(tol.Scale()), half = _mm_set1_pd(0.5), mhalf = _mm_set1_pd(-0.5);
+  __m128d one = _mm_set1_pd(1.0), sign = _mm_set1_pd(-0.0);
+  for (; i + 2 <= n; i += 2) {
+    __m128d ox = _mm_loadu_pd(x0 + i), oy = _mm_loadu_pd(y0 + i);
+    __m128d vx = _mm_sub_pd(_mm_loadu_pd(x1 + i), ox), vy = _mm_sub_pd(_mm_loadu_pd(y1 + i), oy);
+    __m128d wx = _mm_sub_pd(vqx, ox), wy = _mm_sub_pd(vqy, oy);
+
+    __m128d d = _mm_sub_pd(_mm_mul_pd(vuy, vx), _mm_mul_pd(vux, vy));  // v.Cross(u)
+    __m128d ti = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(wx, vy), _mm_mul_pd(wy, vx)), d);
+    __m128d si = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(wx, vuy), _mm_mul_pd(wy, vux)), d);
+
+    __m128d vv = _mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy));
+
+    // the locations: |t| (|s|), with the sign bit set where t * |u|^2 (s * |v|^2) is not non negative
+    __m128d tl = _mm_or_pd(_mm_andnot_pd(sign, ti),
+                           _mm_andnot_pd(_mm_cmpgt_pd(_mm_mul_pd(_mm_mul_pd(ti, vuu), scale), mhalf), sign));
+    __m128d sl = _mm_or_pd(_mm_andnot_pd(sign, si),
+                           _mm_andnot_pd(_mm_cmpgt_pd(_mm_mul_pd(_mm_mul_pd(si, vv), scale), mhalf), sign));
+    __m128d not_parallel = _mm_cmpge_pd(_mm_andnot_pd(sign, _mm_mul_pd(d, scale)), half);
+    __m128d t_in = _mm_and_pd(_mm_cmpgt_pd(_mm_mul_pd(tl, scale), mhalf),
+                              _mm_cmplt_pd(_mm_mul_pd(_mm_sub_pd(tl, one), scale), half));
+    __m128d s_in = _mm_and_pd(_mm_cmpgt_pd(_mm_mul_pd(sl, scale), mhalf),
+                              _mm_cmplt_pd(_mm_mul_pd(_mm_sub_pd(sl, one), scale), half));
+    int mask = _mm_movemask_pd(_mm_and_pd(not_parallel, _mm_and_pd(t_in, s_in)));
+
+    _mm_storeu_pd(t.data() + i, ti);
+    _mm_storeu_pd(s.data() + i, si);
+    hits[i] = mask & 1;
+    hits[i + 1] = (mask >> 1) & 1;
+  }
+#endif
+
+  // the location of the point of parameter p on a segment of that squared length, and whether it is in the segment
+  auto within = [&tol](double p, double squared_length) {
+    double location = tol.Sign(p * squared_length) * std::abs(p);
+    return tol.IsNonNegative(location) && tol.IsNonPositive(location - 1);
+  };
+  for (; i < n; ++i) {
+    double vx = x1[i] - x0[i], vy = y1[i] - y0[i];
+    double wx = qx - x0[i], wy = qy - y0[i];
+    double d = uy * vx - ux * vy;  // v.Cross(u)
+    t[i] = (wx * vy - wy * vx) / d;
+    s[i] = (wx * uy - wy * ux) / d;
+    hits[i] = !tol.IsZero(d) && within(t[i], uu) && within(s[i], vx * vx + vy * vy);
+  }
+}
+
+BoundingBox2D LineSegmentBuffer2D::BoundingBox() const {
+  auto bbox = BoundingBox2D::Empty();
+  for (int i = 0; i < X0.size(); ++i) {
+    bbox = bbox.Union(Point2D(X0[i], Y0[i])).Union(Point2D(X1[i], Y1[i]));
+  }
+  return bbox;
+}
+
+#pragma endregion
+
+}  // namespace geompp
@@ -1,72 +1,170 @@
 #include "point2d.hpp"
 
+#include "stats.hpp"
+#include "tolerance.hpp"
 #include "utils.hpp"
 #include "vector2d.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <format>
 #include <fstream>
 #include <iostream>  // TODO: replace with logger lib
+#include <limits>
 #include <unordered_set>
 
 namespace geompp {
 
-Point2D::Point2D(double x, double y) : X(x), Y(y) {}
+namespace {
+
+// Uniform grid of cells of side 10^-dp, where two points equal at the precision (|dx * 10^dp| < 0.5) are in the same
+// cell, or in adjacent ones. Each cell keeps a list of the points in it: its head is in an open addressing table,
+// then the list goes on through NEXT.
+class PointGrid {
+ public:
+  PointGrid(double scale, int size) : SCALE(scale), MASK(std::bit_ceil(2 * static_cast<std::size_t>(size)) - 1) {
+    XS.resize(MASK + 1);
+    YS.resize(MASK + 1);
+    HEADS.resize(MASK + 1, -1);
+    NEXT.reserve(size);
+  }
 
-Point2D::Point2D(Point2D const& p) : X(p.X), Y(p.Y) {}
+  // calls fn(k) on the points k in the cell of the point and in the adjacent cells where its duplicates can be,
+  // until it returns true
+  template <typename Point, typename Fn>
+  bool Any(Point const& point, Fn&& fn) const {
+    double x = point.x() * SCALE, y = point.y() * SCALE;
+    double cx = std::floor(x), cy = std::floor(y);
+    // the duplicates are within half a cell: in the adjacent cell on the side of the nearest border along each axis
+    // (both sides when the point is too close to the middle to tell, with the rounding of x * SCALE)
+    double slack = 1e-9 + 4 * std::numeric_limits<double>::epsilon() * std::max(std::abs(x), std::abs(y));
+    auto sides = [slack](double f, double (&offsets)[3]) {
+      int n = 1;
+      offsets[0] = 0;
+      if (f < 0.5 + slack) {
+        offsets[n++] = -1;
+      }
+      if (f > 0.5 - slack) {
+        offsets[n++] = 1;
+      }
+      return n;
+    };
+    double ox[3], oy[3];
+    int nx = sides(x - cx, ox), ny = sides(y - cy, oy);
+
+    for (int i = 0; i < nx; ++i) {
+      for (int j = 0; j < ny; ++j) {
+        for (int k = HEADS[Find(cx + ox[i], cy + oy[j])]; k >= 0; k = NEXT[k]) {
+          if (fn(k)) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
 
-bool Point2D::AlmostEquals(Point2D const& other, int decimal_precision) const {
-  return round_to(X - other.X, decimal_precision) == 0.0 && round_to(Y - other.Y, decimal_precision) == 0.0;
-}
+  // adds the next point, number k = the number of points added before
+  template <typename Point>
+  void Add(Point const& point) {
+    double cx = std::floor(point.x() * SCALE) + 0.0, cy = std::floor(point.y() * SCALE) + 0.0;
+    std::size_t slot = Find(cx, cy);
+    XS[slot] = cx;
+    YS[slot] = cy;
+    NEXT.push_back(HEADS[slot]);
+    HEADS[slot] = NEXT.size() - 1;
+  }
 
-Vector2D Point2D::ToVector() { return {X, Y}; }
+ private:
+  double SCALE;
+  std::size_t MASK;
+  std::vector<double> XS, YS;  // cell of each slot
+  std::vector<int> HEADS;      // -1 for the empty slots
+  std::vector<int> NEXT;
+
+  // slot of the cell, or the empty slot where it goes (-0 is the same cell as 0)
+  std::size_t Find(double cx, double cy) const {
+    cx += 0.0;
+    cy += 0.0;
+    std::uint64_t h = std::bit_cast<std::uint64_t>(cx) * 0x9e3779b97f4a7c15ULL ^
+                      std::bit_cast<std::uint64_t>(cy) * 0xc2b2ae3d27d4eb4fULL;
+    std::size_t slot = (h ^ (h >> 32)) & MASK;
+    while (HEADS[slot] >= 0 && (XS[slot] != cx || YS[slot] != cy)) {
+      slot = (slot + 1) & MASK;
+    }
+    return slot;
+  }
+};
 
-double Point2D::DistanceTo(Point2D const& other, int decimal_precision) const {
-  return round_to((other - *this).Length(), decimal_precision);
+}  // namespace
+
+template <Scalar T>
+bool BasicPoint2D<T>::AlmostEquals(BasicPoint2D const& other, int decimal_precision) const {
+  Tolerance tol(decimal_precision);
+  return tol.IsZero(X - other.X) && tol.IsZero(Y - other.Y);
 }
 
-Point2D& Point2D::operator=(Point2D const& other) {
-  if (this != &other) {
-    *this = other;
-  }
-  return *this;
+template <Scalar T>
+double BasicPoint2D<T>::DistanceTo(BasicPoint2D const& other, int decimal_precision) const {
+  return round_to((other - *this).Length(), decimal_precision);
 }
 
 #pragma region Collection Operations
 
-std::vector<Point2D> Point2D::remove_duplicates(std::vector<Point2D> const& points, int decimal_precision) {
+template <Scalar T>
+std::vector<BasicPoint2D<T>> BasicPoint2D<T>::remove_duplicates(std::vector<BasicPoint2D> const& points,
+                                                                int decimal_precision, Duplicates mode) {
+  GEOMPP_PROFILE_SCOPE("Point2D::remove_duplicates");
   if (points.size() == 0) {
     return points;
   }
 
-  std::unordered_set<int> duplicates;
-  for (int i = 0; i < points.size() - 1; ++i) {
-    if (duplicates.count(i)) {
-      continue;
-    }
-    for (int j = i + 1; j < points.size(); ++j) {
-      if (!points[i].AlmostEquals(points[j], decimal_precision)) {
-        break;
+  return with_tolerance(decimal_precision, [&points, mode](auto tol) {
+    auto equals = [&tol](BasicPoint2D const& a, BasicPoint2D const& b) {
+      return tol.AlmostEquals(a.x(), b.x()) && tol.AlmostEquals(a.y(), b.y());
+    };
+
+    std::vector<BasicPoint2D> unique_points;
+    unique_points.reserve(points.size());
+
+    if (mode == Duplicates::CONSECUTIVE) {
+      // a point is a duplicate of the first one of its run
+      int first = 0;
+      unique_points.push_back(points[0]);
+      for (int i = 1; i < points.size(); ++i) {
+        if (!equals(points[first], points[i])) {
+          unique_points.push_back(points[i]);
+          first = i;
+        }
       }
-      duplicates.insert(j);
+      return unique_points;
     }
-  }
 
-  std::vector<Point2D> unique_points;
-  for (int i = 0; i < points.size(); ++i) {
-    if (duplicates.count(i) == 0) {
-      unique_points.push_back(points[i]);
+    PointGrid grid(tol.Scale(), points.size());
+    for (auto const& point : points) {
+      if (!grid.Any(point, [&unique_points, &point, &equals](int k) { return equals(unique_points[k], point); })) {
+        grid.Add(point);
+        unique_points.push_back(point);
+      }
     }
-  }
 
-  return unique_points;
+    return unique_points;
+  });
 }
 
-std::vector<Point2D> Point2D::remove_collinear(std::vector<Point2D> const& points, int decimal_precision) {
+template <Scalar T>
+std::vector<BasicPoint2D<T>> BasicPoint2D<T>::remove_collinear(std::vector<BasicPoint2D> const& points,
+                                                               int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Point2D::remove_collinear");
   if (points.size() < 3) {
     return points;
   }
 
+  Tolerance tol(decimal_precision);
   std::unordered_set<int> duplicates;
   int i1 = 0;
   int i2 = i1 + 1;
@@ -83,10 +181,9 @@ std::vector<Point2D> Point2D::remove_collinear(std::vector<Point2D> const& point
     auto u = (points[i2] - points[i1]);
     auto v = (points[i3] - points[i1]);
 
-    if (round_to(u.Perp().Dot(v), decimal_precision) == 0) {  // test of collinearity
-      if (round_to(u.Dot(v), decimal_precision) >=
-          0) {  // same direction, pick the farthest point in the U-vector's direction
-        if (round_to(points[i1].DistanceTo(points[i3]) - points[i1].DistanceTo(points[i2]), decimal_precision) >= 0) {
+    if (tol.IsZero(u.Perp().Dot(v))) {  // test of collinearity
+      if (tol.IsNonNegative(u.Dot(v))) {  // same direction, pick the farthest point in the U-vector's direction
+        if (tol.IsNonNegative(points[i1].DistanceTo(points[i3]) - points[i1].DistanceTo(points[i2]))) {
           duplicates.insert(i2);
           ++i2;
           ++i3;
@@ -110,7 +207,7 @@ std::vector<Point2D> Point2D::remove_collinear(std::vector<Point2D> const& point
     --max_iter;
   }
 
-  std::vector<Point2D> unique_points;
+  std::vector<BasicPoint2D> unique_points;
   for (int i = 0; i < points.size(); ++i) {
     if (duplicates.count(i) == 0) {
       unique_points.push_back(points[i]);
@@ -120,63 +217,84 @@ std::vector<Point2D> Point2D::remove_collinear(std::vector<Point2D> const& point
   return unique_points;
 }
 
-#pragma endregion
-
-#pragma region Operator Overloading
-
-bool operator==(Point2D const& lhs, Point2D const& rhs) { return lhs.AlmostEquals(rhs); }
-
-Point2D operator+(Point2D const& lhs, Vector2D const& rhs) { return {lhs.x() + rhs.x(), lhs.y() + rhs.y()}; }
-
-Vector2D operator-(Point2D const& lhs, Point2D const& rhs) { return {lhs.x() - rhs.x(), lhs.y() - rhs.y()}; }
-Point2D operator-(Point2D const& lhs, Vector2D const& rhs) { return {lhs.x() - rhs.x(), lhs.y() - rhs.y()}; }
+template <Scalar T>
+void BasicPoint2D<T>::remove_duplicates_and_collinear(std::vector<BasicPoint2D>& points, int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Point2D::remove_duplicates_and_collinear");
+  with_tolerance(decimal_precision, [&points](auto tol) {
+    int kept = 0;  // points[0, kept) are the points kept so far
+    for (int i = 0; i < points.size(); ++i) {
+      auto const point = points[i];
+      bool keep = true;
+      while (kept > 0) {
+        auto const& last = points[kept - 1];
+        if (tol.AlmostEquals(last.x(), point.x()) && tol.AlmostEquals(last.y(), point.y())) {  // duplicate
+          keep = false;
+          break;
+        }
+        if (kept < 2) {
+          break;
+        }
 
-Point2D operator*(Point2D const& lhs, double a) { return {lhs.x() * a, lhs.y() * a}; }
-Point2D operator*(double a, Point2D const& rhs) { return rhs * a; }
+        auto u = last - points[kept - 2];
+        auto v = point - points[kept - 2];
+        if (!tol.IsZero(u.Perp().Dot(v))) {  // test of collinearity
+          break;
+        }
+        if (tol.IsNonNegative(u.Dot(v)) && tol.IsNonNegative(v.Length() - u.Length())) {
+          --kept;  // the last point is between the one before and this one, check this one against those before
+        } else {
+          keep = false;  // this point goes back over the last segment
+          break;
+        }
+      }
+      if (keep) {
+        points[kept++] = point;
+      }
+    }
+    points.resize(kept);
+  });
+}
 
 #pragma endregion
 
 #pragma region Formatting
 
-std::string Point2D::ToWkt(int decimal_precision) const {
-  return std::format("POINT ({} {})", round_to(X, decimal_precision), round_to(Y, decimal_precision));
+template <Scalar T>
+std::string BasicPoint2D<T>::ToWkt(int decimal_precision) const {
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
 }
 
-Point2D Point2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_nums;
-
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "POINT") {
-      throw std::runtime_error("geometry name");
-    }
-
-    end_nums = wkt.substr(end_gtype + 1).find(')');
-    if (end_nums == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums = wkt.substr(end_gtype + 1, end_nums);
-
-    auto nums = geompp::tokenize_to_doubles(s_nums);
-    if (nums.size() != 2) {
-      throw std::runtime_error("numbers");
-    }
-
-    return {nums[0], nums[1]};
-
-  } catch (...) {
+template <Scalar T>
+BasicPoint2D<T> BasicPoint2D<T>::FromWkt(std::string const& wkt) {
+  auto point = TryFromWkt(wkt);
+  if (!point) {
+    GEOMPP_PROFILE_COUNT("Point2D::FromWkt failed");
     std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(point.error())));
   }
+  return *std::move(point);
+}
 
-  throw std::runtime_error("failed to parse WKT");
+template <Scalar T>
+expected<BasicPoint2D<T>, GeomError> BasicPoint2D<T>::TryFromWkt(std::string_view wkt) {
+  WktReader reader(wkt, false);
+  reader.Tag("POINT");
+  reader.Expect('(');
+  auto point = reader.Point();
+  reader.Expect(')');
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  return BasicPoint2D(point);
 }
 
-void Point2D::ToFile(std::string const& path, int decimal_precision) const {
+template <Scalar T>
+void BasicPoint2D<T>::ToFile(std::string const& path, int decimal_precision) const {
   try {
     std::string content = ToWkt(decimal_precision);
 
@@ -197,7 +315,8 @@ void Point2D::ToFile(std::string const& path, int decimal_precision) const {
   }
 }
 
-Point2D Point2D::FromFile(std::string const& path) {
+template <Scalar T>
+BasicPoint2D<T> BasicPoint2D<T>::FromFile(std::string const& path) {
   try {
     std::string content;
 
@@ -228,6 +347,30 @@ Point2D Point2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+template <Scalar T>
+std::vector<std::uint8_t> BasicPoint2D<T>::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  writer.Point(Point2D(*this));
+  return writer.Release();
+}
+
+template <Scalar T>
+BasicPoint2D<T> BasicPoint2D<T>::FromWkb(std::span<std::uint8_t const> wkb) {
+  WkbReader reader(wkb);
+  auto point = reader.Point();
+  reader.End();
+  return BasicPoint2D(point);
+}
+
+template <Scalar T>
+void BasicPoint2D<T>::ToWkbFile(std::string const& path, Endian endian) const { write_wkb_file(path, ToWkb(endian)); }
+
+template <Scalar T>
+BasicPoint2D<T> BasicPoint2D<T>::FromWkbFile(std::string const& path) { return FromWkb(read_wkb_file(path)); }
+
 #pragma endregion
 
+template class BasicPoint2D<double>;
+template class BasicPoint2D<float>;
+
 }  // namespace geompp
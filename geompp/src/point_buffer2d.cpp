@@ -0,0 +1,248 @@
+#include "point_buffer2d.hpp"
+
+#include "simd.hpp"
+#include "tolerance.hpp"
+#include "vector2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace geompp {
+
+namespace {
+
+template <typename T>
+void check_out_size(std::span<T> out, int size) {
+  if (out.size() < size) {
+    throw std::runtime_error("output smaller than the buffer");
+  }
+}
+
+}  // namespace
+
+PointBuffer2D PointBuffer2D::Make(std::vector<Point2D> const& points) {
+  PointBuffer2D buffer;
+  buffer.XS.resize(points.size());
+  buffer.YS.resize(points.size());
+  for (int i = 0; i < points.size(); ++i) {
+    buffer.XS[i] = points[i].x();
+    buffer.YS[i] = points[i].y();
+  }
+  return buffer;
+}
+
+std::vector<Point2D> PointBuffer2D::ToPoints() const {
+  std::vector<Point2D> points;
+  points.reserve(XS.size());
+  for (int i = 0; i < XS.size(); ++i) {
+    points.emplace_back(XS[i], YS[i]);
+  }
+  return points;
+}
+
+void PointBuffer2D::Reserve(int size) {
+  XS.reserve(size);
+  YS.reserve(size);
+}
+
+void PointBuffer2D::PushBack(Point2D const& point) {
+  XS.push_back(point.x());
+  YS.push_back(point.y());
+}
+
+#pragma region Batch Operations
+
+std::vector<double> PointBuffer2D::DistancesTo(Point2D const& point) const {
+  std::vector<double> out(XS.size());
+  DistancesTo(point, out);
+  return out;
+}
+
+void PointBuffer2D::DistancesTo(Point2D const& point, std::span<double> out) const {
+  int n = Size();
+  check_out_size(out, n);
+  double const* xs = XS.data();
+  double const* ys = YS.data();
+  int i = 0;
+#if defined(GEOMPP_SIMD_AVX2)
+  __m256d px = _mm256_set1_pd(point.x()), py = _mm256_set1_pd(point.y());
+  for (; i + 4 <= n; i += 4) {
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+    _mm256_storeu_pd(out.data() + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  __m128d px = _mm_set1_pd(point.x()), py = _mm_set1_pd(point.y());
+  for (; i + 2 <= n; i += 2) {
+    __m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+    __m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+    _mm_storeu_pd(out.data() + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+  }
+#endif
+  for (; i < n; ++i) {
+    double dx = xs[i] - point.x();
+    double dy = ys[i] - point.y();
+    out[i] = std::sqrt(dx * dx + dy * dy);
+  }
+}
+
+std::vector<std::uint8_t> PointBuffer2D::AlmostEquals(Point2D const& point, int decimal_precision) const {
+  std::vector<std::uint8_t> out(XS.size());
+  AlmostEquals(point, out, decimal_precision);
+  return out;
+}
+
+void PointBuffer2D::AlmostEquals(Point2D const& point, std::span<std::uint8_t> out, int decimal_precision) const {
+  int n = Size();
+  check_out_size(out, n);
+  double const* xs = XS.data();
+  double const* ys = YS.data();
+  Tolerance tol(decimal_precision);  // same test as Point2D::AlmostEquals: |d * 10^dp| < 0.5 on both axes
+  int i = 0;
+#if defined(GEOMPP_SIMD_AVX2)
+  __m256d px = _mm256_set1_pd(point.x()), py = _mm256_set1_pd(point.y());
+  __m256d scale = _mm256_set1_pd(tol.Scale()), half = _mm256_set1_pd(0.5), sign = _mm256_set1_pd(-0.0);
+  for (; i + 4 <= n; i += 4) {
+    __m256d dx = _mm256_andnot_pd(sign, _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(xs + i), px), scale));
+    __m256d dy = _mm256_andnot_pd(sign, _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(ys + i), py), scale));
+    int mask =
+        _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(dx, half, _CMP_LT_OQ), _mm256_cmp_pd(dy, half, _CMP_LT_OQ)));
+    for (int k = 0; k < 4; ++k) {
+      out[i + k] = (mask >> k) & 1;
+    }
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  __m128d px = _mm_set1_pd(point.x()), py = _mm_set1_pd(point.y());
+  __m128d scale = _mm_set1_pd(tol.Scale()), half = _mm_set1_pd(0.5), sign = _mm_set1_pd(-0.0);
+  for (; i + 2 <= n; i += 2) {
+    __m128d dx = _mm_andnot_pd(sign, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(xs + i), px), scale));
+    __m128d dy = _mm_andnot_pd(sign, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(ys + i), py), scale));
+    int mask = _mm_movemask_pd(_mm_and_pd(_mm_cmplt_pd(dx, half), _mm_cmplt_pd(dy, half)));
+    out[i] = mask & 1;
+    out[i + 1] = (mask >> 1) & 1;
+  }
+#endif
+  for (; i < n; ++i) {
+    out[i] = tol.IsZero(xs[i] - point.x()) && tol.IsZero(ys[i] - point.y());
+  }
+}
+
+void PointBuffer2D::Translate(Vector2D const& v) {
+  int n = Size();
+  double* xs = XS.data();
+  double* ys = YS.data();
+  int i = 0;
+#if defined(GEOMPP_SIMD_AVX2)
+  __m256d vx = _mm256_set1_pd(v.x()), vy = _mm256_set1_pd(v.y());
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(xs + i, _mm256_add_pd(_mm256_loadu_pd(xs + i), vx));
+    _mm256_storeu_pd(ys + i, _mm256_add_pd(_mm256_loadu_pd(ys + i), vy));
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  __m128d vx = _mm_set1_pd(v.x()), vy = _mm_set1_pd(v.y());
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(xs + i, _mm_add_pd(_mm_loadu_pd(xs + i), vx));
+    _mm_storeu_pd(ys + i, _mm_add_pd(_mm_loadu_pd(ys + i), vy));
+  }
+#endif
+  for (; i < n; ++i) {
+    xs[i] += v.x();
+    ys[i] += v.y();
+  }
+}
+
+void PointBuffer2D::Scale(double a) {
+  int n = Size();
+  double* xs = XS.data();
+  double* ys = YS.data();
+  int i = 0;
+#if defined(GEOMPP_SIMD_AVX2)
+  __m256d va = _mm256_set1_pd(a);
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(xs + i, _mm256_mul_pd(_mm256_loadu_pd(xs + i), va));
+    _mm256_storeu_pd(ys + i, _mm256_mul_pd(_mm256_loadu_pd(ys + i), va));
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  __m128d va = _mm_set1_pd(a);
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(xs + i, _mm_mul_pd(_mm_loadu_pd(xs + i), va));
+    _mm_storeu_pd(ys + i, _mm_mul_pd(_mm_loadu_pd(ys + i), va));
+  }
+#endif
+  for (; i < n; ++i) {
+    xs[i] *= a;
+    ys[i] *= a;
+  }
+}
+
+BoundingBox2D PointBuffer2D::BoundingBox() const {
+  int n = Size();
+  if (n == 0) {
+    return BoundingBox2D::Empty();
+  }
+  double const* xs = XS.data();
+  double const* ys = YS.data();
+  double min_x = xs[0], min_y = ys[0], max_x = xs[0], max_y = ys[0];
+  int i = 0;
+#if defined(GEOMPP_SIMD_AVX2)
+  if (n >= 4) {
+    __m256d vmin_x = _mm256_loadu_pd(xs), vmax_x = vmin_x;
+    __m256d vmin_y = _mm256_loadu_pd(ys), vmax_y = vmin_y;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m256d x = _mm256_loadu_pd(xs + i), y = _mm256_loadu_pd(ys + i);
+      vmin_x = _mm256_min_pd(vmin_x, x);
+      vmax_x = _mm256_max_pd(vmax_x, x);
+      vmin_y = _mm256_min_pd(vmin_y, y);
+      vmax_y = _mm256_max_pd(vmax_y, y);
+    }
+    alignas(32) double lanes[4][4];
+    _mm256_store_pd(lanes[0], vmin_x);
+    _mm256_store_pd(lanes[1], vmin_y);
+    _mm256_store_pd(lanes[2], vmax_x);
+    _mm256_store_pd(lanes[3], vmax_y);
+    for (int k = 0; k < 4; ++k) {
+      min_x = std::min(min_x, lanes[0][k]);
+      min_y = std::min(min_y, lanes[1][k]);
+      max_x = std::max(max_x, lanes[2][k]);
+      max_y = std::max(max_y, lanes[3][k]);
+    }
+  }
+#elif defined(GEOMPP_SIMD_SSE2)
+  if (n >= 2) {
+    __m128d vmin_x = _mm_loadu_pd(xs), vmax_x = vmin_x;
+    __m128d vmin_y = _mm_loadu_pd(ys), vmax_y = vmin_y;
+    for (i = 2; i + 2 <= n; i += 2) {
+      __m128d x = _mm_loadu_pd(xs + i), y = _mm_loadu_pd(ys + i);
+      vmin_x = _mm_min_pd(vmin_x, x);
+      vmax_x = _mm_max_pd(vmax_x, x);
+      vmin_y = _mm_min_pd(vmin_y, y);
+      vmax_y = _mm_max_pd(vmax_y, y);
+    }
+    alignas(16) double lanes[4][2];
+    _mm_store_pd(lanes[0], vmin_x);
+    _mm_store_pd(lanes[1], vmin_y);
+    _mm_store_pd(lanes[2], vmax_x);
+    _mm_store_pd(lanes[3], vmax_y);
+    for (int k = 0; k < 2; ++k) {
+      min_x = std::min(min_x, lanes[0][k]);
+      min_y = std::min(min_y, lanes[1][k]);
+      max_x = std::max(max_x, lanes[2][k]);
+      max_y = std::max(max_y, lanes[3][k]);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    min_x = std::min(min_x, xs[i]);
+    min_y = std::min(min_y, ys[i]);
+    max_x = std::max(max_x, xs[i]);
+    max_y = std::max(max_y, ys[i]);
+  }
+  return BoundingBox2D::Make({min_x, min_y}, {max_x, max_y});
+}
+
+char const* PointBuffer2D::Simd() { return simd_instruction_set(); }
+
+#pragma endregion
+
+}  // namespace geompp
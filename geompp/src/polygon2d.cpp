@@ -0,0 +1,328 @@
+#include "polygon2d.hpp"
+
+#include "edge_grid.hpp"
+#include "predicates.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>  // TODO: replace with logger lib
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+namespace geompp {
+
+namespace {
+
+// twice the signed area of the closed ring (> 0 counterclockwise), by the shoelace formula
+double twice_area(std::span<Point2D const> ring) {
+  double area = 0;
+  for (int i = 0; i + 1 < ring.size(); ++i) {
+    area += ring[i].x() * ring[i + 1].y() - ring[i + 1].x() * ring[i].y();
+  }
+  return area;
+}
+
+double distance_to_edge(Point2D const& p, Point2D const& a, Point2D const& b) {
+  Vector2D ab = b - a;
+  Vector2D ap = p - a;
+  double t = std::clamp(ap.Dot(ab) / ab.Dot(ab), 0.0, 1.0);
+  return (ap - t * ab).Length();
+}
+
+}  // namespace
+
+#pragma region Constructors
+
+struct Polygon2D::LazyGrid {
+  std::once_flag built;
+  std::optional<EdgeGrid> grid;
+};
+
+Polygon2D::Polygon2D(std::vector<Point2D>&& knots, std::vector<int>&& rings)
+    : KNOTS{std::move(knots)}, RINGS{std::move(rings)} {
+  if (Size() - Rings() > GRID_MIN_SIZE) {
+    GRID = std::make_shared<LazyGrid>();
+  }
+}
+
+EdgeGrid const* Polygon2D::Grid() const {
+  if (!GRID) {
+    return nullptr;
+  }
+  std::call_once(GRID->built, [this] { GRID->grid.emplace(EdgeGrid::Make(KNOTS, RINGS)); });
+  return &*GRID->grid;
+}
+
+void Polygon2D::Prepare() const { Grid(); }
+
+Polygon2D Polygon2D::Make(std::vector<Point2D> const& exterior, std::vector<std::vector<Point2D>> const& holes,
+                          int decimal_precision) {
+  auto polygon = TryMake(exterior, holes, decimal_precision);
+  if (!polygon) {
+    throw std::runtime_error(std::format("cannot build polygon: {}", to_string(polygon.error())));
+  }
+  return *std::move(polygon);
+}
+
+expected<Polygon2D, GeomError> Polygon2D::TryMake(std::vector<Point2D> const& exterior,
+                                                  std::vector<std::vector<Point2D>> const& holes,
+                                                  int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Polygon2D::Make");
+  Tolerance tol(decimal_precision);
+  std::vector<Point2D> knots;
+  std::vector<int> rings{0};
+  for (int i = 0; i <= holes.size(); ++i) {
+    std::vector<Point2D> ring(i == 0 ? exterior : holes[i - 1]);
+    if (ring.size() < 3) {
+      return unexpected(GeomError::DEGENERATE_RING);
+    }
+
+    // open, cleaned, then cleaned again from its middle knot (the ends are consecutive too), back to its first knot
+    // unless that one went, and closed again
+    Point2D const first = ring.front();
+    for (int pass = 0; pass < 2; ++pass) {
+      Point2D::remove_duplicates_and_collinear(ring, decimal_precision);
+      while (ring.size() > 1 && ring.front().AlmostEquals(ring.back(), decimal_precision)) {
+        ring.pop_back();
+      }
+      std::rotate(ring.begin(), ring.begin() + ring.size() / 2, ring.end());
+    }
+    auto kept = std::find_if(ring.begin(), ring.end(), [&first](Point2D const& knot) {
+      return knot.x() == first.x() && knot.y() == first.y();
+    });
+    std::rotate(ring.begin(), kept == ring.end() ? ring.begin() : kept, ring.end());
+    if (ring.size() < 3) {
+      return unexpected(GeomError::DEGENERATE_RING);
+    }
+    ring.push_back(ring.front());
+
+    double area = twice_area(ring) / 2;
+    if (tol.IsZero(area)) {
+      return unexpected(GeomError::DEGENERATE_RING);
+    }
+    if ((i == 0) != (area > 0)) {  // the exterior counterclockwise, the holes clockwise
+      std::reverse(ring.begin(), ring.end());
+    }
+
+    knots.insert(knots.end(), ring.begin(), ring.end());
+    rings.push_back(knots.size());
+  }
+
+  return Polygon2D(std::move(knots), std::move(rings));
+}
+
+bool Polygon2D::AlmostEquals(Polygon2D const& other, int decimal_precision) const {
+  if (RINGS != other.RINGS) {
+    return false;
+  }
+  for (int i = 0; i < KNOTS.size(); ++i) {
+    if (!KNOTS[i].AlmostEquals(other.KNOTS[i], decimal_precision)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double Polygon2D::Area() const {
+  double area = 0;
+  for (int i = 0; i < Rings(); ++i) {
+    area += twice_area(Ring(i));  // negative for the holes
+  }
+  return area / 2;
+}
+
+BoundingBox2D Polygon2D::BoundingBox() const {
+  auto box = BoundingBox2D::Empty();
+  for (auto const& knot : Exterior()) {
+    box = box.Union(knot);
+  }
+  return box;
+}
+
+#pragma endregion
+
+#pragma region Geometrical Operations
+
+bool Polygon2D::Contains(Point2D const& point, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polygon2D::Contains");
+  Tolerance tol(decimal_precision);
+  auto on_ring = [this, &point, &tol](int k) { return tol.IsZero(distance_to_edge(point, KNOTS[k], KNOTS[k + 1])); };
+
+  if (auto const* grid = Grid()) {
+    // the edges near enough to the point are in the cells around it
+    if (grid->Any(widen_box(BoundingBox2D::Make(point, point), 0, decimal_precision), on_ring)) {
+      return true;
+    }
+    if (auto winding = grid->WindingNumber(KNOTS, point)) {
+      return *winding != 0;
+    }
+    GEOMPP_PROFILE_COUNT("Polygon2D::Contains without the grid");
+  }
+
+  for (int r = 0; r < Rings(); ++r) {
+    for (int k = RINGS[r]; k + 1 < RINGS[r + 1]; ++k) {
+      if (on_ring(k)) {
+        return true;
+      }
+    }
+  }
+  return WindingNumber(point) != 0;
+}
+
+int Polygon2D::WindingNumber(Point2D const& point) const {
+  // the edges crossing the ray from the point to the right: +1 going up, with the point on their left, -1 going down
+  int winding = 0;
+  for (int r = 0; r < Rings(); ++r) {
+    for (int k = RINGS[r]; k + 1 < RINGS[r + 1]; ++k) {
+      auto const& a = KNOTS[k];
+      auto const& b = KNOTS[k + 1];
+      if (a.y() <= point.y()) {
+        if (b.y() > point.y() && orientation(a, b, point) > 0) {
+          ++winding;
+        }
+      } else if (b.y() <= point.y() && orientation(a, b, point) < 0) {
+        --winding;
+      }
+    }
+  }
+  return winding;
+}
+
+#pragma endregion
+
+#pragma region Formatting
+
+std::string Polygon2D::ToWkt(int decimal_precision) const {
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
+}
+
+Polygon2D Polygon2D::FromWkt(std::string const& wkt) {
+  auto polygon = TryFromWkt(wkt);
+  if (!polygon) {
+    GEOMPP_PROFILE_COUNT("Polygon2D::FromWkt failed");
+    std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(polygon.error())));
+  }
+  return *std::move(polygon);
+}
+
+expected<Polygon2D, GeomError> Polygon2D::TryFromWkt(std::string_view wkt) {
+  GEOMPP_PROFILE_SCOPE("Polygon2D::FromWkt");
+  WktReader reader(wkt, false);
+  reader.Tag("POLYGON");
+  reader.Expect('(');
+  std::vector<std::vector<Point2D>> rings;
+  do {
+    rings.push_back(reader.Points());
+  } while (!reader.Failed() && reader.Accept(','));
+  reader.Expect(')');
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  int decimal_precision = std::min(reader.DecimalPlaces(), MAX_DECIMAL_PRECISION<double>);
+  auto exterior = std::move(rings.front());
+  rings.erase(rings.begin());
+  return TryMake(exterior, rings, decimal_precision);
+}
+
+void Polygon2D::ToFile(std::string const& path, int decimal_precision) const {
+  try {
+    std::string content = ToWkt(decimal_precision);
+
+    // Open the file in write mode (truncates existing content)
+    std::ofstream outfile(path);
+
+    if (!outfile.is_open()) {
+      throw std::runtime_error("Could not open file");
+    }
+
+    // Write the text to the file
+    outfile << content;
+
+    outfile.close();
+
+  } catch (...) {
+    std::cerr << "bad path " << path << std::endl;  // TODO: replace with logger lib
+  }
+}
+
+Polygon2D Polygon2D::FromFile(std::string const& path) {
+  try {
+    std::string content;
+
+    // Open the file in read mode
+    std::ifstream in_file(path);
+
+    if (!in_file.is_open()) {
+      throw std::runtime_error("could not open file");
+    }
+
+    // Get the file size (optional, for efficiency)
+    in_file.seekg(0, std::ios::end);
+    std::streamsize fileSize = in_file.tellg();
+    in_file.seekg(0, std::ios::beg);  // Reset the file pointer
+
+    // Resize the string to the file size (optional, for efficiency)
+    content.resize(static_cast<size_t>(fileSize));
+
+    // Read the entire file into the string
+    in_file.read(&content[0], fileSize);
+
+    return FromWkt(content);
+
+  } catch (...) {
+    std::cerr << "bad path " << path << std::endl;  // TODO: replace with logger lib
+  }
+
+  throw std::runtime_error("failed to parse WKT");
+}
+
+std::vector<std::uint8_t> Polygon2D::ToWkb(Endian endian) const {
+  std::vector<std::span<Point2D const>> rings;
+  for (int i = 0; i < Rings(); ++i) {
+    rings.push_back(Ring(i));
+  }
+  WkbWriter writer(endian);
+  writer.Polygon(rings);
+  return writer.Release();
+}
+
+Polygon2D Polygon2D::FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  auto rings = reader.Polygon();
+  reader.End();
+  if (rings.empty()) {
+    throw std::runtime_error("a polygon has an exterior ring at least");
+  }
+  auto exterior = std::move(rings.front());
+  rings.erase(rings.begin());
+  return Make(exterior, rings, decimal_precision);
+}
+
+void Polygon2D::ToWkbFile(std::string const& path, Endian endian) const { write_wkb_file(path, ToWkb(endian)); }
+
+Polygon2D Polygon2D::FromWkbFile(std::string const& path, int decimal_precision) {
+  return FromWkb(read_wkb_file(path), decimal_precision);
+}
+
+#pragma endregion
+
+#pragma region Operator Overloading
+
+bool operator==(Polygon2D const& lhs, Polygon2D const& rhs) { return lhs.AlmostEquals(rhs); }
+
+#pragma endregion
+
+}  // namespace geompp
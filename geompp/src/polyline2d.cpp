@@ -1,98 +1,360 @@
 #include "polyline2d.hpp"
 
+#include "bounding_box2d.hpp"
+#include "executor.hpp"
 #include "line2d.hpp"
 #include "line_segment2d.hpp"
 #include "point2d.hpp"
 #include "ray2d.hpp"
+#include "segment_bvh.hpp"
+#include "segment_sweep.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
 #include "utils.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <format>
 #include <fstream>
 #include <iostream>  // TODO: replace with logger lib
 #include <limits>
+#include <mutex>
 #include <numeric>
+#include <queue>
 #include <ranges>
-#include <sstream>
 #include <stdexcept>
 #include <type_traits>
 
 namespace geompp {
 
+namespace {
+
+BoundingBox2D widen(SegmentBVH::Node const& node, int decimal_precision) {
+  return widen_box(node.box, node.reach, decimal_precision);
+}
+
+// the points in double: the same vector for the double ones, a copy of the float ones
+template <Scalar T>
+decltype(auto) wide_points(std::vector<BasicPoint2D<T>> const& points) {
+  if constexpr (std::is_same_v<T, double>) {
+    return (points);
+  } else {
+    return std::vector<Point2D>(points.begin(), points.end());
+  }
+}
+
+// distance of the point from the chord a-b (a segment, or the point a when the run is closed)
+double distance_to_chord(Point2D const& p, Point2D const& a, Point2D const& b) {
+  Vector2D ab = b - a;
+  Vector2D ap = p - a;
+  double length2 = ab.Dot(ab);
+  double t = length2 > 0 ? std::clamp(ap.Dot(ab) / length2, 0.0, 1.0) : 0.0;
+  return (ap - t * ab).Length();
+}
+
+// Douglas-Peucker, with a stack of runs instead of recursion: the farthest knot from the chord of a run splits it, its
+// significance is that distance, capped at the significance of the knot that made the run. The runs with no knot
+// farther than the cutoff are not split (their knots stay at 0): -infinity for the significance of all the knots.
+template <Scalar T>
+std::vector<double> douglas_peucker(std::vector<BasicPoint2D<T>> const& knots, double cutoff) {
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  int n = knots.size();
+  std::vector<double> significance(n, 0.0);
+  significance[0] = significance[n - 1] = INF;
+
+  struct Run {
+    int first, last;
+    double cap;
+  };
+  std::vector<Run> stack{{0, n - 1, INF}};
+  while (!stack.empty()) {
+    auto [first, last, cap] = stack.back();
+    stack.pop_back();
+    if (last - first < 2) {
+      continue;
+    }
+
+    Point2D a(knots[first]), b(knots[last]);
+    int farthest = first + 1;
+    double distance = -1;
+    for (int i = first + 1; i < last; ++i) {
+      double d = distance_to_chord(Point2D(knots[i]), a, b);
+      if (d > distance) {
+        distance = d;
+        farthest = i;
+      }
+    }
+    if (distance <= cutoff) {
+      continue;
+    }
+
+    significance[farthest] = std::min(distance, cap);
+    stack.push_back({first, farthest, significance[farthest]});
+    stack.push_back({farthest, last, significance[farthest]});
+  }
+  return significance;
+}
+
+// Visvalingam-Whyatt, with a heap of the knots by the area of the triangle with their neighbours (an entry is stale
+// once the area of its knot changed): the significance of a knot is the area it is dropped at, never below the one of
+// the knots dropped before. Stops at the first area above the cutoff, the knots left keep their area: +infinity for
+// the significance of all the knots.
+template <Scalar T>
+std::vector<double> visvalingam_whyatt(std::vector<BasicPoint2D<T>> const& knots, double cutoff) {
+  constexpr double DROPPED = -1;
+  int n = knots.size();
+  std::vector<double> area(n, std::numeric_limits<double>::infinity());
+  std::vector<int> prev(n), next(n);
+  std::iota(prev.begin(), prev.end(), -1);
+  std::iota(next.begin(), next.end(), 1);
+  auto triangle = [&knots, &prev, &next](int i) {
+    Point2D p(knots[i]);
+    return std::abs((Point2D(knots[prev[i]]) - p).Perp().Dot(Point2D(knots[next[i]]) - p)) / 2;
+  };
+
+  using Entry = std::pair<double, int>;
+  std::vector<Entry> entries;
+  entries.reserve(n);
+  for (int i = 1; i < n - 1; ++i) {
+    area[i] = triangle(i);
+    entries.push_back({area[i], i});
+  }
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap(std::greater<>(), std::move(entries));
+
+  std::vector<double> significance(n);
+  double dropped = 0;  // the largest significance given so far
+  while (!heap.empty()) {
+    auto [a, i] = heap.top();
+    if (a != area[i]) {
+      heap.pop();
+      continue;
+    }
+    if (std::max(a, dropped) > cutoff) {
+      break;
+    }
+    heap.pop();
+
+    significance[i] = dropped = std::max(a, dropped);
+    area[i] = DROPPED;
+    next[prev[i]] = next[i];
+    prev[next[i]] = prev[i];
+    for (int j : {prev[i], next[i]}) {
+      if (j > 0 && j < n - 1) {
+        area[j] = triangle(j);
+        heap.push({area[j], j});
+      }
+    }
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (area[i] != DROPPED) {
+      significance[i] = area[i];
+    }
+  }
+  return significance;
+}
+
+// below this many red segments per range a sweep is not worth a task of its own
+constexpr int PARALLEL_MIN_RANGE = 1 << 10;
+
+// SegmentSweep::Make(red, blue) then sweep(...) (one of its Intersection), by ranges of red segments in parallel,
+// each swept against the blue segments whose box (box_of) meets the box of the range: the same crossings, in the same
+// order, as a range holds the consecutive red segments and the blue ones are kept in their order
+template <typename BoxOf, typename Sweep>
+std::vector<SegmentSweep::Crossing> parallel_crossings(std::vector<LineSegment2D> const& red,
+                                                       std::vector<LineSegment2D> const& blue, Executor& executor,
+                                                       BoxOf const& box_of, Sweep const& sweep) {
+  int num_ranges = std::min(4 * executor.Concurrency(), static_cast<int>(red.size()) / PARALLEL_MIN_RANGE);
+  if (num_ranges <= 1) {
+    GEOMPP_PROFILE_COUNT("Polyline2D::Intersection(Polyline2D, Executor) serial");
+    return sweep(SegmentSweep::Make(red, blue));
+  }
+
+  std::vector<BoundingBox2D> blue_boxes;
+  blue_boxes.reserve(blue.size());
+  for (auto const& segment : blue) {
+    blue_boxes.push_back(box_of(segment));
+  }
+
+  std::vector<std::vector<SegmentSweep::Crossing>> found(num_ranges);
+  executor.parallel_for(
+      0, num_ranges,
+      [&](int r) {
+        int first = static_cast<int>(red.size() * r / num_ranges);
+        int last = static_cast<int>(red.size() * (r + 1) / num_ranges);
+        std::vector<LineSegment2D> range(red.begin() + first, red.begin() + last);
+        auto range_box = BoundingBox2D::Empty();
+        for (auto const& segment : range) {
+          range_box = range_box.Union(box_of(segment));
+        }
+
+        std::vector<LineSegment2D> near;
+        std::vector<int> near_index;
+        for (int j = 0; j < blue.size(); ++j) {
+          if (blue_boxes[j].Intersects(range_box)) {
+            near.push_back(blue[j]);
+            near_index.push_back(j);
+          }
+        }
+        if (near.empty()) {
+          GEOMPP_PROFILE_COUNT("Polyline2D::Intersection(Polyline2D, Executor) range skipped");
+          return;
+        }
+
+        found[r] = sweep(SegmentSweep::Make(range, near));
+        for (auto& crossing : found[r]) {
+          crossing.first += first;
+          crossing.second = near_index[crossing.second];
+        }
+      },
+      1);
+
+  std::vector<SegmentSweep::Crossing> crossings;
+  for (auto const& range : found) {
+    crossings.insert(crossings.end(), range.begin(), range.end());
+  }
+  return crossings;
+}
+
+}  // namespace
+
 #pragma region Constructors
 
-Polyline2D::Polyline2D(std::vector<Point2D>&& points) : KNOTS{std::move(points)} {}
+template <Scalar T>
+struct BasicPolyline2D<T>::LazyBVH {
+  std::once_flag built;
+  std::optional<SegmentBVH> bvh;
+};
+
+template <Scalar T>
+BasicPolyline2D<T>::BasicPolyline2D(std::vector<BasicPoint2D<T>>&& points) : KNOTS{std::move(points)} {
+  LENGTHS.reserve(KNOTS.size());
+  LENGTHS.push_back(0);
+  for (int i = 1; i < KNOTS.size(); ++i) {
+    LENGTHS.push_back(LENGTHS.back() + (Point2D(KNOTS[i]) - Point2D(KNOTS[i - 1])).Length());
+  }
+  if (static_cast<int>(KNOTS.size()) - 1 > BVH_MIN_SIZE) {
+    BVH = std::make_shared<LazyBVH>();
+  }
+}
+
+template <Scalar T>
+SegmentBVH const* BasicPolyline2D<T>::Bvh() const {
+  if (!BVH) {
+    return nullptr;
+  }
+  std::call_once(BVH->built, [this] { BVH->bvh.emplace(SegmentBVH::Make(wide_points(KNOTS))); });
+  return &*BVH->bvh;
+}
 
-Polyline2D Polyline2D::Make(std::vector<Point2D> const& points, int decimal_precision) {
-  auto unique_points =
-      Point2D::remove_collinear(Point2D::remove_duplicates(points, decimal_precision), decimal_precision);
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::Make(std::vector<BasicPoint2D<T>> const& points, int decimal_precision) {
+  return Make(std::vector<BasicPoint2D<T>>(points), decimal_precision);
+}
 
-  if (unique_points.size() < 2) {
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::Make(std::vector<BasicPoint2D<T>>&& points, int decimal_precision) {
+  auto polyline = TryMake(std::move(points), decimal_precision);
+  if (!polyline) {
+    if (polyline.error() == GeomError::BAD_PRECISION) {
+      throw std::runtime_error(
+          std::format("{} decimals precision: {}", decimal_precision, to_string(polyline.error())));
+    }
     throw std::runtime_error("cannot built polyline with less than 2 unique non-collinear consecutive points");
   }
+  return *std::move(polyline);
+}
 
-  return Polyline2D(std::move(unique_points));
+template <Scalar T>
+expected<BasicPolyline2D<T>, GeomError> BasicPolyline2D<T>::TryMake(std::vector<BasicPoint2D<T>> const& points,
+                                                                    int decimal_precision) {
+  return TryMake(std::vector<BasicPoint2D<T>>(points), decimal_precision);
 }
 
-Polyline2D& Polyline2D::operator=(Polyline2D const& other) {
-  if (this != &other) {
-    *this = other;
+template <Scalar T>
+expected<BasicPolyline2D<T>, GeomError> BasicPolyline2D<T>::TryMake(std::vector<BasicPoint2D<T>>&& points,
+                                                                    int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Make");
+  if (decimal_precision > MAX_DECIMAL_PRECISION<T>) {
+    return unexpected(GeomError::BAD_PRECISION);
+  }
+  BasicPoint2D<T>::remove_duplicates_and_collinear(points, decimal_precision);
+
+  if (points.size() < 2) {
+    return unexpected(GeomError::TOO_FEW_POINTS);
   }
-  return *this;
+
+  return BasicPolyline2D(std::move(points));
 }
 
-std::vector<LineSegment2D> Polyline2D::ToSegments() const {
-  std::vector<LineSegment2D> segs;
+template <Scalar T>
+std::vector<BasicLineSegment2D<T>> BasicPolyline2D<T>::ToSegments() const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::ToSegments");
+  std::vector<BasicLineSegment2D<T>> segs;
+  segs.reserve(KNOTS.size() - 1);
 
-  for (int i = 0; i < KNOTS.size() - 1; ++i) {
-    segs.push_back(LineSegment2D::Make(KNOTS[i], KNOTS[i + 1]));
+  for (auto const& s : Segments()) {
+    segs.push_back(s);
   }
 
   return segs;
 }
 
-double Polyline2D::Length() const {
-  auto iterable_range = ToSegments() | std::ranges::views::transform([](LineSegment2D const& s) { return s.Length(); });
-  return std::accumulate(iterable_range.begin(), iterable_range.end(), 0);
+template <Scalar T>
+std::vector<LineSegment2D> BasicPolyline2D<T>::WideSegments() const {
+  if constexpr (std::is_same_v<T, double>) {
+    return ToSegments();
+  } else {
+    std::vector<LineSegment2D> segs;
+    segs.reserve(KNOTS.size() - 1);
+    for (auto const& s : Segments()) {
+      segs.push_back(LineSegment2D(s));
+    }
+    return segs;
+  }
 }
 
-bool Polyline2D::AlmostEquals(Polyline2D const& other, int decimal_precision) const {
+template <Scalar T>
+bool BasicPolyline2D<T>::AlmostEquals(BasicPolyline2D const& other, int decimal_precision) const {
   if (KNOTS.size() != other.KNOTS.size()) {
     return false;
   }
-  for (int i = 0; i < KNOTS.size(); ++i) {
-    if (!KNOTS[i].AlmostEquals(other.KNOTS[i], decimal_precision)) {
-      return false;
+  return with_tolerance(decimal_precision, [this, &other](auto tol) {
+    for (int i = 0; i < KNOTS.size(); ++i) {
+      if (!tol.AlmostEquals(KNOTS[i].x(), other.KNOTS[i].x()) || !tol.AlmostEquals(KNOTS[i].y(), other.KNOTS[i].y())) {
+        return false;
+      }
     }
-  }
-  return true;
+    return true;
+  });
 }
 
-double Polyline2D::Location(Point2D const& point, int decimal_precision) const {
-  auto segs = ToSegments();
+template <Scalar T>
+double BasicPolyline2D<T>::Location(BasicPoint2D<T> const& point, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Location");
+  auto segs = Segments();
+  double tot_len = Length();
+  Tolerance tol(decimal_precision);
 
   // check if the point is in the middle of the polyline
-  double tot_len = 0;
   for (int i = 0; i < segs.size(); ++i) {
     if (segs[i].Contains(point, decimal_precision)) {
-      tot_len += segs[i].Location(point, decimal_precision);
-      return tot_len;
+      return (LENGTHS[i] + segs[i].Location(point, decimal_precision) * (LENGTHS[i + 1] - LENGTHS[i])) / tot_len;
     }
-    tot_len += segs[i].Length();
   }
-  // at this point tot_len == Lenght(), no need to call that loop again
 
   // check if the point is behind the polyline (on the first "line")
-  if (round_to((segs[0].Last() - segs[0].First()).Perp().Dot(point - segs[0].First()), decimal_precision) ==
-      0) {  // collinearity check
-    return sign((point - segs[0].First()).Dot(segs[0].Last() - segs[0].First()), decimal_precision) *
+  if (tol.IsZero((segs[0].Last() - segs[0].First()).Perp().Dot(point - segs[0].First()))) {  // collinearity check
+    return tol.Sign((point - segs[0].First()).Dot(segs[0].Last() - segs[0].First())) *
            segs[0].First().DistanceTo(point) / tot_len;
   }
 
   // check if the point is is beyond the polyline (on the last "line")
   int n = segs.size();
-  if (round_to((segs[n - 1].Last() - segs[n - 1].First()).Perp().Dot(point - segs[n - 1].First()),
-               decimal_precision) == 0) {  // collinearity check
+  if (tol.IsZero((segs[n - 1].Last() - segs[n - 1].First()).Perp().Dot(point - segs[n - 1].First()))) {  // collinearity
     return (tot_len + segs[n - 1].Last().DistanceTo(point)) / tot_len;
   }
 
@@ -100,94 +362,128 @@ double Polyline2D::Location(Point2D const& point, int decimal_precision) const {
   return std::numeric_limits<double>::infinity();
 }
 
-Point2D Polyline2D::Interpolate(double pct) const {
+template <Scalar T>
+BasicPoint2D<T> BasicPolyline2D<T>::Interpolate(double pct) const {
+  constexpr Tolerance<DP_NINE> tol;
+
   // the point is behind the polyline
-  if (round_to(pct, DP_NINE) < 0.0) {
+  if (tol.IsNegative(pct)) {
     return KNOTS[0];
   }
 
   // the point is beyond the polyline
-  if (round_to(pct, DP_NINE) > 1.0) {
+  if (tol.IsAbove(pct, 1)) {
     return KNOTS[KNOTS.size() - 1];
   }
 
-  // pct is within [0, 1]
-  double len_to_i = 0;
-  double len_i = 0;
-  for (int i = 0; i < KNOTS.size() - 1; ++i) {
-    len_i = KNOTS[i].DistanceTo(KNOTS[i + 1], DP_NINE);
-
-    if (round_to(pct - (len_to_i + len_i), DP_NINE) <= 0) {
-      double pct_i = pct - len_to_i;
-      return KNOTS[i] + pct_i * (KNOTS[i + 1] - KNOTS[i]);
-    }
-
-    len_to_i += len_i;
-  }
+  // pct is within [0, 1]: binary search of the segment where the length pct * Length() ends
+  double len = pct * Length();
+  int i = std::upper_bound(LENGTHS.begin(), LENGTHS.end(), len) - LENGTHS.begin() - 1;
+  i = std::clamp(i, 0, static_cast<int>(KNOTS.size()) - 2);
 
-  return KNOTS[KNOTS.size() - 1];
+  double pct_i = std::clamp((len - LENGTHS[i]) / (LENGTHS[i + 1] - LENGTHS[i]), 0.0, 1.0);
+  return KNOTS[i] + pct_i * (KNOTS[i + 1] - KNOTS[i]);
 }
 
-double Polyline2D::DistanceTo(Point2D const& point, int decimal_precision) const {
-  std::vector<double> distances;
-  for (auto const& s : ToSegments()) {
-    distances.push_back(s.DistanceTo(point, decimal_precision));
+template <Scalar T>
+BoundingBox2D BasicPolyline2D<T>::BoundingBox() const {
+  if (BVH) {
+    return Bvh()->Nodes()[0].box;
+  }
+  auto box = BoundingBox2D::Empty();
+  for (auto const& knot : KNOTS) {
+    box = box.Union(Point2D(knot));
   }
-  return *std::min_element(distances.begin(), distances.end());
-  // std::vector<double> iterable_range =
-  //     ToSegments() | std::ranges::views::transform([&point, decimal_precision](LineSegment2D const& s) {
-  //       return s.DistanceTo(point, decimal_precision);
-  //     });
-  // return std::min_element(iterable_range.begin(), iterable_range.end());
+  return box;
 }
 
-#pragma endregion
-
-#pragma region Operator Overloading
+template <Scalar T>
+double BasicPolyline2D<T>::DistanceTo(BasicPoint2D<T> const& point, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::DistanceTo");
+  if (auto bvh = Bvh()) {
+    auto segs = Segments();
+    return bvh->Minimum(
+        [&point, decimal_precision](SegmentBVH::Node const& node) {
+          return round_to(widen(node, decimal_precision).DistanceTo(Point2D(point)), decimal_precision);
+        },
+        [&segs, &point, decimal_precision](int i) { return segs[i].DistanceTo(point, decimal_precision); });
+  }
 
-bool operator==(Polyline2D const& lhs, Polyline2D const& rhs) { return lhs.AlmostEquals(rhs); }
+  return std::ranges::min(
+      Segments() | std::views::transform([&point, decimal_precision](BasicLineSegment2D<T> const& s) {
+        return s.DistanceTo(point, decimal_precision);
+      }));
+}
 
 #pragma endregion
 
 #pragma region Geometrical Operations
 
-bool Polyline2D::Contains(Point2D const& point, int decimal_precision) const {
-  for (auto const& s : ToSegments()) {
-    if (s.Contains(point, decimal_precision)) {
-      return true;
-    }
+template <Scalar T>
+bool BasicPolyline2D<T>::Contains(BasicPoint2D<T> const& point, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Contains");
+  if (auto bvh = Bvh()) {
+    auto segs = Segments();
+    return bvh->Any(
+        [&point, decimal_precision](SegmentBVH::Node const& node) {
+          return widen(node, decimal_precision).Contains(Point2D(point));
+        },
+        [&segs, &point, decimal_precision](int i) { return segs[i].Contains(point, decimal_precision); });
   }
-  return false;
-  // return std::ranges::any_of(ToSegments() |
-  //                            std::ranges::views::transform([&point, decimal_precision](LineSegment2D const& s) {
-  //                              return s.Contains(point, decimal_precision);
-  //                            }));
+
+  return std::ranges::any_of(Segments(), [&point, decimal_precision](BasicLineSegment2D<T> const& s) {
+    return s.Contains(point, decimal_precision);
+  });
 }
 
-bool Polyline2D::Intersects(Line2D const& line, int decimal_precision) const {
+template <Scalar T>
+bool BasicPolyline2D<T>::Intersects(Line2D const& line, int decimal_precision) const {
   return Intersection(line, decimal_precision).has_value();
 }
 
-bool Polyline2D::Intersects(Ray2D const& ray, int decimal_precision) const {
+template <Scalar T>
+bool BasicPolyline2D<T>::Intersects(Ray2D const& ray, int decimal_precision) const {
   return Intersection(ray, decimal_precision).has_value();
 }
 
-bool Polyline2D::Intersects(Polyline2D const& other, int decimal_precision) const {
-  return Intersection(other, decimal_precision).has_value();
+template <Scalar T>
+bool BasicPolyline2D<T>::Intersects(BasicPolyline2D const& other, int decimal_precision) const {
+  return SegmentSweep::Make(WideSegments(), other.WideSegments()).Intersects(decimal_precision);
+}
+
+template <Scalar T>
+bool BasicPolyline2D<T>::Intersects(BasicPolyline2D const& other, ExactPredicates) const {
+  return SegmentSweep::Make(WideSegments(), other.WideSegments()).Intersects(EXACT);
 }
 
-bool Polyline2D::Intersects(LineSegment2D const& other, int decimal_precision) const {
+template <Scalar T>
+bool BasicPolyline2D<T>::Intersects(BasicLineSegment2D<T> const& other, int decimal_precision) const {
   return Intersection(other, decimal_precision).has_value();
 }
 
-Polyline2D::ReturnSet Polyline2D::Intersection(Line2D const& line, int decimal_precision) const {
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(Line2D const& line,
+                                                                        int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Line2D)");
   MultiPoint intersections;
+  auto segs = Segments();
+  auto intersect = [&segs, &intersections, &line, decimal_precision](int i) {
+    auto inter = segs[i].Intersection(line, decimal_precision);
 
-  for (auto const& seg : ToSegments()) {
-    auto inter = line.Intersection(seg, decimal_precision);
+    if (inter.has_value() && std::holds_alternative<BasicPoint2D<T>>(*inter)) {
+      intersections.push_back(std::get<BasicPoint2D<T>>(*inter));
+    }
+    return false;
+  };
 
-    if (inter.has_value() && std::holds_alternative<Point2D>(*inter)) {
-      intersections.push_back(std::get<Point2D>(*inter));
+  if (auto bvh = Bvh()) {  // only the segments in the boxes that the line crosses, still by increasing index
+    bvh->Any([&line, decimal_precision](SegmentBVH::Node const& node) {
+          return box_crosses_line(widen(node, decimal_precision), line.First(), line.Direction());
+        },
+             intersect);
+  } else {
+    for (int i = 0; i < segs.size(); ++i) {
+      intersect(i);
     }
   }
 
@@ -202,14 +498,30 @@ Polyline2D::ReturnSet Polyline2D::Intersection(Line2D const& line, int decimal_p
   return intersections;
 }
 
-Polyline2D::ReturnSet Polyline2D::Intersection(Ray2D const& ray, int decimal_precision) const {
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(Ray2D const& ray,
+                                                                        int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Ray2D)");
   MultiPoint intersections;
+  auto segs = Segments();
+  auto intersect = [&segs, &intersections, &ray, decimal_precision](int i) {
+    auto inter = segs[i].Intersection(ray, decimal_precision);
 
-  for (auto const& seg : ToSegments()) {
-    auto inter = ray.Intersection(seg, decimal_precision);
-
-    if (inter.has_value() && std::holds_alternative<Point2D>(*inter)) {
-      intersections.push_back(std::get<Point2D>(*inter));
+    if (inter.has_value() && std::holds_alternative<BasicPoint2D<T>>(*inter)) {
+      intersections.push_back(std::get<BasicPoint2D<T>>(*inter));
+    }
+    return false;
+  };
+
+  if (auto bvh = Bvh()) {  // only the segments in the boxes that the ray crosses, still by increasing index
+    bvh->Any([&ray, decimal_precision](SegmentBVH::Node const& node) {
+          auto box = widen(node, decimal_precision);
+          return box_crosses_line(box, ray.Origin(), ray.Direction()) && box_ahead_of_ray(box, ray, decimal_precision);
+        },
+             intersect);
+  } else {
+    for (int i = 0; i < segs.size(); ++i) {
+      intersect(i);
     }
   }
 
@@ -224,14 +536,32 @@ Polyline2D::ReturnSet Polyline2D::Intersection(Ray2D const& ray, int decimal_pre
   return intersections;
 }
 
-Polyline2D::ReturnSet Polyline2D::Intersection(LineSegment2D const& segment, int decimal_precision) const {
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(BasicLineSegment2D<T> const& segment,
+                                                                        int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(LineSegment2D)");
   MultiPoint intersections;
+  auto segs = Segments();
+  auto intersect = [&segs, &intersections, &segment, decimal_precision](int i) {
+    auto inter = segment.Intersection(segs[i], decimal_precision);
 
-  for (auto const& seg : ToSegments()) {
-    auto inter = segment.Intersection(seg, decimal_precision);
-
-    if (inter.has_value() && std::holds_alternative<Point2D>(*inter)) {
-      intersections.push_back(std::get<Point2D>(*inter));
+    if (inter.has_value() && std::holds_alternative<BasicPoint2D<T>>(*inter)) {
+      intersections.push_back(std::get<BasicPoint2D<T>>(*inter));
+    }
+    return false;
+  };
+
+  if (auto bvh = Bvh()) {  // only the segments in the boxes that the segment crosses, still by increasing index
+    auto segment_box = widen_box(segment.BoundingBox(), segment_reach(segment.Length()), decimal_precision);
+    bvh->Any([&segment, &segment_box, decimal_precision](SegmentBVH::Node const& node) {
+          auto box = widen(node, decimal_precision);
+          return box.Intersects(segment_box) && box_crosses_line(box, Point2D(segment.First()),
+                                                                 Vector2D(segment.Last() - segment.First()));
+        },
+             intersect);
+  } else {
+    for (int i = 0; i < segs.size(); ++i) {
+      intersect(i);
     }
   }
 
@@ -246,17 +576,15 @@ Polyline2D::ReturnSet Polyline2D::Intersection(LineSegment2D const& segment, int
   return intersections;
 }
 
-Polyline2D::ReturnSet Polyline2D::Intersection(Polyline2D const& other, int decimal_precision) const {
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(BasicPolyline2D const& other,
+                                                                        int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Polyline2D)");
   MultiPoint intersections;
 
-  for (auto const& seg : ToSegments()) {
-    for (auto const& other_seg : other.ToSegments()) {
-      auto inter = seg.Intersection(other_seg, decimal_precision);
-
-      if (inter.has_value() && std::holds_alternative<Point2D>(*inter)) {
-        intersections.push_back(std::get<Point2D>(*inter));
-      }
-    }
+  for (auto const& crossing :
+       SegmentSweep::Make(WideSegments(), other.WideSegments()).Intersection(decimal_precision)) {
+    intersections.push_back(BasicPoint2D<T>(crossing.point));
   }
 
   if (intersections.size() == 0) {
@@ -270,87 +598,148 @@ Polyline2D::ReturnSet Polyline2D::Intersection(Polyline2D const& other, int deci
   return intersections;
 }
 
-// #pragma endregion
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(BasicPolyline2D const& other,
+                                                                        ExactPredicates) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Polyline2D, EXACT)");
+  MultiPoint intersections;
 
-#pragma region Formatting
+  for (auto const& crossing : SegmentSweep::Make(WideSegments(), other.WideSegments()).Intersection(EXACT)) {
+    intersections.push_back(BasicPoint2D<T>(crossing.point));
+  }
 
-std::string Polyline2D::ToWkt(int decimal_precision) const {
-  std::ostringstream buf;
-  buf << "LINESTRING ";
+  if (intersections.size() == 0) {
+    return std::nullopt;
+  }
 
-  if (KNOTS.size() > 0) {
-    buf << "(";
-    for (int i = 0; i < KNOTS.size(); ++i) {
-      buf << std::format("{} {}", round_to(KNOTS[i].x(), decimal_precision), round_to(KNOTS[i].y(), decimal_precision));
+  if (intersections.size() == 1) {
+    return intersections[0];
+  }
 
-      if (i < KNOTS.size() - 1) {
-        buf << ", ";
-      }
-    }
-    buf << ")";
+  return intersections;
+}
 
-  } else {
-    buf << "EMPTY";
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(BasicPolyline2D const& other,
+                                                                        Executor& executor,
+                                                                        int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Polyline2D, Executor)");
+  MultiPoint intersections;
+
+  auto box_of = [decimal_precision](LineSegment2D const& segment) {
+    return widen_box(segment.BoundingBox(), segment_reach(segment.Length()), decimal_precision);
+  };
+  auto sweep = [decimal_precision](SegmentSweep const& s) { return s.Intersection(decimal_precision); };
+  for (auto const& crossing : parallel_crossings(WideSegments(), other.WideSegments(), executor, box_of, sweep)) {
+    intersections.push_back(BasicPoint2D<T>(crossing.point));
   }
 
-  return buf.str();
-}
+  if (intersections.size() == 0) {
+    return std::nullopt;
+  }
 
-Polyline2D Polyline2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_pi, end_pn;
+  if (intersections.size() == 1) {
+    return intersections[0];
+  }
 
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
+  return intersections;
+}
 
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "LINESTRING") {
-      throw std::runtime_error("geometry name");
-    }
+template <Scalar T>
+typename BasicPolyline2D<T>::ReturnSet BasicPolyline2D<T>::Intersection(BasicPolyline2D const& other,
+                                                                        Executor& executor, ExactPredicates) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Intersection(Polyline2D, Executor, EXACT)");
+  MultiPoint intersections;
 
-    end_pn = wkt.substr(end_gtype + 1).find(')');
-    if (end_pn == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
+  auto box_of = [](LineSegment2D const& segment) { return segment.BoundingBox(); };
+  auto sweep = [](SegmentSweep const& s) { return s.Intersection(EXACT); };
+  for (auto const& crossing : parallel_crossings(WideSegments(), other.WideSegments(), executor, box_of, sweep)) {
+    intersections.push_back(BasicPoint2D<T>(crossing.point));
+  }
+
+  if (intersections.size() == 0) {
+    return std::nullopt;
+  }
 
-    std::string mid_part = wkt.substr(end_gtype + 1, wkt.size() - (end_gtype + 1 + 1));
+  if (intersections.size() == 1) {
+    return intersections[0];
+  }
 
-    std::vector<Point2D> pt_vec;
-    int decimal_precision = 0;
-    int num_dec = 0;
-    std::string pt_trimmed;
-    for (std::string const& p_str : geompp::tokenize_string(mid_part, ',')) {
-      pt_trimmed = geompp::trim(p_str);
+  return intersections;
+}
 
-      auto nums = geompp::tokenize_to_doubles(pt_trimmed, ' ');
-      if (nums.size() != 2) {
-        throw std::runtime_error("numbers");
-      }
+// #pragma endregion
 
-      num_dec = count_decimal_places(nums[0]);
-      if (num_dec > decimal_precision) {
-        decimal_precision = num_dec;
-      }
-      num_dec = count_decimal_places(nums[1]);
-      if (num_dec > decimal_precision) {
-        decimal_precision = num_dec;
-      }
+#pragma region Simplification
 
-      pt_vec.push_back({nums[0], nums[1]});
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::Simplify(double tolerance, Simplification method, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Simplify");
+  auto significance = method == Simplification::DOUGLAS_PEUCKER ? douglas_peucker(KNOTS, tolerance)
+                                                                 : visvalingam_whyatt(KNOTS, tolerance);
+  std::vector<BasicPoint2D<T>> knots;
+  for (int i = 0; i < KNOTS.size(); ++i) {
+    if (significance[i] > tolerance) {
+      knots.push_back(KNOTS[i]);
     }
+  }
+  return Make(std::move(knots), decimal_precision);
+}
+
+template <Scalar T>
+std::vector<double> BasicPolyline2D<T>::Significance(Simplification method) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::Significance");
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  return method == Simplification::DOUGLAS_PEUCKER ? douglas_peucker(KNOTS, -INF) : visvalingam_whyatt(KNOTS, INF);
+}
 
-    return Make(pt_vec, decimal_precision);
+#pragma endregion
 
-  } catch (...) {
+#pragma region Formatting
+
+template <Scalar T>
+std::string BasicPolyline2D<T>::ToWkt(int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::ToWkt");
+  std::string wkt;
+  wkt.reserve(max_wkt_size(*this));
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
+}
+
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::FromWkt(std::string const& wkt) {
+  auto polyline = TryFromWkt(wkt);
+  if (!polyline) {
+    GEOMPP_PROFILE_COUNT("Polyline2D::FromWkt failed");
     std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(polyline.error())));
   }
+  return *std::move(polyline);
+}
 
-  throw std::runtime_error("failed to parse WKT");
+template <Scalar T>
+expected<BasicPolyline2D<T>, GeomError> BasicPolyline2D<T>::TryFromWkt(std::string_view wkt) {
+  GEOMPP_PROFILE_SCOPE("Polyline2D::FromWkt");
+  WktReader reader(wkt, false);
+  reader.Tag("LINESTRING");
+  auto points = reader.Points();
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  // the precision of the text: the most decimal places written in any of its numbers, up to the digits of T
+  int decimal_precision = std::min(reader.DecimalPlaces(), MAX_DECIMAL_PRECISION<T>);
+  if constexpr (std::is_same_v<T, double>) {
+    return TryMake(std::move(points), decimal_precision);
+  } else {
+    return TryMake(std::vector<BasicPoint2D<T>>(points.begin(), points.end()), decimal_precision);
+  }
 }
 
-void Polyline2D::ToFile(std::string const& path, int decimal_precision) const {
+template <Scalar T>
+void BasicPolyline2D<T>::ToFile(std::string const& path, int decimal_precision) const {
   try {
     std::string content = ToWkt(decimal_precision);
 
@@ -371,7 +760,8 @@ void Polyline2D::ToFile(std::string const& path, int decimal_precision) const {
   }
 }
 
-Polyline2D Polyline2D::FromFile(std::string const& path) {
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::FromFile(std::string const& path) {
   try {
     std::string content;
 
@@ -402,6 +792,38 @@ Polyline2D Polyline2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+template <Scalar T>
+std::vector<std::uint8_t> BasicPolyline2D<T>::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  writer.LineString(KNOTS);
+  return writer.Release();
+}
+
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  auto points = reader.LineString();
+  reader.End();
+  if constexpr (std::is_same_v<T, double>) {
+    return Make(std::move(points), decimal_precision);
+  } else {
+    return Make(std::vector<BasicPoint2D<T>>(points.begin(), points.end()), decimal_precision);
+  }
+}
+
+template <Scalar T>
+void BasicPolyline2D<T>::ToWkbFile(std::string const& path, Endian endian) const {
+  write_wkb_file(path, ToWkb(endian));
+}
+
+template <Scalar T>
+BasicPolyline2D<T> BasicPolyline2D<T>::FromWkbFile(std::string const& path, int decimal_precision) {
+  return FromWkb(read_wkb_file(path), decimal_precision);
+}
+
 #pragma endregion
 
+template class BasicPolyline2D<double>;
+template class BasicPolyline2D<float>;
+
 }  // namespace geompp
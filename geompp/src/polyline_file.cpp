@@ -0,0 +1,327 @@
+#include "polyline_file.hpp"
+
+#include <bit>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace geompp {
+
+namespace {
+
+constexpr char MAGIC[8] = {'G', 'E', 'O', 'M', 'P', 'P', 'P', 'L'};
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t layout;
+  std::uint64_t size;      // number of polylines
+  std::uint64_t vertices;  // number of vertices, of all the polylines
+  std::uint64_t coordinates, offsets, boxes;  // position of the sections, in bytes from the start of the file
+  std::uint64_t reserved;
+};
+static_assert(sizeof(Header) == 64);
+
+// the whole file, read only, or throws
+std::pair<void const*, std::size_t> map_file(std::string const& path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("could not open file " + path);
+  }
+  LARGE_INTEGER size;
+  GetFileSizeEx(file, &size);
+  HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+  void const* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (mapping) {
+    CloseHandle(mapping);  // the view keeps the mapping alive
+  }
+  CloseHandle(file);
+  if (!data) {
+    throw std::runtime_error("could not map file " + path);
+  }
+  return {data, static_cast<std::size_t>(size.QuadPart)};
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("could not open file " + path);
+  }
+  struct stat st;
+  void* data = fstat(fd, &st) == 0 && st.st_size > 0
+                   ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+                   : MAP_FAILED;
+  close(fd);  // the mapping stays
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("could not map file " + path);
+  }
+  return {data, static_cast<std::size_t>(st.st_size)};
+#endif
+}
+
+void unmap_file(void const* data, std::size_t bytes) {
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<void*>(data), bytes);
+#endif
+}
+
+template <typename T>
+void write_values(std::ostream& out, T const* values, std::size_t count) {
+  out.write(reinterpret_cast<char const*>(values), count * sizeof(T));
+}
+
+}  // namespace
+
+#pragma region PolylineView
+
+PolylineView::PolylineView(double const* xs, double const* ys, int stride, int size, BoundingBox2D const& box)
+    : XS(xs), YS(ys), STRIDE(stride), SIZE(size), BOX(box) {}
+
+std::vector<Point2D> PolylineView::ToPoints() const {
+  std::vector<Point2D> points;
+  points.reserve(SIZE);
+  for (int i = 0; i < SIZE; ++i) {
+    points.push_back(At(i));
+  }
+  return points;
+}
+
+Polyline2D PolylineView::ToPolyline(int decimal_precision) const {
+  return Polyline2D::Make(ToPoints(), decimal_precision);
+}
+
+#pragma endregion
+
+#pragma region PolylineFile
+
+PolylineFile PolylineFile::Open(std::string const& path) {
+  if constexpr (std::endian::native != std::endian::little) {
+    throw std::runtime_error("polyline files are little endian, and read in place");
+  }
+
+  PolylineFile file;
+  std::tie(file.DATA, file.BYTES) = map_file(path);
+
+  auto fail = [&path](std::string const& what) {
+    throw std::runtime_error(std::format("bad polyline file {}: {}", path, what));
+  };
+  if (file.BYTES < sizeof(Header)) {
+    fail("too short");
+  }
+  Header header;
+  std::memcpy(&header, file.DATA, sizeof(Header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    fail("not a polyline file");
+  }
+  if (header.version != VERSION) {
+    fail(std::format("version {}, expected {}", header.version, VERSION));
+  }
+  if (header.layout != static_cast<std::uint32_t>(CoordinateLayout::SEPARATE) &&
+      header.layout != static_cast<std::uint32_t>(CoordinateLayout::INTERLEAVED)) {
+    fail("unknown coordinate layout");
+  }
+  // counted with an int, as the polylines of a Polyline2D are, and the coordinates with an int64
+  if (header.size > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+    fail(std::format("{} polylines, more than {}", header.size, std::numeric_limits<int>::max()));
+  }
+  if (header.vertices > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max() / 2)) {
+    fail(std::format("{} vertices, too many", header.vertices));
+  }
+
+  // each section is within the file, and aligned
+  auto section = [&file, &fail](std::uint64_t position, std::uint64_t count, std::uint64_t size) {
+    if (position % 8 != 0 || position > file.BYTES || count > (file.BYTES - position) / size) {
+      fail("section out of the file");
+    }
+    return static_cast<char const*>(file.DATA) + position;
+  };
+  auto coordinates = reinterpret_cast<double const*>(section(header.coordinates, 2 * header.vertices, 8));
+  file.OFFSETS = reinterpret_cast<std::uint64_t const*>(section(header.offsets, header.size + 1, 8));
+  file.BOXES = reinterpret_cast<double const*>(section(header.boxes, 4 * header.size, 8));
+  if (file.OFFSETS[header.size] != header.vertices) {
+    fail("the offsets do not end at the number of vertices");
+  }
+
+  file.SIZE = header.size;
+  file.VERTICES = header.vertices;
+  file.LAYOUT = static_cast<CoordinateLayout>(header.layout);
+  file.XS = coordinates;
+  file.YS = file.LAYOUT == CoordinateLayout::SEPARATE ? coordinates + header.vertices : coordinates + 1;
+  return file;
+}
+
+PolylineFile::PolylineFile(PolylineFile&& other) noexcept
+    : DATA(std::exchange(other.DATA, nullptr)),
+      BYTES(other.BYTES),
+      SIZE(other.SIZE),
+      VERTICES(other.VERTICES),
+      LAYOUT(other.LAYOUT),
+      XS(other.XS),
+      YS(other.YS),
+      OFFSETS(other.OFFSETS),
+      BOXES(other.BOXES) {}
+
+PolylineFile::~PolylineFile() {
+  if (DATA) {
+    unmap_file(DATA, BYTES);
+  }
+}
+
+BoundingBox2D PolylineFile::BoundingBox(int i) const {
+  double const* box = BOXES + 4 * i;
+  return BoundingBox2D::Make({box[0], box[1]}, {box[2], box[3]});
+}
+
+PolylineView PolylineFile::At(int i) const {
+  if (i < 0 || i >= SIZE) {
+    throw std::runtime_error(std::format("polyline {} out of {}", i, SIZE));
+  }
+  std::uint64_t first = OFFSETS[i], last = OFFSETS[i + 1];
+  if (first > last || last > static_cast<std::uint64_t>(VERTICES) ||
+      last - first > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+    throw std::runtime_error(std::format("bad offsets of polyline {}", i));
+  }
+  int stride = LAYOUT == CoordinateLayout::SEPARATE ? 1 : 2;
+  return {XS + first * stride, YS + first * stride, stride, static_cast<int>(last - first), BoundingBox(i)};
+}
+
+std::vector<int> PolylineFile::Window(BoundingBox2D const& window) const {
+  std::vector<int> found;
+  for (int i = 0; i < SIZE; ++i) {
+    if (BoundingBox(i).Intersects(window)) {
+      found.push_back(i);
+    }
+  }
+  return found;
+}
+
+void PolylineFile::Write(std::string const& path, std::vector<Polyline2D> const& polylines, CoordinateLayout layout) {
+  auto writer = PolylineFileWriter::Open(path, layout);
+  for (auto const& polyline : polylines) {
+    writer.Write(polyline);
+  }
+  writer.Close();
+}
+
+#pragma endregion
+
+#pragma region PolylineFileWriter
+
+PolylineFileWriter PolylineFileWriter::Open(std::string const& path, CoordinateLayout layout) {
+  if constexpr (std::endian::native != std::endian::little) {
+    throw std::runtime_error("polyline files are little endian, and written as they are in memory");
+  }
+  return PolylineFileWriter(path, layout);
+}
+
+PolylineFileWriter::PolylineFileWriter(std::string const& path, CoordinateLayout layout)
+    : OUT(path, std::ios::binary), LAYOUT(layout) {
+  if (!OUT.is_open()) {
+    throw std::runtime_error("could not open file " + path);
+  }
+  if (LAYOUT == CoordinateLayout::SEPARATE) {
+    YS = std::tmpfile();
+    if (!YS) {
+      throw std::runtime_error("could not open a temporary file");
+    }
+  }
+  Header header{};  // written again by Close
+  write_values(OUT, &header, 1);
+}
+
+PolylineFileWriter::PolylineFileWriter(PolylineFileWriter&& other) noexcept
+    : OUT(std::move(other.OUT)),
+      YS(std::exchange(other.YS, nullptr)),
+      LAYOUT(other.LAYOUT),
+      OFFSETS(std::move(other.OFFSETS)),
+      BOXES(std::move(other.BOXES)),
+      CLOSED(std::exchange(other.CLOSED, true)) {}
+
+PolylineFileWriter::~PolylineFileWriter() {
+  try {
+    Close();
+  } catch (...) {
+    std::fprintf(stderr, "failed to close polyline file\n");  // TODO: replace with logger lib
+  }
+  if (YS) {
+    std::fclose(YS);
+  }
+}
+
+void PolylineFileWriter::Write(Polyline2D const& polyline) {
+  if (CLOSED) {
+    throw std::runtime_error("cannot write to a closed polyline file");
+  }
+
+  std::vector<double> xs, ys;
+  xs.reserve(LAYOUT == CoordinateLayout::SEPARATE ? polyline.Size() : 2 * polyline.Size());
+  ys.reserve(polyline.Size());
+  for (auto const& knot : polyline.Knots()) {
+    xs.push_back(knot.x());
+    (LAYOUT == CoordinateLayout::SEPARATE ? ys : xs).push_back(knot.y());
+  }
+  write_values(OUT, xs.data(), xs.size());
+  if (LAYOUT == CoordinateLayout::SEPARATE &&
+      std::fwrite(ys.data(), sizeof(double), ys.size(), YS) != ys.size()) {
+    throw std::runtime_error("could not write the temporary file");
+  }
+
+  OFFSETS.push_back(OFFSETS.back() + polyline.Size());
+  auto box = polyline.BoundingBox();
+  BOXES.insert(BOXES.end(), {box.MinX(), box.MinY(), box.MaxX(), box.MaxY()});
+}
+
+void PolylineFileWriter::Close() {
+  if (CLOSED) {
+    return;
+  }
+  CLOSED = true;
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = PolylineFile::VERSION;
+  header.layout = static_cast<std::uint32_t>(LAYOUT);
+  header.size = OFFSETS.size() - 1;
+  header.vertices = OFFSETS.back();
+  header.coordinates = sizeof(Header);
+
+  // the y after the x, through a buffer
+  if (LAYOUT == CoordinateLayout::SEPARATE) {
+    std::rewind(YS);
+    std::vector<char> buffer(1 << 20);
+    for (std::size_t n; (n = std::fread(buffer.data(), 1, buffer.size(), YS)) > 0;) {
+      OUT.write(buffer.data(), n);
+    }
+  }
+
+  header.offsets = header.coordinates + 16 * header.vertices;
+  write_values(OUT, OFFSETS.data(), OFFSETS.size());
+  header.boxes = header.offsets + 8 * OFFSETS.size();
+  write_values(OUT, BOXES.data(), BOXES.size());
+
+  OUT.seekp(0);
+  write_values(OUT, &header, 1);
+  OUT.close();
+  if (!OUT) {
+    throw std::runtime_error("could not write the polyline file");
+  }
+}
+
+#pragma endregion
+
+}  // namespace geompp
@@ -0,0 +1,55 @@
+#include "polyline_pyramid.hpp"
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace geompp {
+
+PolylinePyramid PolylinePyramid::Make(Polyline2D const& polyline, Simplification method) {
+  GEOMPP_PROFILE_SCOPE("PolylinePyramid::Make");
+  auto significance = polyline.Significance(method);
+
+  PolylinePyramid pyramid;
+  pyramid.METHOD = method;
+  pyramid.KNOTS = polyline.Knots();
+  pyramid.RANKING.resize(significance.size());
+  std::iota(pyramid.RANKING.begin(), pyramid.RANKING.end(), 0);
+  std::stable_sort(pyramid.RANKING.begin(), pyramid.RANKING.end(),
+                   [&significance](int a, int b) { return significance[a] > significance[b]; });
+  pyramid.SIGNIFICANCE.reserve(significance.size());
+  for (int i : pyramid.RANKING) {
+    pyramid.SIGNIFICANCE.push_back(significance[i]);
+  }
+  return pyramid;
+}
+
+int PolylinePyramid::Count(double tolerance) const {
+  // the first significance not above the tolerance
+  return std::upper_bound(SIGNIFICANCE.begin(), SIGNIFICANCE.end(), tolerance, std::greater_equal<>()) -
+         SIGNIFICANCE.begin();
+}
+
+double PolylinePyramid::Tolerance(int knots) const {
+  // Count(t) <= knots <=> SIGNIFICANCE[knots] <= t
+  knots = std::max(knots, 2);
+  return knots < Size() ? SIGNIFICANCE[knots] : -std::numeric_limits<double>::infinity();
+}
+
+Polyline2D PolylinePyramid::At(double tolerance, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("PolylinePyramid::At");
+  std::vector<int> kept(RANKING.begin(), RANKING.begin() + Count(tolerance));
+  std::sort(kept.begin(), kept.end());
+
+  std::vector<Point2D> knots;
+  knots.reserve(kept.size());
+  for (int i : kept) {
+    knots.push_back(KNOTS[i]);
+  }
+  return Polyline2D::Make(std::move(knots), decimal_precision);
+}
+
+}  // namespace geompp
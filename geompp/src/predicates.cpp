@@ -0,0 +1,225 @@
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace geompp {
+
+namespace {
+
+constexpr double EPSILON = std::numeric_limits<double>::epsilon() / 2;  // 2^-53
+constexpr double CCW_ERRBOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+constexpr double ICC_ERRBOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+// sum of non-overlapping components, by increasing magnitude, zeros removed
+using Expansion = std::vector<double>;
+
+inline void two_sum(double a, double b, double& x, double& y) {
+  x = a + b;
+  double b_virt = x - a;
+  double a_virt = x - b_virt;
+  y = (a - a_virt) + (b - b_virt);
+}
+
+inline void fast_two_sum(double a, double b, double& x, double& y) {  // |a| >= |b|
+  x = a + b;
+  y = b - (x - a);
+}
+
+inline void two_product(double a, double b, double& x, double& y) {
+  x = a * b;
+  y = std::fma(a, b, -x);
+}
+
+Expansion difference(double a, double b) {
+  double x, y;
+  two_sum(a, -b, x, y);
+  Expansion e;
+  if (y != 0) {
+    e.push_back(y);
+  }
+  e.push_back(x);
+  return e;
+}
+
+Expansion grow(Expansion const& e, double b) {
+  Expansion h;
+  h.reserve(e.size() + 1);
+  double q = b;
+  double hh;
+  for (double ei : e) {
+    two_sum(q, ei, q, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+  }
+  if (q != 0 || h.empty()) {
+    h.push_back(q);
+  }
+  return h;
+}
+
+Expansion sum(Expansion const& e, Expansion const& f) {
+  Expansion h = e;
+  for (double fi : f) {
+    h = grow(h, fi);
+  }
+  return h;
+}
+
+Expansion negate(Expansion e) {
+  for (double& ei : e) {
+    ei = -ei;
+  }
+  return e;
+}
+
+Expansion scale(Expansion const& e, double b) {
+  Expansion h;
+  h.reserve(2 * e.size());
+  double q, hh, product_hi, product_lo, s;
+  two_product(e[0], b, q, hh);
+  if (hh != 0) {
+    h.push_back(hh);
+  }
+  for (int i = 1; i < e.size(); ++i) {
+    two_product(e[i], b, product_hi, product_lo);
+    two_sum(q, product_lo, s, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+    fast_two_sum(product_hi, s, q, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+  }
+  if (q != 0 || h.empty()) {
+    h.push_back(q);
+  }
+  return h;
+}
+
+Expansion product(Expansion const& e, Expansion const& f) {
+  Expansion h{0.0};
+  for (double fi : f) {
+    h = sum(h, scale(e, fi));
+  }
+  return h;
+}
+
+// the largest component has the sign of the whole expansion
+inline double estimate(Expansion const& e) { return e.back(); }
+
+double orient2d_exact(Point2D const& a, Point2D const& b, Point2D const& c) {
+  auto acx = difference(a.x(), c.x());
+  auto acy = difference(a.y(), c.y());
+  auto bcx = difference(b.x(), c.x());
+  auto bcy = difference(b.y(), c.y());
+  return estimate(sum(product(acx, bcy), negate(product(acy, bcx))));
+}
+
+double incircle_exact(Point2D const& a, Point2D const& b, Point2D const& c, Point2D const& d) {
+  auto adx = difference(a.x(), d.x());
+  auto ady = difference(a.y(), d.y());
+  auto bdx = difference(b.x(), d.x());
+  auto bdy = difference(b.y(), d.y());
+  auto cdx = difference(c.x(), d.x());
+  auto cdy = difference(c.y(), d.y());
+
+  auto bc = sum(product(bdx, cdy), negate(product(cdx, bdy)));
+  auto ca = sum(product(cdx, ady), negate(product(adx, cdy)));
+  auto ab = sum(product(adx, bdy), negate(product(bdx, ady)));
+
+  auto alift = sum(product(adx, adx), product(ady, ady));
+  auto blift = sum(product(bdx, bdx), product(bdy, bdy));
+  auto clift = sum(product(cdx, cdx), product(cdy, cdy));
+
+  return estimate(sum(sum(product(alift, bc), product(blift, ca)), product(clift, ab)));
+}
+
+// the point q, collinear with [p0, p1], is within its bounding box
+inline bool within_box(Point2D const& p0, Point2D const& p1, Point2D const& q) {
+  return std::min(p0.x(), p1.x()) <= q.x() && q.x() <= std::max(p0.x(), p1.x()) && std::min(p0.y(), p1.y()) <= q.y() &&
+         q.y() <= std::max(p0.y(), p1.y());
+}
+
+}  // namespace
+
+#pragma region Robust Predicates
+
+double orient2d(Point2D const& a, Point2D const& b, Point2D const& c) {
+  double det_left = (a.x() - c.x()) * (b.y() - c.y());
+  double det_right = (a.y() - c.y()) * (b.x() - c.x());
+  double det = det_left - det_right;
+
+  double det_sum;
+  if (det_left > 0) {
+    if (det_right <= 0) {
+      return det;
+    }
+    det_sum = det_left + det_right;
+  } else if (det_left < 0) {
+    if (det_right >= 0) {
+      return det;
+    }
+    det_sum = -det_left - det_right;
+  } else {
+    return det;
+  }
+
+  double err_bound = CCW_ERRBOUND * det_sum;
+  if (det >= err_bound || -det >= err_bound) {
+    return det;
+  }
+  return orient2d_exact(a, b, c);
+}
+
+double incircle(Point2D const& a, Point2D const& b, Point2D const& c, Point2D const& d) {
+  double adx = a.x() - d.x(), ady = a.y() - d.y();
+  double bdx = b.x() - d.x(), bdy = b.y() - d.y();
+  double cdx = c.x() - d.x(), cdy = c.y() - d.y();
+
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+  double alift = adx * adx + ady * ady;
+  double blift = bdx * bdx + bdy * bdy;
+  double clift = cdx * cdx + cdy * cdy;
+
+  double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+  double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift + (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                     (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+
+  double err_bound = ICC_ERRBOUND * permanent;
+  if (det > err_bound || -det > err_bound) {
+    return det;
+  }
+  return incircle_exact(a, b, c, d);
+}
+
+int orientation(Point2D const& a, Point2D const& b, Point2D const& c) {
+  double det = orient2d(a, b, c);
+  return (det > 0) - (det < 0);
+}
+
+bool segments_intersect(Point2D const& p0, Point2D const& p1, Point2D const& q0, Point2D const& q1) {
+  int o1 = orientation(p0, p1, q0);
+  int o2 = orientation(p0, p1, q1);
+  int o3 = orientation(q0, q1, p0);
+  int o4 = orientation(q0, q1, p1);
+
+  if (o1 != o2 && o3 != o4) {
+    return true;
+  }
+
+  // collinear end points
+  return (o1 == 0 && within_box(p0, p1, q0)) || (o2 == 0 && within_box(p0, p1, q1)) ||
+         (o3 == 0 && within_box(q0, q1, p0)) || (o4 == 0 && within_box(q0, q1, p1));
+}
+
+#pragma endregion
+
+}  // namespace geompp
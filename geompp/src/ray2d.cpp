@@ -3,7 +3,12 @@
 #include "constants.hpp"
 #include "line2d.hpp"
 #include "line_segment2d.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
 #include "utils.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
 #include <format>
 #include <fstream>
@@ -15,27 +20,29 @@ namespace geompp {
 #pragma region Constructors
 
 Ray2D Ray2D::Make(Point2D const& p0, Vector2D const& dir, int decimal_precision) {
-  if (round_to(dir.Length(), decimal_precision) == 0) {
+  auto ray = TryMake(p0, dir, decimal_precision);
+  if (!ray) {
     throw std::runtime_error(std::format("the direction is almost zero with {} decimals precision", decimal_precision));
   }
-  return {p0, dir};
+  return *std::move(ray);
 }
 
-Ray2D::Ray2D(Point2D const& orig, Vector2D const& dir) : ORIGIN(orig), DIR(dir.Normalize()) {}
-
-Ray2D& Ray2D::operator=(Ray2D const& other) {
-  if (this != &other) {
-    *this = other;
+expected<Ray2D, GeomError> Ray2D::TryMake(Point2D const& p0, Vector2D const& dir, int decimal_precision) {
+  GEOMPP_PROFILE_SCOPE("Ray2D::Make");
+  if (Tolerance(decimal_precision).IsZero(dir.Length())) {
+    return unexpected(GeomError::ZERO_DIRECTION);
   }
-  return *this;
+  return Ray2D(p0, dir);
 }
 
+Ray2D::Ray2D(Point2D const& orig, Vector2D const& dir) : ORIGIN(orig), DIR(dir.Normalize()) {}
+
 bool Ray2D::IsAhead(Point2D const& point, int decimal_precision) const {
-  return round_to(DIR.Dot(point - ORIGIN), decimal_precision) >= 0.0;
+  return Tolerance(decimal_precision).IsNonNegative(DIR.Dot(point - ORIGIN));
 }
 
 bool Ray2D::IsBehind(Point2D const& point, int decimal_precision) const {
-  return round_to(DIR.Dot(point - ORIGIN), decimal_precision) < 0.0;
+  return Tolerance(decimal_precision).IsNegative(DIR.Dot(point - ORIGIN));
 }
 
 Line2D Ray2D::ToLine(int decimal_precision) const { return Line2D::Make(ORIGIN, DIR, decimal_precision); }
@@ -60,7 +67,7 @@ bool operator==(Ray2D const& lhs, Ray2D const& rhs) { return lhs.AlmostEquals(rh
 #pragma region Geometrical Operations
 
 bool Ray2D::Contains(Point2D const& point, int decimal_precision) const {
-  return round_to((point - ORIGIN).Cross(DIR), decimal_precision) == 0.0 && IsAhead(point, decimal_precision);
+  return Tolerance(decimal_precision).IsZero((point - ORIGIN).Cross(DIR)) && IsAhead(point, decimal_precision);
 }
 
 bool Ray2D::Intersects(Line2D const& line, int decimal_precision) const {
@@ -76,12 +83,15 @@ bool Ray2D::Intersects(LineSegment2D const& segment, int decimal_precision) cons
 }
 
 Ray2D::ReturnSet Ray2D::Intersection(Line2D const& line, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Ray2D::Intersection");
+  Tolerance tol(decimal_precision);
   auto u = DIR;
   auto v = line.Direction();
   auto vp = v.Perp();
   auto w = (ORIGIN - line.First());
 
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (tol.IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("Ray2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
@@ -96,6 +106,8 @@ Ray2D::ReturnSet Ray2D::Intersection(Line2D const& line, int decimal_precision)
 }
 
 Ray2D::ReturnSet Ray2D::Intersection(Ray2D const& other, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Ray2D::Intersection");
+  Tolerance tol(decimal_precision);
   auto u = DIR;
   auto up = u.Perp();  // equivalent (calc, on the other side)
   auto v = other.DIR;
@@ -103,7 +115,8 @@ Ray2D::ReturnSet Ray2D::Intersection(Ray2D const& other, int decimal_precision)
   auto w = (ORIGIN - other.ORIGIN);
 
   // testing on this ray
-  if (round_to(u * vp, decimal_precision) == 0.0) {
+  if (tol.IsZero(u * vp)) {
+    GEOMPP_PROFILE_COUNT("Ray2D::Intersection parallel");
     return std::nullopt;
   }
   double t = (-w * vp) / (u * vp);
@@ -113,7 +126,7 @@ Ray2D::ReturnSet Ray2D::Intersection(Ray2D const& other, int decimal_precision)
   }
 
   // testing on the other ray
-  if (round_to(v * up, decimal_precision) == 0.0) {
+  if (tol.IsZero(v * up)) {
     return std::nullopt;
   }
   double s = (w * up) / (v * up);  // equivalent (calc on the other side)
@@ -126,6 +139,7 @@ Ray2D::ReturnSet Ray2D::Intersection(Ray2D const& other, int decimal_precision)
 }
 
 Ray2D::ReturnSet Ray2D::Intersection(LineSegment2D const& segment, int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("Ray2D::Intersection");
   return segment.Intersection(*this, decimal_precision);
 }
 
@@ -134,54 +148,36 @@ Ray2D::ReturnSet Ray2D::Intersection(LineSegment2D const& segment, int decimal_p
 #pragma region Formatting
 
 std::string Ray2D::ToWkt(int decimal_precision) const {
-  return std::format("RAY ({} {}, {} {})", round_to(ORIGIN.x(), decimal_precision),
-                     round_to(ORIGIN.y(), decimal_precision), round_to(DIR.x(), decimal_precision),
-                     round_to(DIR.y(), decimal_precision));
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
 }
 
 Ray2D Ray2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_p1, end_p2;
-
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "RAY") {
-      throw std::runtime_error("geometry name");
-    }
-
-    end_p1 = wkt.substr(end_gtype + 1).find(',');
-    if (end_p1 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p1 = wkt.substr(end_gtype + 1, end_p1);
-
-    auto nums_p1 = geompp::tokenize_to_doubles(s_nums_p1);
-    if (nums_p1.size() != 2) {
-      throw std::runtime_error("numbers p1");
-    }
-
-    end_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1).find(')');
-    if (end_p2 == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums_p2 = wkt.substr(end_gtype + 1 + end_p1 + 1, end_p2);
-
-    auto nums_p2 = geompp::tokenize_to_doubles(s_nums_p2);
-    if (nums_p2.size() != 2) {
-      throw std::runtime_error("numbers p2");
-    }
-
-    return Make(Point2D{nums_p1[0], nums_p1[1]}, Vector2D{nums_p2[0], nums_p2[1]});
-
-  } catch (...) {
+  auto ray = TryFromWkt(wkt);
+  if (!ray) {
+    GEOMPP_PROFILE_COUNT("Ray2D::FromWkt failed");
     std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(ray.error())));
   }
+  return *std::move(ray);
+}
 
-  throw std::runtime_error("failed to parse WKT");
+expected<Ray2D, GeomError> Ray2D::TryFromWkt(std::string_view wkt) {
+  WktReader reader(wkt, false);
+  reader.Tag("RAY");
+  reader.Expect('(');
+  auto origin = reader.Point();
+  reader.Expect(',');
+  auto direction = reader.Vector();
+  reader.Expect(')');
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  return TryMake(origin, direction);
 }
 
 void Ray2D::ToFile(std::string const& path, int decimal_precision) const {
@@ -236,6 +232,29 @@ Ray2D Ray2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+std::vector<std::uint8_t> Ray2D::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  Point2D points[] = {ORIGIN, ORIGIN + DIR};
+  writer.LineString(points);
+  return writer.Release();
+}
+
+Ray2D Ray2D::FromWkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  auto points = reader.LineString();
+  reader.End();
+  if (points.size() != 2) {
+    throw std::runtime_error(std::format("a ray has 2 points, not {}", points.size()));
+  }
+  return Make(points[0], points[1] - points[0], decimal_precision);
+}
+
+void Ray2D::ToWkbFile(std::string const& path, Endian endian) const { write_wkb_file(path, ToWkb(endian)); }
+
+Ray2D Ray2D::FromWkbFile(std::string const& path, int decimal_precision) {
+  return FromWkb(read_wkb_file(path), decimal_precision);
+}
+
 #pragma endregion
 
 }  // namespace geompp
@@ -0,0 +1,257 @@
+#include "rtree.hpp"
+
+#include "line2d.hpp"
+#include "ray2d.hpp"
+#include "utils.hpp"
+#include "vector2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+namespace geompp {
+
+namespace {
+
+double reach_of(LineSegment2D const& segment) { return segment_reach(segment.Length()); }
+
+double reach_of(Polyline2D const& polyline) {
+  double reach = 0;
+  for (auto const& segment : polyline.Segments()) {
+    reach = std::max(reach, reach_of(segment));
+  }
+  return reach;
+}
+
+// Sort-Tile-Recursive order of the boxes: by x into slices of about sqrt(N / node_size) nodes each, then by y
+// within each slice (ties broken by index, so the tree is the same on every platform)
+std::vector<int> str_order(std::vector<BoundingBox2D> const& boxes, int node_size) {
+  int n = boxes.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+
+  auto by_x = [&boxes](int a, int b) {
+    return std::make_pair(boxes[a].MinX() + boxes[a].MaxX(), a) < std::make_pair(boxes[b].MinX() + boxes[b].MaxX(), b);
+  };
+  auto by_y = [&boxes](int a, int b) {
+    return std::make_pair(boxes[a].MinY() + boxes[a].MaxY(), a) < std::make_pair(boxes[b].MinY() + boxes[b].MaxY(), b);
+  };
+
+  std::sort(order.begin(), order.end(), by_x);
+  int num_nodes = (n + node_size - 1) / node_size;
+  int slice_size = static_cast<int>(std::ceil(std::sqrt(num_nodes))) * node_size;
+  for (int s = 0; s < n; s += slice_size) {
+    std::sort(order.begin() + s, order.begin() + std::min(s + slice_size, n), by_y);
+  }
+  return order;
+}
+
+}  // namespace
+
+#pragma region Constructors
+
+template <typename Geometry>
+RTree<Geometry> RTree<Geometry>::Make(std::vector<Geometry> const& items) {
+  return RTree(std::vector<Geometry>(items));
+}
+
+template <typename Geometry>
+RTree<Geometry> RTree<Geometry>::Make(std::vector<Geometry>&& items) {
+  return RTree(std::move(items));
+}
+
+template <typename Geometry>
+RTree<Geometry>::RTree(std::vector<Geometry>&& items) : ITEMS(std::move(items)) {
+  int n = ITEMS.size();
+  if (n == 0) {
+    return;
+  }
+
+  // the leaves, over the items in STR order
+  std::vector<BoundingBox2D> item_boxes;
+  item_boxes.reserve(n);
+  for (auto const& item : ITEMS) {
+    item_boxes.push_back(item.BoundingBox());
+  }
+  ENTRIES = str_order(item_boxes, NODE_SIZE);
+  ENTRY_BOXES.reserve(n);
+  ENTRY_REACHES.reserve(n);
+  for (int i : ENTRIES) {
+    ENTRY_BOXES.push_back(item_boxes[i]);
+    ENTRY_REACHES.push_back(reach_of(ITEMS[i]));
+  }
+
+  auto pack = [](std::vector<BoundingBox2D> const& boxes, std::vector<double> const& reaches, bool leaf) {
+    std::vector<Node> nodes;
+    for (int first = 0; first < boxes.size(); first += NODE_SIZE) {
+      int count = std::min<int>(NODE_SIZE, boxes.size() - first);
+      Node node{BoundingBox2D::Empty(), 0.0, first, count, leaf};
+      for (int i = first; i < first + count; ++i) {
+        node.box = node.box.Union(boxes[i]);
+        node.reach = std::max(node.reach, reaches[i]);
+      }
+      nodes.push_back(node);
+    }
+    return nodes;
+  };
+
+  // the levels above, each one in STR order before packing its parents, up to the root
+  std::vector<std::vector<Node>> levels{pack(ENTRY_BOXES, ENTRY_REACHES, true)};
+  while (levels.back().size() > 1) {
+    auto& level = levels.back();
+    std::vector<BoundingBox2D> level_boxes;
+    for (auto const& node : level) {
+      level_boxes.push_back(node.box);
+    }
+
+    std::vector<Node> sorted;
+    std::vector<BoundingBox2D> sorted_boxes;
+    std::vector<double> sorted_reaches;
+    for (int i : str_order(level_boxes, NODE_SIZE)) {
+      sorted.push_back(level[i]);
+      sorted_boxes.push_back(level[i].box);
+      sorted_reaches.push_back(level[i].reach);
+    }
+    level = std::move(sorted);
+    levels.push_back(pack(sorted_boxes, sorted_reaches, false));
+  }
+
+  // flat array, from the root down: the children of a node are at (offset of the level below) + first
+  int offset = 0;
+  for (int l = levels.size() - 1; l >= 0; --l) {
+    int below = offset + levels[l].size();
+    for (auto node : levels[l]) {
+      if (!node.leaf) {
+        node.first += below;
+      }
+      NODES.push_back(node);
+    }
+    offset = below;
+  }
+}
+
+template <typename Geometry>
+BoundingBox2D RTree<Geometry>::BoundingBox() const {
+  return NODES.empty() ? BoundingBox2D::Empty() : NODES[0].box;
+}
+
+#pragma endregion
+
+#pragma region Queries
+
+template <typename Geometry>
+template <typename Overlaps>
+std::vector<int> RTree<Geometry>::Candidates(Overlaps&& overlaps) const {
+  std::vector<int> found;
+  if (NODES.empty()) {
+    return found;
+  }
+
+  std::vector<int> stack{0};
+  while (!stack.empty()) {
+    auto const& node = NODES[stack.back()];
+    stack.pop_back();
+    if (!overlaps(node.box, node.reach)) {
+      continue;
+    }
+    for (int i = node.first; i < node.first + node.count; ++i) {
+      if (!node.leaf) {
+        stack.push_back(i);
+      } else if (overlaps(ENTRY_BOXES[i], ENTRY_REACHES[i])) {
+        found.push_back(ENTRIES[i]);
+      }
+    }
+  }
+
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+template <typename Geometry>
+std::vector<int> RTree<Geometry>::Window(BoundingBox2D const& window) const {
+  return Candidates([&window](BoundingBox2D const& box, double) { return box.Intersects(window); });
+}
+
+template <typename Geometry>
+std::vector<int> RTree<Geometry>::Intersecting(Line2D const& line, int decimal_precision) const {
+  auto found = Candidates([&line, decimal_precision](BoundingBox2D const& box, double reach) {
+    return box_crosses_line(widen_box(box, reach, decimal_precision), line.First(), line.Direction());
+  });
+  std::erase_if(found,
+                [this, &line, decimal_precision](int i) { return !ITEMS[i].Intersects(line, decimal_precision); });
+  return found;
+}
+
+template <typename Geometry>
+std::vector<int> RTree<Geometry>::Intersecting(Ray2D const& ray, int decimal_precision) const {
+  auto found = Candidates([&ray, decimal_precision](BoundingBox2D const& box, double reach) {
+    auto wide = widen_box(box, reach, decimal_precision);
+    return box_crosses_line(wide, ray.Origin(), ray.Direction()) && box_ahead_of_ray(wide, ray, decimal_precision);
+  });
+  std::erase_if(found, [this, &ray, decimal_precision](int i) { return !ITEMS[i].Intersects(ray, decimal_precision); });
+  return found;
+}
+
+template <typename Geometry>
+std::vector<int> RTree<Geometry>::Intersecting(LineSegment2D const& segment, int decimal_precision) const {
+  auto segment_box = widen_box(segment.BoundingBox(), segment_reach(segment.Length()), decimal_precision);
+  auto found = Candidates([&segment, &segment_box, decimal_precision](BoundingBox2D const& box, double reach) {
+    auto wide = widen_box(box, reach, decimal_precision);
+    return wide.Intersects(segment_box) && box_crosses_line(wide, segment.First(), segment.Last() - segment.First());
+  });
+  std::erase_if(found, [this, &segment, decimal_precision](int i) {
+    return !ITEMS[i].Intersects(segment, decimal_precision);
+  });
+  return found;
+}
+
+// Best first search: a queue of nodes and entries keyed by the (rounded) distance to their widened box, a lower
+// bound of the distance to the items inside, and of items keyed by their distance. An item comes out of the queue
+// only after everything that could be nearer, or as near with a smaller index.
+template <typename Geometry>
+std::vector<typename RTree<Geometry>::Neighbour> RTree<Geometry>::Nearest(Point2D const& point, int k,
+                                                                          int decimal_precision) const {
+  std::vector<Neighbour> nearest;
+  if (NODES.empty() || k <= 0) {
+    return nearest;
+  }
+
+  enum Kind { NODE, ENTRY, ITEM };
+  using Key = std::tuple<double, Kind, int>;  // distance, kind, index (in NODES, ENTRIES or ITEMS)
+  std::priority_queue<Key, std::vector<Key>, std::greater<Key>> queue;
+  auto bound = [&point, decimal_precision](BoundingBox2D const& box, double reach) {
+    return round_to(widen_box(box, reach, decimal_precision).DistanceTo(point), decimal_precision);
+  };
+
+  queue.emplace(bound(NODES[0].box, NODES[0].reach), NODE, 0);
+  while (!queue.empty() && nearest.size() < k) {
+    auto [distance, kind, i] = queue.top();
+    queue.pop();
+
+    if (kind == ITEM) {
+      nearest.push_back({i, distance});
+    } else if (kind == ENTRY) {
+      queue.emplace(ITEMS[ENTRIES[i]].DistanceTo(point, decimal_precision), ITEM, ENTRIES[i]);
+    } else {
+      auto const& node = NODES[i];
+      for (int c = node.first; c < node.first + node.count; ++c) {
+        if (node.leaf) {
+          queue.emplace(bound(ENTRY_BOXES[c], ENTRY_REACHES[c]), ENTRY, c);
+        } else {
+          queue.emplace(bound(NODES[c].box, NODES[c].reach), NODE, c);
+        }
+      }
+    }
+  }
+
+  return nearest;
+}
+
+#pragma endregion
+
+template class RTree<LineSegment2D>;
+template class RTree<Polyline2D>;
+
+}  // namespace geompp
@@ -0,0 +1,49 @@
+#include "segment_bvh.hpp"
+
+#include "stats.hpp"
+#include "vector2d.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace geompp {
+
+SegmentBVH SegmentBVH::Make(std::vector<Point2D> const& knots) {
+  GEOMPP_PROFILE_SCOPE("SegmentBVH::Make");
+  if (knots.size() < 2) {
+    throw std::runtime_error("cannot build a segment hierarchy with less than 2 knots");
+  }
+  SegmentBVH bvh;
+  bvh.NODES.reserve(2 * (knots.size() / LEAF_SIZE + 1));
+  bvh.Build(knots, 0, knots.size() - 1);
+  return bvh;
+}
+
+int SegmentBVH::Build(std::vector<Point2D> const& knots, int first, int last) {
+  int n = NODES.size();
+  NODES.push_back({BoundingBox2D::Empty(), 0.0, first, last, -1, -1});
+
+  if (last - first <= LEAF_SIZE) {
+    auto box = BoundingBox2D::Empty().Union(knots[first]);
+    double reach = 0;
+    for (int i = first; i < last; ++i) {
+      box = box.Union(knots[i + 1]);
+      double len = (knots[i + 1] - knots[i]).Length();
+      reach = std::max({reach, len, 1 / len});
+    }
+    NODES[n].box = box;
+    NODES[n].reach = reach;
+    return n;
+  }
+
+  int mid = first + (last - first) / 2;
+  int left = Build(knots, first, mid);
+  int right = Build(knots, mid, last);
+  NODES[n].left = left;
+  NODES[n].right = right;
+  NODES[n].box = NODES[left].box.Union(NODES[right].box);
+  NODES[n].reach = std::max(NODES[left].reach, NODES[right].reach);
+  return n;
+}
+
+}  // namespace geompp
@@ -0,0 +1,498 @@
+#include "segment_sweep.hpp"
+
+#include "predicates.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <unordered_set>
+#include <utility>
+
+namespace geompp {
+
+namespace {
+
+struct SweepSegment {
+  double x0, y0, x1, y1;  // (x0, y0) comes first in the sweep order (left, or bottom if vertical)
+  double slope;           // +inf for vertical segments
+};
+
+using EventPoint = std::pair<double, double>;
+
+struct Event {
+  std::vector<int> starts;
+  std::vector<int> ends;
+  std::vector<int> crossings;
+};
+
+struct SweepState {
+  std::vector<SweepSegment> segs;
+  double sx = 0, sy = 0;  // current event point
+  double eps = 0;         // tolerance to consider two segments passing by the same point of the sweep line
+  std::vector<char> at_event;  // the segments known to pass by the current event point, while they are re-inserted
+
+  // the round-off of YAt grows with the slope: a steep segment passing by the event point can be computed far from it
+  double Eps(int i) const {
+    auto const& s = segs[i];
+    return s.x0 == s.x1 ? eps : eps * std::max(1.0, std::abs(s.slope));
+  }
+
+  double YAt(int i) const {
+    auto const& s = segs[i];
+    if (s.x0 == s.x1) {
+      return std::clamp(sy, s.y0, s.y1);
+    }
+    if (at_event[i]) {
+      return sy;
+    }
+    if (sx <= s.x0) {
+      return s.y0;
+    }
+    if (sx >= s.x1) {
+      return s.y1;
+    }
+    return s.y0 + (s.y1 - s.y0) * ((sx - s.x0) / (s.x1 - s.x0));
+  }
+
+  // where the segment passes with respect to the event point: -1 below it, 0 by it (within its tolerance), +1 above it
+  int Side(int i) const {
+    if (at_event[i]) {
+      return 0;
+    }
+    double y = YAt(i);
+    return y < sy - Eps(i) ? -1 : (sy + Eps(i) < y ? 1 : 0);
+  }
+};
+
+struct SweepProbe {};  // the current event point, for lookups in the status
+
+// order of the segments on the sweep line, right after the current event point: each segment is ranked on its own, by
+// its side of the event point, then by its y on the sweep line (away from the event point) or by the slope it leaves
+// the event point with, then by its index. Comparing the y of two segments within a tolerance of each other would not
+// be transitive (a ~ b and b ~ c, but a < c), and the set needs a strict weak order
+struct StatusOrder {
+  using is_transparent = void;
+  SweepState const* state;
+
+  bool operator()(int a, int b) const {
+    if (a == b) {
+      return false;
+    }
+    int side_a = state->Side(a);
+    int side_b = state->Side(b);
+    if (side_a != side_b) {
+      return side_a < side_b;
+    }
+    if (side_a != 0) {
+      double ya = state->YAt(a);
+      double yb = state->YAt(b);
+      if (ya != yb) {
+        return ya < yb;
+      }
+    }
+    // both pass by the event point: the one with the lowest slope stays below after it
+    if (state->segs[a].slope != state->segs[b].slope) {
+      return state->segs[a].slope < state->segs[b].slope;
+    }
+    return a < b;
+  }
+  bool operator()(int a, SweepProbe) const { return state->Side(a) < 0; }
+  bool operator()(SweepProbe, int b) const { return state->Side(b) > 0; }
+};
+
+struct RawCrossing {
+  int first;
+  int second;
+  double x, y;
+};
+
+struct SweepBox {
+  double x0, y0, x1, y1;
+};
+
+// The boxes of one kind (segments or ends) and one group open across the sweep line, in an interval tree over their y
+// (a segment tree on the sorted y of their sides, and the gaps in between), that reports those overlapping a y range.
+// The boxes closed are only counted out of the tree, and dropped from its lists when these are next visited
+class OpenBoxes {
+ public:
+  OpenBoxes(std::vector<SweepBox> const& boxes, std::vector<int> const& members, std::vector<char> const& closed)
+      : boxes(&boxes), closed(&closed) {
+    for (int k : members) {
+      ys.push_back(boxes[k].y0);
+      ys.push_back(boxes[k].y1);
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    leaves = 2 * ys.size() + 1;
+    nodes.resize(2 * std::bit_ceil(static_cast<size_t>(leaves)));
+  }
+
+  void Insert(int k) { Update(1, 0, leaves - 1, Position((*boxes)[k].y0), Position((*boxes)[k].y1), k, 1); }
+
+  void Remove(int k) { Update(1, 0, leaves - 1, Position((*boxes)[k].y0), Position((*boxes)[k].y1), k, -1); }
+
+  template <typename Visitor>
+  void Query(double y0, double y1, Visitor&& visit) {
+    Visit(1, 0, leaves - 1, Position(y0), Position(y1), visit);
+  }
+
+ private:
+  struct Node {
+    std::vector<int> items;  // the boxes covering the whole range of the node, closed ones included
+    int live = 0;            // the boxes open in the subtree of the node
+  };
+
+  std::vector<SweepBox> const* boxes;
+  std::vector<char> const* closed;
+  std::vector<double> ys;
+  int leaves;
+  std::vector<Node> nodes;
+
+  // the odd positions are the y of the sides, the even ones the gaps before, in between, and after them
+  int Position(double y) const {
+    int i = std::lower_bound(ys.begin(), ys.end(), y) - ys.begin();
+    return (i < ys.size() && ys[i] == y) ? 2 * i + 1 : 2 * i;
+  }
+
+  int Update(int node, int lo, int hi, int from, int to, int k, int change) {
+    if (to < lo || hi < from) {
+      return 0;
+    }
+    if (from <= lo && hi <= to) {
+      if (change > 0) {
+        nodes[node].items.push_back(k);
+      }
+      nodes[node].live += change;
+      return change;
+    }
+    int mid = (lo + hi) / 2;
+    int changed = Update(2 * node, lo, mid, from, to, k, change);
+    changed += Update(2 * node + 1, mid + 1, hi, from, to, k, change);
+    nodes[node].live += changed;
+    return changed;
+  }
+
+  template <typename Visitor>
+  void Visit(int node, int lo, int hi, int from, int to, Visitor& visit) {
+    if (to < lo || hi < from || nodes[node].live == 0) {
+      return;
+    }
+    auto& items = nodes[node].items;
+    for (int i = 0; i < items.size();) {
+      if ((*closed)[items[i]]) {
+        items[i] = items.back();
+        items.pop_back();
+      } else {
+        visit(items[i++]);
+      }
+    }
+    if (lo < hi) {
+      int mid = (lo + hi) / 2;
+      Visit(2 * node, lo, mid, from, to, visit);
+      Visit(2 * node + 1, mid + 1, hi, from, to, visit);
+    }
+  }
+};
+
+}  // namespace
+
+#pragma region Constructors
+
+SegmentSweep::SegmentSweep(std::vector<LineSegment2D>&& segments, std::vector<int>&& groups, int num_red)
+    : SEGMENTS(std::move(segments)), GROUPS(std::move(groups)), NUM_RED(num_red) {}
+
+SegmentSweep SegmentSweep::Make(std::vector<LineSegment2D> const& segments) {
+  return SegmentSweep(std::vector<LineSegment2D>(segments), {}, segments.size());
+}
+
+SegmentSweep SegmentSweep::Make(std::vector<LineSegment2D> const& red, std::vector<LineSegment2D> const& blue) {
+  GEOMPP_PROFILE_SCOPE("SegmentSweep::Make");
+  std::vector<LineSegment2D> segments;
+  segments.reserve(red.size() + blue.size());
+  segments.insert(segments.end(), red.begin(), red.end());
+  segments.insert(segments.end(), blue.begin(), blue.end());
+
+  std::vector<int> groups(segments.size(), 0);
+  std::fill(groups.begin() + red.size(), groups.end(), 1);
+
+  return SegmentSweep(std::move(segments), std::move(groups), red.size());
+}
+
+#pragma endregion
+
+#pragma region Geometrical Operations
+
+bool SegmentSweep::Intersects(int decimal_precision) const { return !Run(decimal_precision, false, true).empty(); }
+
+bool SegmentSweep::Intersects(ExactPredicates) const { return !Run(DP_THREE, true, true).empty(); }
+
+std::vector<SegmentSweep::Crossing> SegmentSweep::Intersection(int decimal_precision) const {
+  GEOMPP_PROFILE_SCOPE("SegmentSweep::Intersection");
+  return Run(decimal_precision, false, false);
+}
+
+std::vector<SegmentSweep::Crossing> SegmentSweep::Intersection(ExactPredicates) const {
+  GEOMPP_PROFILE_SCOPE("SegmentSweep::Intersection(EXACT)");
+  return Run(DP_THREE, true, false);
+}
+
+std::vector<SegmentSweep::Crossing> SegmentSweep::Run(int decimal_precision, bool exact, bool stop_at_first) const {
+  int n = SEGMENTS.size();
+
+  SweepState state;
+  state.segs.reserve(n);
+  double extent = 1;
+  for (auto const& s : SEGMENTS) {
+    EventPoint p0{s.First().x(), s.First().y()};
+    EventPoint p1{s.Last().x(), s.Last().y()};
+    if (p1 < p0) {
+      std::swap(p0, p1);
+    }
+    auto [x0, y0] = p0;
+    auto [x1, y1] = p1;
+    double slope = (x0 == x1) ? std::numeric_limits<double>::infinity() : (y1 - y0) / (x1 - x0);
+    state.segs.push_back({x0, y0, x1, y1, slope});
+    extent = std::max({extent, std::abs(x0), std::abs(y0), std::abs(x1), std::abs(y1)});
+  }
+  state.eps = extent * 64 * std::numeric_limits<double>::epsilon();
+  state.at_event.assign(n, 0);
+
+  std::map<EventPoint, Event> queue;
+  for (int i = 0; i < n; ++i) {
+    queue[{state.segs[i].x0, state.segs[i].y0}].starts.push_back(i);
+    queue[{state.segs[i].x1, state.segs[i].y1}].ends.push_back(i);
+  }
+
+  std::set<int, StatusOrder> status(StatusOrder{&state});
+  std::vector<std::set<int, StatusOrder>::iterator> handles(n, status.end());
+
+  std::unordered_set<long long> tested;
+  std::vector<RawCrossing> found;
+
+  // final test of a pair (with the library tolerance, or the exact predicates), done once per pair
+  auto report = [&](int a, int b) {
+    if (a > b) {
+      std::swap(a, b);
+    }
+    if (!GROUPS.empty() && GROUPS[a] == GROUPS[b]) {
+      return;
+    }
+    if (!tested.insert(static_cast<long long>(a) * n + b).second) {
+      return;
+    }
+    auto inter = exact ? SEGMENTS[a].Intersection(SEGMENTS[b], EXACT)
+                       : SEGMENTS[a].Intersection(SEGMENTS[b], decimal_precision);
+    if (inter.has_value()) {
+      auto const& p = std::get<Point2D>(*inter);
+      found.push_back({a, b, p.x(), p.y()});
+    }
+  };
+
+  // neighbours on the sweep line: report them, and schedule their swap if they cross ahead of the sweep
+  auto check = [&](int a, int b) {
+    report(a, b);
+
+    // whether they cross is decided by the exact predicates: no crossing is missed or invented by round-off
+    auto const& sa = state.segs[a];
+    auto const& sb = state.segs[b];
+    Point2D a0(sa.x0, sa.y0), a1(sa.x1, sa.y1), b0(sb.x0, sb.y0), b1(sb.x1, sb.y1);
+    if (!segments_intersect(a0, a1, b0, b1)) {
+      return;
+    }
+    double ux = sa.x1 - sa.x0, uy = sa.y1 - sa.y0;
+    double vx = sb.x1 - sb.x0, vy = sb.y1 - sb.y0;
+    double den = ux * vy - uy * vx;
+    if (den == 0 || (orientation(a0, a1, b0) == 0 && orientation(a0, a1, b1) == 0)) {
+      return;  // collinear
+    }
+    double wx = sb.x0 - sa.x0, wy = sb.y0 - sa.y0;
+    double t = std::clamp((wx * vy - wy * vx) / den, 0.0, 1.0);
+    EventPoint p{sa.x0 + t * ux, sa.y0 + t * uy};
+    if (p <= EventPoint{state.sx, state.sy}) {
+      return;  // already swept
+    }
+    auto& ev = queue[p];
+    ev.crossings.push_back(a);
+    ev.crossings.push_back(b);
+  };
+
+  while (!queue.empty()) {
+    auto node = queue.extract(queue.begin());
+    state.sx = node.key().first;
+    state.sy = node.key().second;
+    Event const& ev = node.mapped();
+
+    // segments passing by the event point (ending there, or crossing there)
+    std::vector<int> through;
+    auto [lo, hi] = status.equal_range(SweepProbe{});
+    for (auto it = lo; it != hi; ++it) {
+      through.push_back(*it);
+    }
+    for (int i : ev.crossings) {
+      if (handles[i] != status.end()) {
+        through.push_back(i);
+      }
+    }
+    for (int i : ev.ends) {
+      if (handles[i] != status.end()) {
+        through.push_back(i);
+      }
+    }
+    std::sort(through.begin(), through.end());
+    through.erase(std::unique(through.begin(), through.end()), through.end());
+
+    // every segment touching the event point intersects every other
+    std::vector<int> involved(through);
+    involved.insert(involved.end(), ev.starts.begin(), ev.starts.end());
+    for (int i = 0; i < involved.size(); ++i) {
+      for (int j = i + 1; j < involved.size(); ++j) {
+        report(involved[i], involved[j]);
+      }
+    }
+    if (stop_at_first && !found.empty()) {
+      break;
+    }
+
+    // re-insert the segments that continue after the event point, in their new order
+    for (int i : through) {
+      status.erase(handles[i]);
+      handles[i] = status.end();
+    }
+    std::vector<int> reinsert;
+    for (int i : through) {
+      if (state.segs[i].x1 != state.sx || state.segs[i].y1 != state.sy) {
+        reinsert.push_back(i);
+      }
+    }
+    for (int i : ev.starts) {
+      if (state.segs[i].x1 != state.sx || state.segs[i].y1 != state.sy) {
+        reinsert.push_back(i);
+      }
+    }
+    // in the order they leave the event point, by slope, not by their round-off around it
+    for (int i : reinsert) {
+      state.at_event[i] = 1;
+    }
+    for (int i : reinsert) {
+      handles[i] = status.insert(i).first;
+    }
+
+    // test the new neighbours
+    if (reinsert.empty()) {
+      auto above = status.upper_bound(SweepProbe{});
+      if (above != status.end() && above != status.begin()) {
+        check(*std::prev(above), *above);
+      }
+    } else {
+      auto order = status.key_comp();
+      int lowest = *std::min_element(reinsert.begin(), reinsert.end(), order);
+      int highest = *std::max_element(reinsert.begin(), reinsert.end(), order);
+      if (handles[lowest] != status.begin()) {
+        check(*std::prev(handles[lowest]), lowest);
+      }
+      auto next = std::next(handles[highest]);
+      if (next != status.end()) {
+        check(highest, *next);
+      }
+    }
+    for (int i : reinsert) {
+      state.at_event[i] = 0;
+    }
+
+    if (stop_at_first && !found.empty()) {
+      break;
+    }
+  }
+
+  // With a tolerance two segments can also touch without crossing, the end of one within the tolerance of the other,
+  // and not be neighbours on the sweep line (a third one passing in between): the boxes of the ends are checked against
+  // the boxes of the segments of the other group too, in a sweep over x that keeps the boxes open in y interval trees,
+  // and closes them in the order of their right side. The boxes are widened by how far the tolerance reaches:
+  // h = 0.5 / 10^dp from the line of a segment, h * max(length, 1 / length) beyond its ends, and some slack for the
+  // rounding errors on the coordinates
+  if (!exact && !(stop_at_first && !found.empty())) {
+    double h = 0.5 / std::pow(10.0, decimal_precision);
+    std::vector<SweepBox> boxes(3 * n);  // the segments in [0, n), then the two ends of each
+    for (int i = 0; i < n; ++i) {
+      auto const& s = state.segs[i];
+      double length = SEGMENTS[i].Length();
+      double margin = h * (std::max(length, 1 / length) + 1) * (1 + 1e-9) + state.eps;
+      boxes[i] = {s.x0 - margin, std::min(s.y0, s.y1) - margin, s.x1 + margin, std::max(s.y0, s.y1) + margin};
+      boxes[n + 2 * i] = {s.x0 - margin, s.y0 - margin, s.x0 + margin, s.y0 + margin};
+      boxes[n + 2 * i + 1] = {s.x1 - margin, s.y1 - margin, s.x1 + margin, s.y1 + margin};
+    }
+
+    // one tree per kind and group: the segments of each group, then the ends of each group. Without groups the ends are
+    // checked against all the segments, else those of a group against the segments of the other one
+    int num_groups = GROUPS.empty() ? 1 : 2;
+    auto tree_of = [this, n, num_groups](int k) {
+      int segment = k < n ? k : (k - n) / 2;
+      int group = GROUPS.empty() ? 0 : GROUPS[segment];
+      return k < n ? group : num_groups + group;
+    };
+    std::vector<std::vector<int>> members(2 * num_groups);
+    for (int k = 0; k < 3 * n; ++k) {
+      members[tree_of(k)].push_back(k);
+    }
+    std::vector<char> closed(3 * n, 0);
+    std::vector<OpenBoxes> open;
+    for (auto const& m : members) {
+      open.emplace_back(boxes, m, closed);
+    }
+    members.clear();
+
+    std::vector<int> order(3 * n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&boxes](int l, int r) { return boxes[l].x0 < boxes[r].x0; });
+
+    // the open boxes by their right side, the first to close on top
+    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<>> closing;
+    for (int k : order) {
+      auto const& box = boxes[k];
+      while (!closing.empty() && closing.top().first < box.x0) {
+        int j = closing.top().second;
+        closing.pop();
+        closed[j] = 1;
+        open[tree_of(j)].Remove(j);
+      }
+
+      bool is_end = k >= n;
+      open[2 * num_groups - 1 - tree_of(k)].Query(box.y0, box.y1, [&](int j) {
+        int end = is_end ? k : j;
+        int segment = is_end ? j : k;
+        if ((end - n) / 2 != segment) {
+          report((end - n) / 2, segment);
+        }
+      });
+      open[tree_of(k)].Insert(k);
+      closing.push({box.x1, k});
+
+      if (stop_at_first && !found.empty()) {
+        break;
+      }
+    }
+  }
+
+  std::sort(found.begin(), found.end(), [](RawCrossing const& l, RawCrossing const& r) {
+    return std::make_pair(l.first, l.second) < std::make_pair(r.first, r.second);
+  });
+
+  std::vector<Crossing> crossings;
+  crossings.reserve(found.size());
+  for (auto const& c : found) {
+    int second = GROUPS.empty() ? c.second : c.second - NUM_RED;
+    crossings.push_back({c.first, second, Point2D(c.x, c.y)});
+  }
+  return crossings;
+}
+
+#pragma endregion
+
+}  // namespace geompp
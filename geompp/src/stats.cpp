@@ -0,0 +1,149 @@
+#include "stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <map>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define GEOMPP_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define GEOMPP_RDTSC
+#endif
+
+namespace geompp::stats {
+
+namespace {
+
+constexpr int MAX_PROBES = 512;
+
+// the counters of one thread, written by it only (relaxed load and store, no locked instruction), read by Snapshot
+struct Counters {
+  std::atomic<std::uint64_t> calls[MAX_PROBES] = {};
+  std::atomic<std::uint64_t> cycles[MAX_PROBES] = {};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<char const*> names;  // of the probes, by index
+  std::vector<Counters*> threads;  // alive
+  Counters finished;               // the sums of the threads that ended
+};
+
+// never destroyed: threads may end (and fold their counters) after the static destructors ran
+Registry& registry() {
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+void add_to(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct ThreadCounters {
+  Counters counters;
+
+  ThreadCounters() {
+    std::lock_guard lock(registry().mutex);
+    registry().threads.push_back(&counters);
+  }
+  ~ThreadCounters() {
+    auto& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (int i = 0; i < MAX_PROBES; ++i) {
+      add_to(r.finished.calls[i], counters.calls[i].load(std::memory_order_relaxed));
+      add_to(r.finished.cycles[i], counters.cycles[i].load(std::memory_order_relaxed));
+    }
+    std::erase(r.threads, &counters);
+  }
+};
+
+Counters& local_counters() {
+  thread_local ThreadCounters local;
+  return local.counters;
+}
+
+}  // namespace
+
+std::uint64_t cycles() {
+#ifdef GEOMPP_RDTSC
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+Probe::Probe(char const* name) {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  if (r.names.size() < MAX_PROBES) {
+    INDEX = static_cast<int>(r.names.size());
+    r.names.push_back(name);
+  } else {
+    INDEX = -1;
+  }
+}
+
+void Probe::Add(std::uint64_t cycles) const {
+  if (INDEX < 0) {
+    return;
+  }
+  auto& counters = local_counters();
+  add_to(counters.calls[INDEX], 1);
+  add_to(counters.cycles[INDEX], cycles);
+}
+
+std::vector<Entry> Snapshot() {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  std::map<std::string, Entry> by_name;
+  for (int i = 0; i < r.names.size(); ++i) {
+    std::uint64_t calls = r.finished.calls[i].load(std::memory_order_relaxed);
+    std::uint64_t cycles = r.finished.cycles[i].load(std::memory_order_relaxed);
+    for (auto const* thread : r.threads) {
+      calls += thread->calls[i].load(std::memory_order_relaxed);
+      cycles += thread->cycles[i].load(std::memory_order_relaxed);
+    }
+    if (calls > 0) {
+      auto& entry = by_name[r.names[i]];
+      entry.name = r.names[i];
+      entry.calls += calls;
+      entry.cycles += cycles;
+    }
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(by_name.size());
+  for (auto& [name, entry] : by_name) {
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+void Reset() {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  for (int i = 0; i < MAX_PROBES; ++i) {
+    r.finished.calls[i].store(0, std::memory_order_relaxed);
+    r.finished.cycles[i].store(0, std::memory_order_relaxed);
+    for (auto* thread : r.threads) {
+      thread->calls[i].store(0, std::memory_order_relaxed);
+      thread->cycles[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::string Dump(std::vector<Entry> const& entries) {
+  std::string out = std::format("{:<48} {:>14} {:>18} {:>12}\n", "name", "calls", "cycles", "cycles/call");
+  for (auto const& entry : entries) {
+    out += std::format("{:<48} {:>14} {:>18} {:>12.1f}\n", entry.name, entry.calls, entry.cycles,
+                       entry.calls > 0 ? static_cast<double>(entry.cycles) / entry.calls : 0.0);
+  }
+  return out;
+}
+
+}  // namespace geompp::stats
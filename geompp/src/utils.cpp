@@ -1,5 +1,7 @@
 #include "utils.hpp"
 
+#include "tolerance.hpp"
+
 #include <algorithm>
 #include <cctype>
 #include <cmath>
@@ -11,16 +13,11 @@
 namespace geompp {
 
 double round_to(double x, int decimal_precision) {
-  double exp = pow(10, decimal_precision);
+  double exp = power_of_ten(decimal_precision);
   return round(x * exp) / exp;
 }
 
-int sign(double x, int decimal_precision) {
-  if (round_to(x, decimal_precision) >= 0) {
-    return 1;
-  }
-  return -1;
-}
+int sign(double x, int decimal_precision) { return Tolerance(decimal_precision).Sign(x); }
 
 std::string trim(std::string s) {
   auto not_space = [](unsigned char c) { return !std::isspace(c); };
@@ -1,6 +1,11 @@
 #include "vector2d.hpp"
 
 #include "point2d.hpp"
+#include "stats.hpp"
+#include "tolerance.hpp"
+#include "wkb.hpp"
+#include "wkt_reader.hpp"
+#include "wkt_writer.hpp"
 
 #include <cmath>
 #include <format>
@@ -9,97 +14,50 @@
 
 namespace geompp {
 
-Vector2D::Vector2D(double x, double y) : X(x), Y(y) {}
-
-Vector2D& Vector2D::operator=(Vector2D const& other) {
-  if (this != &other) {
-    *this = other;
-  }
-  return *this;
-}
-
-Point2D Vector2D::ToPoint() { return Point2D(X, Y); }
-
-double Vector2D::Length() const { return sqrt(pow(X, 2) + pow(Y, 2)); }
-
-bool Vector2D::AlmostEquals(Vector2D const& other, int decimal_precision) const {
-  return round_to(X - other.X, decimal_precision) == 0 && round_to(Y - other.Y, decimal_precision) == 0;
+template <Scalar T>
+bool BasicVector2D<T>::AlmostEquals(BasicVector2D const& other, int decimal_precision) const {
+  Tolerance tol(decimal_precision);
+  return tol.IsZero(X - other.X) && tol.IsZero(Y - other.Y);
 }
 
-double Vector2D::Dot(Vector2D const& v) const { return (X * v.X + Y * v.Y); }
-
-double Vector2D::Cross(Vector2D const& v) const { return (-Y * v.X + X * v.Y); }
-
-Vector2D Vector2D::Perp() const { return {-Y, X}; }
-
-Vector2D Vector2D::Normalize() const {
-  double len = Length();
-  return {X / len, Y / len};
-}
-
-#pragma region Operator Overloading
-
-Vector2D Vector2D::operator-() { return {-X, -Y}; }
-
-bool operator==(Vector2D const& lhs, Vector2D const& rhs) { return lhs.AlmostEquals(rhs); }
-
-Vector2D operator+(Vector2D const& lhs, Vector2D const& rhs) { return {lhs.x() + rhs.x(), lhs.y() + rhs.y()}; }
-
-Vector2D operator-(Vector2D const& lhs, Vector2D const& rhs) { return {lhs.x() - rhs.x(), lhs.y() - rhs.y()}; }
-
-Point2D operator+(Vector2D const& lhs, Point2D const& rhs) { return {lhs.x() + rhs.x(), lhs.y() + rhs.y()}; }
-
-Vector2D operator*(Vector2D const& lhs, double a) { return {lhs.x() * a, lhs.y() * a}; }
-
-Vector2D operator*(double a, Vector2D const& rhs) { return rhs * a; }
-
-double operator*(Vector2D const& lhs, Vector2D const& rhs) { return lhs.Dot(rhs); }
-
-Vector2D operator/(Vector2D const& lhs, double a) { return Vector2D(lhs.x() / a, lhs.y() / a); }
-
-#pragma endregion
-
 #pragma region Formatting
 
-std::string Vector2D::ToWkt(int decimal_precision) const {
-  return std::format("VECTOR ({} {})", round_to(X, decimal_precision), round_to(Y, decimal_precision));
+template <Scalar T>
+std::string BasicVector2D<T>::ToWkt(int decimal_precision) const {
+  std::string wkt;
+  WktWriter(StringSink(wkt), decimal_precision).Write(*this);
+  return wkt;
 }
 
-Vector2D Vector2D::FromWkt(std::string const& wkt) {
-  try {
-    std::size_t end_gtype, end_nums;
-
-    end_gtype = wkt.find('(');
-    if (end_gtype == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-
-    std::string g_type = geompp::to_upper(geompp::trim(wkt.substr(0, end_gtype)));
-    if (g_type != "VECTOR") {
-      throw std::runtime_error("geometry name");
-    }
-
-    end_nums = wkt.substr(end_gtype + 1).find(')');
-    if (end_nums == std::string::npos) {
-      throw std::runtime_error("brakets");
-    }
-    std::string s_nums = wkt.substr(end_gtype + 1, end_nums);
-
-    auto nums = geompp::tokenize_to_doubles(s_nums);
-    if (nums.size() != 2) {
-      throw std::runtime_error("numbers");
-    }
-
-    return {nums[0], nums[1]};
-
-  } catch (...) {
+template <Scalar T>
+BasicVector2D<T> BasicVector2D<T>::FromWkt(std::string const& wkt) {
+  auto vector = TryFromWkt(wkt);
+  if (!vector) {
+    GEOMPP_PROFILE_COUNT("Vector2D::FromWkt failed");
     std::cerr << "bad format of str " << wkt << std::endl;  // TODO: replace with logger lib
+    throw std::runtime_error(std::format("failed to parse WKT: {}", to_string(vector.error())));
   }
+  return *std::move(vector);
+}
 
-  throw std::runtime_error("failed to parse WKT");
+template <Scalar T>
+expected<BasicVector2D<T>, GeomError> BasicVector2D<T>::TryFromWkt(std::string_view wkt) {
+  WktReader reader(wkt, false);
+  reader.Tag("VECTOR");
+  reader.Expect('(');
+  auto vector = reader.Vector();
+  reader.Expect(')');
+  reader.End();
+
+  if (reader.Failed()) {
+    return unexpected(GeomError::BAD_WKT);
+  }
+
+  return BasicVector2D(vector);
 }
 
-void Vector2D::ToFile(std::string const& path, int decimal_precision) const {
+template <Scalar T>
+void BasicVector2D<T>::ToFile(std::string const& path, int decimal_precision) const {
   try {
     std::string content = ToWkt(decimal_precision);
 
@@ -120,7 +78,8 @@ void Vector2D::ToFile(std::string const& path, int decimal_precision) const {
   }
 }
 
-Vector2D Vector2D::FromFile(std::string const& path) {
+template <Scalar T>
+BasicVector2D<T> BasicVector2D<T>::FromFile(std::string const& path) {
   try {
     std::string content;
 
@@ -151,6 +110,30 @@ Vector2D Vector2D::FromFile(std::string const& path) {
   throw std::runtime_error("failed to parse WKT");
 }
 
+template <Scalar T>
+std::vector<std::uint8_t> BasicVector2D<T>::ToWkb(Endian endian) const {
+  WkbWriter writer(endian);
+  writer.Point({X, Y});
+  return writer.Release();
+}
+
+template <Scalar T>
+BasicVector2D<T> BasicVector2D<T>::FromWkb(std::span<std::uint8_t const> wkb) {
+  WkbReader reader(wkb);
+  auto point = reader.Point();
+  reader.End();
+  return {static_cast<T>(point.x()), static_cast<T>(point.y())};
+}
+
+template <Scalar T>
+void BasicVector2D<T>::ToWkbFile(std::string const& path, Endian endian) const { write_wkb_file(path, ToWkb(endian)); }
+
+template <Scalar T>
+BasicVector2D<T> BasicVector2D<T>::FromWkbFile(std::string const& path) { return FromWkb(read_wkb_file(path)); }
+
 #pragma endregion
 
+template class BasicVector2D<double>;
+template class BasicVector2D<float>;
+
 }  // namespace geompp
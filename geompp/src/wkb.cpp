@@ -0,0 +1,299 @@
+#include "wkb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace geompp {
+
+namespace {
+
+enum WkbType : std::uint32_t {
+  WKB_POINT = 1,
+  WKB_LINESTRING = 2,
+  WKB_POLYGON = 3,
+  WKB_MULTIPOINT = 4,
+  WKB_MULTILINESTRING = 5
+};
+
+constexpr Endian NATIVE = std::endian::native == std::endian::little ? Endian::LITTLE : Endian::BIG;
+
+template <typename T>
+T byteswap(T value) {
+  auto bytes = std::bit_cast<std::array<std::uint8_t, sizeof(T)>>(value);
+  std::reverse(bytes.begin(), bytes.end());
+  return std::bit_cast<T>(bytes);
+}
+
+}  // namespace
+
+#pragma region Writer
+
+WkbWriter::WkbWriter(Endian endian) : ENDIAN(endian) {}
+
+void WkbWriter::Write(std::uint32_t n) {
+  if (ENDIAN != NATIVE) {
+    n = byteswap(n);
+  }
+  auto bytes = std::bit_cast<std::array<std::uint8_t, 4>>(n);
+  BYTES.insert(BYTES.end(), bytes.begin(), bytes.end());
+}
+
+void WkbWriter::Write(double x) {
+  auto n = std::bit_cast<std::uint64_t>(x);
+  if (ENDIAN != NATIVE) {
+    n = byteswap(n);
+  }
+  auto bytes = std::bit_cast<std::array<std::uint8_t, 8>>(n);
+  BYTES.insert(BYTES.end(), bytes.begin(), bytes.end());
+}
+
+void WkbWriter::Header(std::uint32_t type) {
+  BYTES.push_back(static_cast<std::uint8_t>(ENDIAN));
+  Write(type);
+}
+
+void WkbWriter::Point(Point2D const& point) {
+  Header(WKB_POINT);
+  Write(point.x());
+  Write(point.y());
+}
+
+template <Scalar T>
+void WkbWriter::WritePoints(std::span<BasicPoint2D<T> const> points) {
+  Write(static_cast<std::uint32_t>(points.size()));
+  for (auto const& point : points) {
+    Write(static_cast<double>(point.x()));
+    Write(static_cast<double>(point.y()));
+  }
+}
+
+template <Scalar T>
+void WkbWriter::LineStringOf(std::span<BasicPoint2D<T> const> points) {
+  BYTES.reserve(BYTES.size() + 9 + 16 * points.size());
+  Header(WKB_LINESTRING);
+  WritePoints(points);
+}
+
+void WkbWriter::LineString(std::span<Point2D const> points) { LineStringOf(points); }
+
+void WkbWriter::LineString(std::span<Point2Df const> points) { LineStringOf(points); }
+
+void WkbWriter::Polygon(std::span<std::span<Point2D const> const> rings) {
+  std::size_t bytes = 9;
+  for (auto const& ring : rings) {
+    bytes += 4 + 16 * ring.size();
+  }
+  BYTES.reserve(BYTES.size() + bytes);
+  Header(WKB_POLYGON);
+  Write(static_cast<std::uint32_t>(rings.size()));
+  for (auto const& ring : rings) {
+    WritePoints(ring);
+  }
+}
+
+void WkbWriter::MultiPoint(int count) {
+  Header(WKB_MULTIPOINT);
+  Write(static_cast<std::uint32_t>(count));
+}
+
+void WkbWriter::MultiLineString(int count) {
+  Header(WKB_MULTILINESTRING);
+  Write(static_cast<std::uint32_t>(count));
+}
+
+#pragma endregion
+
+#pragma region Reader
+
+WkbReader::WkbReader(std::span<std::uint8_t const> wkb) : WKB(wkb) {}
+
+void WkbReader::Need(std::size_t bytes) const {
+  if (WKB.size() - POS < bytes) {
+    throw std::runtime_error(std::format("the WKB ends at byte {}, {} more expected", WKB.size(), bytes));
+  }
+}
+
+std::uint32_t WkbReader::ReadCount() {
+  Need(4);
+  std::uint32_t n;
+  std::memcpy(&n, WKB.data() + POS, 4);
+  POS += 4;
+  return SWAP ? byteswap(n) : n;
+}
+
+double WkbReader::ReadDouble() {
+  std::uint64_t n;
+  std::memcpy(&n, WKB.data() + POS, 8);  // the callers check the size of all the coordinates at once
+  POS += 8;
+  return std::bit_cast<double>(SWAP ? byteswap(n) : n);
+}
+
+void WkbReader::Header(std::uint32_t type) {
+  Need(1);
+  auto order = WKB[POS];
+  if (order != static_cast<std::uint8_t>(Endian::BIG) && order != static_cast<std::uint8_t>(Endian::LITTLE)) {
+    throw std::runtime_error(std::format("bad WKB byte order flag {} at byte {}", order, POS));
+  }
+  ++POS;
+  SWAP = static_cast<Endian>(order) != NATIVE;
+
+  auto found = ReadCount();
+  if (found != type) {
+    throw std::runtime_error(std::format("expected WKB type {}, found {} at byte {}", type, found, POS - 4));
+  }
+}
+
+Point2D WkbReader::Point() {
+  Header(WKB_POINT);
+  Need(16);
+  double x = ReadDouble();
+  return {x, ReadDouble()};
+}
+
+std::vector<Point2D> WkbReader::ReadPoints() {
+  std::size_t n = ReadCount();
+  Need(16 * n);
+
+  std::vector<Point2D> points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double x = ReadDouble();
+    points.emplace_back(x, ReadDouble());
+  }
+  return points;
+}
+
+std::vector<Point2D> WkbReader::LineString() {
+  Header(WKB_LINESTRING);
+  return ReadPoints();
+}
+
+std::vector<std::vector<Point2D>> WkbReader::Polygon() {
+  Header(WKB_POLYGON);
+  std::size_t n = ReadCount();
+  Need(4 * n);  // a count for each ring, at least
+
+  std::vector<std::vector<Point2D>> rings;
+  rings.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    rings.push_back(ReadPoints());
+  }
+  return rings;
+}
+
+int WkbReader::MultiPoint() {
+  Header(WKB_MULTIPOINT);
+  return ReadCount();
+}
+
+int WkbReader::MultiLineString() {
+  Header(WKB_MULTILINESTRING);
+  return ReadCount();
+}
+
+void WkbReader::End() {
+  if (POS != WKB.size()) {
+    throw std::runtime_error(std::format("{} bytes left after the end of the WKB", WKB.size() - POS));
+  }
+}
+
+#pragma endregion
+
+#pragma region Collections
+
+std::vector<std::uint8_t> to_wkb(std::vector<Point2D> const& points, Endian endian) {
+  WkbWriter writer(endian);
+  writer.MultiPoint(points.size());
+  for (auto const& point : points) {
+    writer.Point(point);
+  }
+  return writer.Release();
+}
+
+std::vector<std::uint8_t> to_wkb(std::vector<LineSegment2D> const& segments, Endian endian) {
+  WkbWriter writer(endian);
+  writer.MultiLineString(segments.size());
+  for (auto const& segment : segments) {
+    Point2D points[] = {segment.First(), segment.Last()};
+    writer.LineString(points);
+  }
+  return writer.Release();
+}
+
+std::vector<std::uint8_t> to_wkb(std::vector<Polyline2D> const& polylines, Endian endian) {
+  WkbWriter writer(endian);
+  writer.MultiLineString(polylines.size());
+  for (auto const& polyline : polylines) {
+    writer.LineString(polyline.Knots());
+  }
+  return writer.Release();
+}
+
+std::vector<Point2D> points_from_wkb(std::span<std::uint8_t const> wkb) {
+  WkbReader reader(wkb);
+  int n = reader.MultiPoint();
+  std::vector<Point2D> points;
+  for (int i = 0; i < n; ++i) {
+    points.push_back(reader.Point());
+  }
+  reader.End();
+  return points;
+}
+
+std::vector<LineSegment2D> segments_from_wkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  int n = reader.MultiLineString();
+  std::vector<LineSegment2D> segments;
+  for (int i = 0; i < n; ++i) {
+    auto points = reader.LineString();
+    if (points.size() != 2) {
+      throw std::runtime_error(std::format("a segment has 2 points, not {}", points.size()));
+    }
+    segments.push_back(LineSegment2D::Make(points[0], points[1], decimal_precision));
+  }
+  reader.End();
+  return segments;
+}
+
+std::vector<Polyline2D> polylines_from_wkb(std::span<std::uint8_t const> wkb, int decimal_precision) {
+  WkbReader reader(wkb);
+  int n = reader.MultiLineString();
+  std::vector<Polyline2D> polylines;
+  for (int i = 0; i < n; ++i) {
+    polylines.push_back(Polyline2D::Make(reader.LineString(), decimal_precision));
+  }
+  reader.End();
+  return polylines;
+}
+
+#pragma endregion
+
+#pragma region Files
+
+void write_wkb_file(std::string const& path, std::span<std::uint8_t const> wkb) {
+  std::ofstream out_file(path, std::ios::binary);
+  if (!out_file.is_open()) {
+    throw std::runtime_error("could not open file " + path);
+  }
+  out_file.write(reinterpret_cast<char const*>(wkb.data()), wkb.size());
+}
+
+std::vector<std::uint8_t> read_wkb_file(std::string const& path) {
+  std::ifstream in_file(path, std::ios::binary | std::ios::ate);
+  if (!in_file.is_open()) {
+    throw std::runtime_error("could not open file " + path);
+  }
+  std::vector<std::uint8_t> wkb(static_cast<std::size_t>(in_file.tellg()));
+  in_file.seekg(0, std::ios::beg);
+  in_file.read(reinterpret_cast<char*>(wkb.data()), wkb.size());
+  return wkb;
+}
+
+#pragma endregion
+
+}  // namespace geompp
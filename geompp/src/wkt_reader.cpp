@@ -0,0 +1,147 @@
+#include "wkt_reader.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+
+namespace geompp {
+
+namespace {
+
+bool is_space(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+// decimal places written in the number, e.g. "12.3400" -> 2, "5e-3" -> 3, "1.5e2" -> 0
+int decimal_places(std::string_view number) {
+  auto exp_pos = number.find_first_of("eE");
+  int exponent = 0;
+  if (exp_pos != std::string_view::npos) {
+    auto exp = number.substr(exp_pos + 1);
+    if (!exp.empty() && exp[0] == '+') {
+      exp.remove_prefix(1);
+    }
+    std::from_chars(exp.data(), exp.data() + exp.size(), exponent);
+    number = number.substr(0, exp_pos);
+  }
+
+  int places = 0;
+  auto dot = number.find('.');
+  if (dot != std::string_view::npos) {
+    auto fraction = number.substr(dot + 1);
+    auto last = fraction.find_last_not_of('0');
+    places = last == std::string_view::npos ? 0 : last + 1;
+  }
+  return std::max(0, places - exponent);
+}
+
+}  // namespace
+
+WktReader::WktReader(std::string_view wkt, bool throws) : WKT(wkt), THROWS(throws) {}
+
+void WktReader::SkipSpaces() {
+  while (POS < WKT.size() && is_space(WKT[POS])) {
+    ++POS;
+  }
+}
+
+void WktReader::Fail(std::string_view expected) {
+  if (FAILED) {
+    return;
+  }
+  FAILED = true;
+  if (THROWS) {
+    throw std::runtime_error(std::format("expected {} at position {} of the WKT", expected, POS));
+  }
+}
+
+void WktReader::Tag(std::string_view tag) {
+  if (FAILED) {
+    return;
+  }
+  SkipSpaces();
+  std::size_t begin = POS;
+  while (POS < WKT.size() && std::isalpha(static_cast<unsigned char>(WKT[POS]))) {
+    ++POS;
+  }
+  auto word = WKT.substr(begin, POS - begin);
+  if (!std::ranges::equal(word, tag, [](char a, char b) { return std::toupper(a) == std::toupper(b); })) {
+    POS = begin;
+    Fail(tag);
+  }
+}
+
+bool WktReader::Accept(char c) {
+  if (FAILED) {
+    return false;
+  }
+  SkipSpaces();
+  if (POS < WKT.size() && WKT[POS] == c) {
+    ++POS;
+    return true;
+  }
+  return false;
+}
+
+void WktReader::Expect(char c) {
+  if (!Accept(c)) {
+    Fail(std::string_view(&c, 1));
+  }
+}
+
+double WktReader::Number() {
+  if (FAILED) {
+    return 0;
+  }
+  SkipSpaces();
+  std::size_t begin = POS;
+  if (POS < WKT.size() && WKT[POS] == '+') {  // from_chars does not take the sign
+    ++POS;
+  }
+
+  double value;
+  auto [end, ec] = std::from_chars(WKT.data() + POS, WKT.data() + WKT.size(), value);
+  if (ec != std::errc() || (POS == begin + 1 && WKT[POS] == '-')) {
+    POS = begin;
+    Fail("a number");
+    return 0;
+  }
+  POS = end - WKT.data();
+  DECIMAL_PLACES = std::max(DECIMAL_PLACES, decimal_places(WKT.substr(begin, POS - begin)));
+  return value;
+}
+
+Point2D WktReader::Point() {
+  double x = Number();
+  if (!FAILED && (POS >= WKT.size() || !is_space(WKT[POS]))) {
+    Fail("a space");
+  }
+  return {x, Number()};
+}
+
+Vector2D WktReader::Vector() {
+  auto p = Point();
+  return {p.x(), p.y()};
+}
+
+std::vector<Point2D> WktReader::Points() {
+  std::vector<Point2D> points;
+  Expect('(');
+  do {
+    points.push_back(Point());
+  } while (Accept(','));  // false once failed
+  Expect(')');
+  return points;
+}
+
+void WktReader::End() {
+  if (FAILED) {
+    return;
+  }
+  SkipSpaces();
+  if (POS != WKT.size()) {
+    Fail("the end");
+  }
+}
+
+}  // namespace geompp
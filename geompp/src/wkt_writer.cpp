@@ -0,0 +1,75 @@
+#include "wkt_writer.hpp"
+
+#include "tolerance.hpp"
+#include "utils.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace geompp {
+
+namespace {
+
+int count_digits(std::uint64_t n) {
+  int digits = 1;
+  for (; n >= 10; n /= 10) {
+    ++digits;
+  }
+  return digits;
+}
+
+}  // namespace
+
+// round_to(x, d) is the double nearest to m * 10^-d, m = round(x * 10^d): when m has at most 15 digits, the digits of
+// m (without the trailing zeros) are also the shortest text of that double, written in fixed notation unless the
+// scientific one is shorter (as std::to_chars does), so only the integer m has to be printed.
+// Anything else (larger numbers, negative or large precisions, zero) goes to std::to_chars.
+int format_number(double x, int decimal_precision, char (&buf)[32]) {
+  if (decimal_precision < 0 || decimal_precision > 22) {
+    return std::to_chars(buf, buf + sizeof(buf), round_to(x, decimal_precision)).ptr - buf;
+  }
+  double scaled = std::round(x * power_of_ten(decimal_precision));
+  if (!(std::abs(scaled) < 1e15) || scaled == 0) {
+    return std::to_chars(buf, buf + sizeof(buf), scaled / power_of_ten(decimal_precision)).ptr - buf;
+  }
+
+  // scaled = ±digits * 10^exponent, digits without trailing zeros
+  std::uint64_t digits = static_cast<std::uint64_t>(std::abs(scaled));
+  int exponent = -decimal_precision;
+  for (; digits % 10 == 0; digits /= 10) {
+    ++exponent;
+  }
+  int size = count_digits(digits);
+  int fixed = exponent >= 0 ? size + exponent : (size + exponent > 0 ? size + 1 : 2 - exponent);
+  int scientific = size + (size > 1 ? 1 : 0) + 2 + (std::abs(size + exponent - 1) >= 100 ? 3 : 2);
+  if (fixed > scientific) {
+    return std::to_chars(buf, buf + sizeof(buf), scaled / power_of_ten(decimal_precision)).ptr - buf;
+  }
+
+  char* out = buf;
+  if (scaled < 0) {
+    *out++ = '-';
+  }
+  if (exponent >= 0) {  // integer: the digits, then the zeros
+    out = std::to_chars(out, buf + sizeof(buf), digits).ptr;
+    for (int i = 0; i < exponent; ++i) {
+      *out++ = '0';
+    }
+  } else if (size + exponent > 0) {  // the point between the digits
+    char* first = out;
+    out = std::to_chars(out + 1, buf + sizeof(buf), digits).ptr;
+    std::copy(first + 1, first + 1 + size + exponent, first);
+    first[size + exponent] = '.';
+  } else {  // 0.00digits
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = size + exponent; i < 0; ++i) {
+      *out++ = '0';
+    }
+    out = std::to_chars(out, buf + sizeof(buf), digits).ptr;
+  }
+  return out - buf;
+}
+
+}  // namespace geompp
@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Runs all the benchmarks declared with BENCHMARK(), as BENCHMARK_MAIN() does, and also writes the results as JSON
+// to geompp_bench.json, unless another --benchmark_out is given
+//   ./geompp_bench --benchmark_filter="Polyline2D"
+//   ./geompp_bench --benchmark_out=baseline.json --benchmark_repetitions=5
+int main(int argc, char** argv) {
+  std::vector<char*> args(argv, argv + argc);
+  std::string out = "--benchmark_out=geompp_bench.json", format = "--benchmark_out_format=json";
+  bool has_out = false;
+  for (std::string_view arg : args) {
+    has_out = has_out || arg.starts_with("--benchmark_out=");
+  }
+  if (!has_out) {
+    args.push_back(out.data());
+    args.push_back(format.data());
+  }
+
+  int size = static_cast<int>(args.size());
+  benchmark::Initialize(&size, args.data());
+  if (benchmark::ReportUnrecognizedArguments(size, args.data())) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
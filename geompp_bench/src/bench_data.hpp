@@ -0,0 +1,80 @@
+#pragma once
+
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "vector2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace geompp_bench {
+
+// the benchmarks cycle through this many inputs, not to measure a single (cached, predicted) case
+constexpr int SAMPLES = 1024;
+
+// the argument of the benchmarks taking a decimal precision
+inline void decimal_precisions(benchmark::internal::Benchmark* bench) {
+  bench->Arg(geompp::DP_THREE)->Arg(geompp::DP_SIX)->Arg(geompp::DP_NINE);
+}
+
+// the argument of the polyline benchmarks: the number of knots, 10 to 10^6, with the fitted complexity
+inline void polyline_sizes(benchmark::internal::Benchmark* bench) {
+  bench->RangeMultiplier(10)->Range(10, 1'000'000)->Complexity();
+}
+
+// random points in [-1000, 1000] x [-1000, 1000], the same at each run
+inline std::vector<geompp::Point2D> random_points(int size, unsigned seed = 1) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> coord(-1000, 1000);
+  std::vector<geompp::Point2D> points;
+  points.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    points.emplace_back(coord(gen), coord(gen));
+  }
+  return points;
+}
+
+// random segments between the random points
+inline std::vector<geompp::LineSegment2D> random_segments(int size, unsigned seed = 1) {
+  auto points = random_points(2 * size, seed);
+  std::vector<geompp::LineSegment2D> segments;
+  segments.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    segments.push_back(geompp::LineSegment2D::Make(points[2 * i], points[2 * i + 1]));
+  }
+  return segments;
+}
+
+// random walk of size knots, moving right by 0 to 2 and up or down by up to 1 at each step, built once per size
+inline geompp::Polyline2D const& random_polyline(int size, unsigned seed = 1) {
+  static std::map<std::pair<int, unsigned>, geompp::Polyline2D> cache;
+  auto found = cache.find({size, seed});
+  if (found == cache.end()) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> step(-1, 1);
+    std::vector<geompp::Point2D> points{geompp::Point2D(0, 0)};
+    while (points.size() < size) {
+      points.push_back(points.back() + geompp::Vector2D(1 + step(gen), step(gen)));
+    }
+    found = cache.emplace(std::make_pair(size, seed), geompp::Polyline2D::Make(points, geompp::DP_NINE)).first;
+  }
+  return found->second;
+}
+
+// random points around the random walk of that size
+inline std::vector<geompp::Point2D> points_around(geompp::Polyline2D const& polyline, int size, unsigned seed = 2) {
+  std::mt19937 gen(seed);
+  auto box = polyline.BoundingBox();
+  std::uniform_real_distribution<double> x(box.MinX(), box.MaxX()), y(box.MinY() - 1, box.MaxY() + 1);
+  std::vector<geompp::Point2D> points;
+  points.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    points.emplace_back(x(gen), y(gen));
+  }
+  return points;
+}
+
+}  // namespace geompp_bench
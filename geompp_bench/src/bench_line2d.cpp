@@ -0,0 +1,178 @@
+#include "bench_data.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "ray2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static std::vector<g::Line2D> random_lines(int size, unsigned seed = 1) {
+  auto points = random_points(2 * size, seed);
+  std::vector<g::Line2D> lines;
+  lines.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    lines.push_back(g::Line2D::Make(points[2 * i], points[2 * i + 1]));
+  }
+  return lines;
+}
+
+static void BM_Line2D_MakeFromPoints(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Line2D::Make(points[i % SAMPLES], points[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_MakeFromPoints)->Apply(decimal_precisions);
+
+static void BM_Line2D_MakeFromDirection(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    auto const& p = points[i % SAMPLES];
+    benchmark::DoNotOptimize(g::Line2D::Make(p, points[i % SAMPLES + 1] - p, state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_MakeFromDirection)->Apply(decimal_precisions);
+
+static void BM_Line2D_AlmostEquals(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].AlmostEquals(lines[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_AlmostEquals)->Apply(decimal_precisions);
+
+static void BM_Line2D_DistanceTo(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].DistanceTo(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_DistanceTo)->Apply(decimal_precisions);
+
+static void BM_Line2D_ProjectOnto(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].ProjectOnto(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_ProjectOnto)->Apply(decimal_precisions);
+
+static void BM_Line2D_Contains(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].Contains(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_Contains)->Apply(decimal_precisions);
+
+static void BM_Line2D_IntersectionLine(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES), others = random_lines(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].Intersection(others[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_IntersectionLine)->Apply(decimal_precisions);
+
+static void BM_Line2D_IntersectionRay(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  std::vector<g::Ray2D> rays;
+  for (auto const& line : random_lines(SAMPLES, 2)) {
+    rays.push_back(g::Ray2D::Make(line.Origin(), line.Direction()));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].Intersection(rays[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_IntersectionRay)->Apply(decimal_precisions);
+
+static void BM_Line2D_IntersectionSegment(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  auto segments = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].Intersection(segments[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_IntersectionSegment)->Apply(decimal_precisions);
+
+static void BM_Line2D_Intersects(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  auto segments = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i % SAMPLES].Intersects(segments[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Line2D_Intersects)->Apply(decimal_precisions);
+
+static void BM_Line2D_ToWkt(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i++ % SAMPLES].ToWkt(state.range(0)));
+  }
+}
+BENCHMARK(BM_Line2D_ToWkt)->Apply(decimal_precisions);
+
+static void BM_Line2D_FromWkt(benchmark::State& state) {
+  std::vector<std::string> wkts;
+  for (auto const& line : random_lines(SAMPLES)) {
+    wkts.push_back(line.ToWkt(g::DP_SIX));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Line2D::FromWkt(wkts[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Line2D_FromWkt);
+
+static void BM_Line2D_ToWkb(benchmark::State& state) {
+  auto lines = random_lines(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lines[i++ % SAMPLES].ToWkb());
+  }
+}
+BENCHMARK(BM_Line2D_ToWkb);
+
+static void BM_Line2D_FromWkb(benchmark::State& state) {
+  std::vector<std::vector<std::uint8_t>> wkbs;
+  for (auto const& line : random_lines(SAMPLES)) {
+    wkbs.push_back(line.ToWkb());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Line2D::FromWkb(wkbs[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Line2D_FromWkb);
+
+}  // namespace geompp_bench
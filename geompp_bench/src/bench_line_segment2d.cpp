@@ -0,0 +1,222 @@
+#include "bench_data.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "ray2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static void BM_LineSegment2D_Make(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::LineSegment2D::Make(points[i % SAMPLES], points[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_Make)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_AlmostEquals(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].AlmostEquals(segments[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_AlmostEquals)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_Length(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i++ % SAMPLES].Length());
+  }
+}
+BENCHMARK(BM_LineSegment2D_Length);
+
+static void BM_LineSegment2D_ToLine(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i++ % SAMPLES].ToLine(state.range(0)));
+  }
+}
+BENCHMARK(BM_LineSegment2D_ToLine)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_DistanceTo(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  auto points = random_points(SAMPLES, 3);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].DistanceTo(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_DistanceTo)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_Location(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  std::vector<g::Point2D> points;
+  for (auto const& segment : segments) {
+    points.push_back(segment.Interpolate(0.3));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Location(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_Location)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_Interpolate(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Interpolate((i % 100) / 100.0));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_Interpolate);
+
+static void BM_LineSegment2D_BoundingBox(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i++ % SAMPLES].BoundingBox());
+  }
+}
+BENCHMARK(BM_LineSegment2D_BoundingBox);
+
+static void BM_LineSegment2D_Contains(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  std::vector<g::Point2D> points;
+  for (auto const& segment : segments) {
+    points.push_back(segment.Interpolate(0.3));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Contains(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_Contains)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_IntersectionLine(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  std::vector<g::Line2D> lines;
+  for (auto const& segment : random_segments(SAMPLES, 2)) {
+    lines.push_back(segment.ToLine());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersection(lines[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_IntersectionLine)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_IntersectionRay(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  std::vector<g::Ray2D> rays;
+  for (auto const& segment : random_segments(SAMPLES, 2)) {
+    rays.push_back(g::Ray2D::Make(segment.First(), segment.Last() - segment.First()));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersection(rays[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_IntersectionRay)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_IntersectionSegment(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES), others = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersection(others[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_IntersectionSegment)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_IntersectionSegmentExact(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES), others = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersection(others[i % SAMPLES], g::EXACT));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_IntersectionSegmentExact);
+
+static void BM_LineSegment2D_Intersects(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES), others = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersects(others[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_Intersects)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_IntersectsExact(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES), others = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i % SAMPLES].Intersects(others[i % SAMPLES], g::EXACT));
+    ++i;
+  }
+}
+BENCHMARK(BM_LineSegment2D_IntersectsExact);
+
+static void BM_LineSegment2D_ToWkt(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i++ % SAMPLES].ToWkt(state.range(0)));
+  }
+}
+BENCHMARK(BM_LineSegment2D_ToWkt)->Apply(decimal_precisions);
+
+static void BM_LineSegment2D_FromWkt(benchmark::State& state) {
+  std::vector<std::string> wkts;
+  for (auto const& segment : random_segments(SAMPLES)) {
+    wkts.push_back(segment.ToWkt(g::DP_SIX));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::LineSegment2D::FromWkt(wkts[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_LineSegment2D_FromWkt);
+
+static void BM_LineSegment2D_ToWkb(benchmark::State& state) {
+  auto segments = random_segments(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(segments[i++ % SAMPLES].ToWkb());
+  }
+}
+BENCHMARK(BM_LineSegment2D_ToWkb);
+
+static void BM_LineSegment2D_FromWkb(benchmark::State& state) {
+  std::vector<std::vector<std::uint8_t>> wkbs;
+  for (auto const& segment : random_segments(SAMPLES)) {
+    wkbs.push_back(segment.ToWkb());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::LineSegment2D::FromWkb(wkbs[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_LineSegment2D_FromWkb);
+
+}  // namespace geompp_bench
@@ -0,0 +1,139 @@
+#include "bench_data.hpp"
+
+#include "point2d.hpp"
+#include "vector2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static void BM_Point2D_AlmostEquals(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(points[i % SAMPLES].AlmostEquals(points[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Point2D_AlmostEquals)->Apply(decimal_precisions);
+
+static void BM_Point2D_DistanceTo(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(points[i % SAMPLES].DistanceTo(points[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Point2D_DistanceTo)->Apply(decimal_precisions);
+
+static void BM_Point2D_Operators(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    auto const& p = points[i % SAMPLES];
+    benchmark::DoNotOptimize(2 * (p + (points[i % SAMPLES + 1] - p)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Point2D_Operators);
+
+static void BM_Point2D_ToWkt(benchmark::State& state) {
+  auto points = random_points(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(points[i++ % SAMPLES].ToWkt(state.range(0)));
+  }
+}
+BENCHMARK(BM_Point2D_ToWkt)->Apply(decimal_precisions);
+
+static void BM_Point2D_FromWkt(benchmark::State& state) {
+  std::vector<std::string> wkts;
+  for (auto const& point : random_points(SAMPLES)) {
+    wkts.push_back(point.ToWkt(g::DP_SIX));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Point2D::FromWkt(wkts[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Point2D_FromWkt);
+
+static void BM_Point2D_ToWkb(benchmark::State& state) {
+  auto points = random_points(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(points[i++ % SAMPLES].ToWkb());
+  }
+}
+BENCHMARK(BM_Point2D_ToWkb);
+
+static void BM_Point2D_FromWkb(benchmark::State& state) {
+  std::vector<std::vector<std::uint8_t>> wkbs;
+  for (auto const& point : random_points(SAMPLES)) {
+    wkbs.push_back(point.ToWkb());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Point2D::FromWkb(wkbs[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Point2D_FromWkb);
+
+#pragma region Collection Operations
+
+// a random walk with about half of the points repeated
+static std::vector<g::Point2D> walk_with_duplicates(int size) {
+  auto const& knots = random_polyline(size / 2 + 2).Knots();
+  std::vector<g::Point2D> points;
+  points.reserve(size);
+  for (int i = 0; points.size() < size; ++i) {
+    points.push_back(knots[i / 2]);
+  }
+  return points;
+}
+
+static void BM_Point2D_RemoveDuplicatesConsecutive(benchmark::State& state) {
+  auto points = walk_with_duplicates(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Point2D::remove_duplicates(points, g::DP_THREE, g::Point2D::Duplicates::CONSECUTIVE));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+  state.SetComplexityN(points.size());
+}
+BENCHMARK(BM_Point2D_RemoveDuplicatesConsecutive)->Apply(polyline_sizes);
+
+static void BM_Point2D_RemoveDuplicatesGlobal(benchmark::State& state) {
+  auto points = walk_with_duplicates(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Point2D::remove_duplicates(points, g::DP_THREE, g::Point2D::Duplicates::GLOBAL));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+  state.SetComplexityN(points.size());
+}
+BENCHMARK(BM_Point2D_RemoveDuplicatesGlobal)->Apply(polyline_sizes);
+
+static void BM_Point2D_RemoveCollinear(benchmark::State& state) {
+  // every other point in the middle of its neighbours
+  auto const& knots = random_polyline(state.range(0) / 2 + 1).Knots();
+  std::vector<g::Point2D> points;
+  for (int i = 0; i + 1 < knots.size(); ++i) {
+    points.push_back(knots[i]);
+    points.push_back(knots[i] + 0.5 * (knots[i + 1] - knots[i]));
+  }
+  points.push_back(knots.back());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Point2D::remove_collinear(points, g::DP_THREE));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+  state.SetComplexityN(points.size());
+}
+BENCHMARK(BM_Point2D_RemoveCollinear)->Apply(polyline_sizes);
+
+#pragma endregion
+
+}  // namespace geompp_bench
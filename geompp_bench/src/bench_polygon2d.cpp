@@ -0,0 +1,98 @@
+#include "bench_data.hpp"
+
+#include "batch.hpp"
+#include "point2d.hpp"
+#include "polygon2d.hpp"
+#include "vector2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <map>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+namespace {
+
+// wavy ring of size knots around the origin (radius 700 +- 200, with some noise on the length of an edge, like a
+// border), with a smaller one as a hole, of a tenth of the knots, built once per size
+g::Polygon2D const& random_polygon(int size, unsigned seed = 1) {
+  static std::map<std::pair<int, unsigned>, g::Polygon2D> cache;
+  auto found = cache.find({size, seed});
+  if (found == cache.end()) {
+    std::mt19937 gen(seed);
+    auto wavy = [&gen](int n, double radius, double wave) {
+      std::uniform_real_distribution<double> noise(-2 * M_PI * radius / n, 2 * M_PI * radius / n);
+      std::vector<g::Point2D> ring;
+      for (int i = 0; i < n; ++i) {
+        double a = 2 * M_PI * i / n;
+        double r = radius + wave * std::sin(7 * a) + noise(gen);
+        ring.emplace_back(r * std::cos(a), r * std::sin(a));
+      }
+      return ring;
+    };
+    auto exterior = wavy(size - size / 10, 700, 200);
+    auto hole = wavy(std::max(size / 10, 3), 250, 50);
+    found = cache.emplace(std::make_pair(size, seed), g::Polygon2D::Make(exterior, {hole}, g::DP_NINE)).first;
+  }
+  return found->second;
+}
+
+}  // namespace
+
+// Each benchmark runs on the wavy polygon of state.range(0) knots: the queries take random points in its box
+
+static void BM_Polygon2D_WindingNumber(benchmark::State& state) {
+  auto const& polygon = random_polygon(state.range(0));
+  auto points = random_points(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polygon.WindingNumber(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polygon2D_WindingNumber)->Apply(polyline_sizes);
+
+static void BM_Polygon2D_Contains(benchmark::State& state) {
+  auto const& polygon = random_polygon(state.range(0));
+  polygon.Prepare();
+  auto points = random_points(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polygon.Contains(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polygon2D_Contains)->Apply(polyline_sizes);
+
+static void BM_Polygon2D_Prepare(benchmark::State& state) {
+  auto const& polygon = random_polygon(state.range(0));
+  for (auto _ : state) {
+    auto exterior = std::vector<g::Point2D>(polygon.Exterior().begin(), polygon.Exterior().end());
+    auto copy = g::Polygon2D::Make(exterior, {}, g::DP_NINE);
+    copy.Prepare();
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polygon2D_Prepare)->Apply(polyline_sizes);
+
+static void BM_Polygon2D_BatchContains(benchmark::State& state) {
+  auto const& polygon = random_polygon(100'000);
+  polygon.Prepare();
+  auto points = random_points(1'000'000);
+  g::batch::Options options{.threads = static_cast<int>(state.range(0))};
+  std::vector<std::uint8_t> out(points.size());
+  for (auto _ : state) {
+    g::batch::Contains(std::span<g::Point2D const>(points), polygon, std::span<std::uint8_t>(out), options);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Polygon2D_BatchContains)->Arg(1)->Arg(4)->UseRealTime();
+
+}  // namespace geompp_bench
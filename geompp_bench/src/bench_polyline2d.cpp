@@ -0,0 +1,323 @@
+#include "bench_data.hpp"
+
+#include "executor.hpp"
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "polyline_pyramid.hpp"
+#include "ray2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+// Each benchmark runs on the random walk of state.range(0) knots (see polyline_sizes): the queries take a point
+// around it, or a line, ray or segment crossing it along its length
+
+static void BM_Polyline2D_Make(benchmark::State& state) {
+  auto points = random_polyline(state.range(0)).Knots();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Polyline2D::Make(points));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_Make)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_AlmostEquals(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto other = polyline;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.AlmostEquals(other));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_AlmostEquals)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_ToSegments(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.ToSegments());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_ToSegments)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_BoundingBox(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.BoundingBox());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_BoundingBox)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_DistanceTo(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto points = points_around(polyline, SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.DistanceTo(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_DistanceTo)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_Location(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  std::vector<g::Point2D> points;
+  for (int i = 0; i < SAMPLES; ++i) {
+    points.push_back(polyline.Interpolate(static_cast<double>(i) / SAMPLES));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Location(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_Location)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_Interpolate(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Interpolate(static_cast<double>(i++ % SAMPLES) / SAMPLES));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_Interpolate)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_Contains(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  std::vector<g::Point2D> points;
+  for (int i = 0; i < SAMPLES; ++i) {
+    points.push_back(polyline.Interpolate(static_cast<double>(i) / SAMPLES));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Contains(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_Contains)->Apply(polyline_sizes);
+
+#pragma region Intersection
+
+static void BM_Polyline2D_IntersectionLine(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto line = g::Line2D::Make(polyline.Knots().front(), polyline.Knots().back());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(line));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionLine)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectionRay(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto const& knots = polyline.Knots();
+  auto ray = g::Ray2D::Make(knots.front(), knots.back() - knots.front());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(ray));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionRay)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectionSegment(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto segment = g::LineSegment2D::Make(polyline.Knots().front(), polyline.Knots().back());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(segment));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionSegment)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectsSegment(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto segment = g::LineSegment2D::Make(polyline.Knots().front(), polyline.Knots().back());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersects(segment));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectsSegment)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectionPolyline(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto const& other = random_polyline(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(other));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionPolyline)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectionPolylineExact(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto const& other = random_polyline(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(other, g::EXACT));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionPolylineExact)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_IntersectionPolylineParallel(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto const& other = random_polyline(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(other, g::Executor::Default()));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectionPolylineParallel)->Apply(polyline_sizes)->UseRealTime();
+
+static void BM_Polyline2D_IntersectsPolyline(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  auto const& other = random_polyline(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersects(other));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_IntersectsPolyline)->Apply(polyline_sizes);
+
+#pragma endregion
+
+#pragma region Serialization
+
+static void BM_Polyline2D_ToWkt(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.ToWkt(g::DP_SIX));
+  }
+  state.SetItemsProcessed(state.iterations() * polyline.Size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_ToWkt)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_FromWkt(benchmark::State& state) {
+  auto wkt = random_polyline(state.range(0)).ToWkt(g::DP_SIX);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Polyline2D::FromWkt(wkt));
+  }
+  state.SetBytesProcessed(state.iterations() * wkt.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_FromWkt)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_ToWkb(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.ToWkb());
+  }
+  state.SetItemsProcessed(state.iterations() * polyline.Size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_ToWkb)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_FromWkb(benchmark::State& state) {
+  auto wkb = random_polyline(state.range(0)).ToWkb();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Polyline2D::FromWkb(wkb));
+  }
+  state.SetBytesProcessed(state.iterations() * wkb.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_FromWkb)->Apply(polyline_sizes);
+
+#pragma endregion
+
+#pragma region Simplification
+
+static void BM_Polyline2D_SimplifyDouglasPeucker(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Simplify(0.5, g::Simplification::DOUGLAS_PEUCKER));
+  }
+  state.SetItemsProcessed(state.iterations() * polyline.Size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_SimplifyDouglasPeucker)->Apply(polyline_sizes);
+
+static void BM_Polyline2D_SimplifyVisvalingamWhyatt(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Simplify(0.5, g::Simplification::VISVALINGAM_WHYATT));
+  }
+  state.SetItemsProcessed(state.iterations() * polyline.Size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2D_SimplifyVisvalingamWhyatt)->Apply(polyline_sizes);
+
+static void BM_PolylinePyramid_Make(benchmark::State& state) {
+  auto const& polyline = random_polyline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::PolylinePyramid::Make(polyline));
+  }
+  state.SetItemsProcessed(state.iterations() * polyline.Size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolylinePyramid_Make)->Apply(polyline_sizes);
+
+// the level of 1/16 of the knots, read from the pyramid
+static void BM_PolylinePyramid_At(benchmark::State& state) {
+  auto pyramid = g::PolylinePyramid::Make(random_polyline(state.range(0)));
+  double tolerance = pyramid.Tolerance(pyramid.Size() / 16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pyramid.At(tolerance));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolylinePyramid_At)->Apply(polyline_sizes);
+
+#pragma endregion
+
+#pragma region Float
+
+// the same random walks, with the knots rounded to float (half the memory)
+
+static void BM_Polyline2Df_Make(benchmark::State& state) {
+  auto const& knots = random_polyline(state.range(0)).Knots();
+  std::vector<g::Point2Df> points(knots.begin(), knots.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Polyline2Df::Make(points));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2Df_Make)->Apply(polyline_sizes);
+
+static void BM_Polyline2Df_DistanceTo(benchmark::State& state) {
+  auto const& wide = random_polyline(state.range(0));
+  auto polyline = g::Polyline2Df::Make(wide);
+  auto wide_points = points_around(wide, SAMPLES);
+  std::vector<g::Point2Df> points(wide_points.begin(), wide_points.end());
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.DistanceTo(points[i++ % SAMPLES]));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2Df_DistanceTo)->Apply(polyline_sizes);
+
+static void BM_Polyline2Df_IntersectionPolyline(benchmark::State& state) {
+  auto polyline = g::Polyline2Df::Make(random_polyline(state.range(0)));
+  auto other = g::Polyline2Df::Make(random_polyline(state.range(0), 2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polyline.Intersection(other));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Polyline2Df_IntersectionPolyline)->Apply(polyline_sizes);
+
+#pragma endregion
+
+}  // namespace geompp_bench
@@ -0,0 +1,188 @@
+#include "bench_data.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "ray2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static std::vector<g::Ray2D> random_rays(int size, unsigned seed = 1) {
+  auto points = random_points(2 * size, seed);
+  std::vector<g::Ray2D> rays;
+  rays.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    rays.push_back(g::Ray2D::Make(points[2 * i], points[2 * i + 1] - points[2 * i]));
+  }
+  return rays;
+}
+
+static void BM_Ray2D_Make(benchmark::State& state) {
+  auto points = random_points(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    auto const& p = points[i % SAMPLES];
+    benchmark::DoNotOptimize(g::Ray2D::Make(p, points[i % SAMPLES + 1] - p, state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_Make)->Apply(decimal_precisions);
+
+static void BM_Ray2D_AlmostEquals(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].AlmostEquals(rays[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_AlmostEquals)->Apply(decimal_precisions);
+
+static void BM_Ray2D_IsAhead(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].IsAhead(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_IsAhead)->Apply(decimal_precisions);
+
+static void BM_Ray2D_IsBehind(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].IsBehind(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_IsBehind)->Apply(decimal_precisions);
+
+static void BM_Ray2D_ToLine(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i++ % SAMPLES].ToLine(state.range(0)));
+  }
+}
+BENCHMARK(BM_Ray2D_ToLine)->Apply(decimal_precisions);
+
+static void BM_Ray2D_DistanceTo(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].DistanceTo(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_DistanceTo)->Apply(decimal_precisions);
+
+static void BM_Ray2D_Contains(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto points = random_points(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].Contains(points[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_Contains)->Apply(decimal_precisions);
+
+static void BM_Ray2D_IntersectionLine(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  std::vector<g::Line2D> lines;
+  for (auto const& segment : random_segments(SAMPLES, 2)) {
+    lines.push_back(segment.ToLine());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].Intersection(lines[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_IntersectionLine)->Apply(decimal_precisions);
+
+static void BM_Ray2D_IntersectionRay(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES), others = random_rays(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].Intersection(others[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_IntersectionRay)->Apply(decimal_precisions);
+
+static void BM_Ray2D_IntersectionSegment(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto segments = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].Intersection(segments[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_IntersectionSegment)->Apply(decimal_precisions);
+
+static void BM_Ray2D_Intersects(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  auto segments = random_segments(SAMPLES, 2);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i % SAMPLES].Intersects(segments[i % SAMPLES], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Ray2D_Intersects)->Apply(decimal_precisions);
+
+static void BM_Ray2D_ToWkt(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i++ % SAMPLES].ToWkt(state.range(0)));
+  }
+}
+BENCHMARK(BM_Ray2D_ToWkt)->Apply(decimal_precisions);
+
+static void BM_Ray2D_FromWkt(benchmark::State& state) {
+  std::vector<std::string> wkts;
+  for (auto const& ray : random_rays(SAMPLES)) {
+    wkts.push_back(ray.ToWkt(g::DP_SIX));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Ray2D::FromWkt(wkts[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Ray2D_FromWkt);
+
+static void BM_Ray2D_ToWkb(benchmark::State& state) {
+  auto rays = random_rays(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rays[i++ % SAMPLES].ToWkb());
+  }
+}
+BENCHMARK(BM_Ray2D_ToWkb);
+
+static void BM_Ray2D_FromWkb(benchmark::State& state) {
+  std::vector<std::vector<std::uint8_t>> wkbs;
+  for (auto const& ray : random_rays(SAMPLES)) {
+    wkbs.push_back(ray.ToWkb());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Ray2D::FromWkb(wkbs[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Ray2D_FromWkb);
+
+}  // namespace geompp_bench
@@ -0,0 +1,41 @@
+#include "bench_data.hpp"
+
+#include "utils.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static void BM_Utils_RoundTo(benchmark::State& state) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> value(-1000, 1000);
+  std::vector<double> values(SAMPLES);
+  for (auto& x : values) {
+    x = value(gen);
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::round_to(values[i++ % SAMPLES], state.range(0)));
+  }
+}
+BENCHMARK(BM_Utils_RoundTo)->DenseRange(0, 9, 3);
+
+static void BM_Utils_Sign(benchmark::State& state) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> value(-0.01, 0.01);
+  std::vector<double> values(SAMPLES);
+  for (auto& x : values) {
+    x = value(gen);
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::sign(values[i++ % SAMPLES], state.range(0)));
+  }
+}
+BENCHMARK(BM_Utils_Sign)->Apply(decimal_precisions);
+
+}  // namespace geompp_bench
@@ -0,0 +1,133 @@
+#include "bench_data.hpp"
+
+#include "point2d.hpp"
+#include "vector2d.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_bench {
+
+static std::vector<g::Vector2D> random_vectors(int size) {
+  std::vector<g::Vector2D> vectors;
+  vectors.reserve(size);
+  for (auto const& point : random_points(size, 3)) {
+    vectors.emplace_back(point.x(), point.y());
+  }
+  return vectors;
+}
+
+static void BM_Vector2D_Length(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i++ % SAMPLES].Length());
+  }
+}
+BENCHMARK(BM_Vector2D_Length);
+
+static void BM_Vector2D_AlmostEquals(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i % SAMPLES].AlmostEquals(vectors[i % SAMPLES + 1], state.range(0)));
+    ++i;
+  }
+}
+BENCHMARK(BM_Vector2D_AlmostEquals)->Apply(decimal_precisions);
+
+static void BM_Vector2D_Dot(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i % SAMPLES].Dot(vectors[i % SAMPLES + 1]));
+    ++i;
+  }
+}
+BENCHMARK(BM_Vector2D_Dot);
+
+static void BM_Vector2D_Cross(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i % SAMPLES].Cross(vectors[i % SAMPLES + 1]));
+    ++i;
+  }
+}
+BENCHMARK(BM_Vector2D_Cross);
+
+static void BM_Vector2D_Perp(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i++ % SAMPLES].Perp());
+  }
+}
+BENCHMARK(BM_Vector2D_Perp);
+
+static void BM_Vector2D_Normalize(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i++ % SAMPLES].Normalize());
+  }
+}
+BENCHMARK(BM_Vector2D_Normalize);
+
+static void BM_Vector2D_Operators(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES + 1);
+  int i = 0;
+  for (auto _ : state) {
+    auto const& v = vectors[i % SAMPLES];
+    benchmark::DoNotOptimize((2 * (v + vectors[i % SAMPLES + 1]) - v) / 3);
+    ++i;
+  }
+}
+BENCHMARK(BM_Vector2D_Operators);
+
+static void BM_Vector2D_ToWkt(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i++ % SAMPLES].ToWkt(state.range(0)));
+  }
+}
+BENCHMARK(BM_Vector2D_ToWkt)->Apply(decimal_precisions);
+
+static void BM_Vector2D_FromWkt(benchmark::State& state) {
+  std::vector<std::string> wkts;
+  for (auto const& vector : random_vectors(SAMPLES)) {
+    wkts.push_back(vector.ToWkt(g::DP_SIX));
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Vector2D::FromWkt(wkts[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Vector2D_FromWkt);
+
+static void BM_Vector2D_ToWkb(benchmark::State& state) {
+  auto vectors = random_vectors(SAMPLES);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vectors[i++ % SAMPLES].ToWkb());
+  }
+}
+BENCHMARK(BM_Vector2D_ToWkb);
+
+static void BM_Vector2D_FromWkb(benchmark::State& state) {
+  std::vector<std::vector<std::uint8_t>> wkbs;
+  for (auto const& vector : random_vectors(SAMPLES)) {
+    wkbs.push_back(vector.ToWkb());
+  }
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g::Vector2D::FromWkb(wkbs[i++ % SAMPLES]));
+  }
+}
+BENCHMARK(BM_Vector2D_FromWkb);
+
+}  // namespace geompp_bench
@@ -0,0 +1,122 @@
+#include "batch.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(Batch, Chunks) {
+  for (int threads : {1, 3, 0}) {
+    for (int chunk : {0, 1, 7, 1000}) {
+      std::vector<std::atomic<int>> calls(1001);
+      g::batch::for_each_chunk(calls.size(), {threads, chunk}, 16, [&calls](int first, int last) {
+        for (int i = first; i < last; ++i) {
+          ++calls[i];
+        }
+      });
+      for (auto const& c : calls) {
+        ASSERT_EQ(1, c);
+      }
+    }
+  }
+  g::batch::for_each_chunk(0, {}, 16, [](int, int) { FAIL(); });
+
+  auto fail = [](int first, int) {
+    if (first == 50) {
+      throw std::runtime_error("fail");
+    }
+  };
+  EXPECT_THROW(g::batch::for_each_chunk(100, {4, 10}, 16, fail), std::runtime_error);
+
+  // all the threads of the executor by default, one runs on the calling thread
+  EXPECT_EQ(0, g::batch::Options{}.threads);
+  std::atomic<int> elsewhere{0};
+  g::batch::for_each_chunk(1000, {1, 10}, 16, [&elsewhere, id = std::this_thread::get_id()](int, int) {
+    elsewhere += std::this_thread::get_id() != id ? 1 : 0;
+  });
+  EXPECT_EQ(0, elsewhere);
+}
+
+TEST(Batch, Points) {
+  std::mt19937 gen(1);
+  auto polyline = random_walk(300, gen, 1);
+  std::uniform_real_distribution<double> x(-10, 310), y(-30, 30);
+  std::vector<g::Point2D> points;
+  for (int i = 0; i < 5000; ++i) {
+    points.emplace_back(x(gen), y(gen));
+  }
+  for (auto const& knot : polyline.Knots()) {
+    points.push_back(knot);
+  }
+
+  for (int threads : {1, 4}) {
+    g::batch::Options options{threads, 0, g::DP_SIX};
+    auto distances = g::batch::DistanceTo(points, polyline, options);
+    auto locations = g::batch::Location(points, polyline, options);
+    auto contains = g::batch::Contains(points, polyline, options);
+    ASSERT_EQ(points.size(), distances.size());
+    for (int i = 0; i < points.size(); ++i) {
+      ASSERT_EQ(polyline.DistanceTo(points[i], g::DP_SIX), distances[i]);
+      ASSERT_EQ(polyline.Location(points[i], g::DP_SIX), locations[i]);
+      ASSERT_EQ(polyline.Contains(points[i], g::DP_SIX), contains[i] == 1);
+    }
+  }
+
+  // into a span, of the same size
+  auto line = g::Line2D::Make(g::Point2D(0, 0), g::Point2D(1, 1));
+  std::vector<double> out(points.size());
+  g::batch::DistanceTo(points, line, std::span<double>(out), {2});
+  ASSERT_EQ(line.DistanceTo(points[10]), out[10]);
+  std::vector<double> shorter(points.size() - 1);
+  EXPECT_ANY_THROW(g::batch::DistanceTo(points, line, std::span<double>(shorter)));
+}
+
+TEST(Batch, Intersections) {
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> coord(-100, 100);
+  std::vector<g::LineSegment2D> segments;
+  while (segments.size() < 3000) {
+    auto p0 = g::Point2D(coord(gen), coord(gen)), p1 = g::Point2D(coord(gen), coord(gen));
+    if (!p0.AlmostEquals(p1)) {
+      segments.push_back(g::LineSegment2D::Make(p0, p1));
+    }
+  }
+  auto line = g::Line2D::Make(g::Point2D(-50, -20), g::Point2D(40, 30));
+
+  auto found = g::batch::Intersection(segments, line, {0, 100});
+  ASSERT_EQ(segments.size(), found.size());
+  int intersections = 0;
+  for (int i = 0; i < segments.size(); ++i) {
+    auto expected = segments[i].Intersection(line);
+    ASSERT_EQ(expected.has_value(), found[i].has_value());
+    if (expected.has_value()) {
+      ASSERT_EQ(std::get<g::Point2D>(*expected), std::get<g::Point2D>(*found[i]));
+      ++intersections;
+    }
+  }
+  EXPECT_LT(0, intersections);
+
+  // the output span is written over
+  std::vector<g::LineSegment2D::ReturnSet> out(segments.size(), g::Point2D(1, 2));
+  g::batch::Intersection(std::span<g::LineSegment2D const>(segments), line,
+                         std::span<g::LineSegment2D::ReturnSet>(out));
+  for (int i = 0; i < segments.size(); ++i) {
+    ASSERT_EQ(found[i].has_value(), out[i].has_value());
+  }
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "vector2d.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace geompp_tests {
+
+// random walk of size knots from the origin, each step of (drift + [-1, 1], [-1, 1]), folded by fmod into
+// (-fold, fold) when fold > 0 (dense, with steep and short segments)
+inline geompp::Polyline2D random_walk(int size, std::mt19937& gen, double drift = 0, double fold = 0,
+                                      int decimal_precision = geompp::DP_THREE) {
+  std::uniform_real_distribution<double> step(-1, 1);
+  std::vector<geompp::Point2D> points{geompp::Point2D(0, 0)};
+  while (points.size() < size) {
+    auto next = points.back() + geompp::Vector2D(drift + step(gen), step(gen));
+    points.push_back(fold > 0 ? geompp::Point2D(std::fmod(next.x(), fold), std::fmod(next.y(), fold)) : next);
+  }
+  return geompp::Polyline2D::Make(std::move(points), decimal_precision);
+}
+
+// random points on a grid of [-cells, cells] x [-cells, cells] cells of cell_x x cell_y, moved by up to noise: with
+// noise 0 many coordinates (and points) repeat, to test the ties
+inline std::vector<geompp::Point2D> random_points(int size, std::mt19937& gen, int cells, double cell_x, double cell_y,
+                                                  double noise = 0) {
+  std::uniform_int_distribution<int> coord(-cells, cells);
+  std::uniform_real_distribution<double> jitter(-noise, noise);
+  std::vector<geompp::Point2D> points;
+  points.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    if (noise > 0) {
+      points.emplace_back(coord(gen) * cell_x + jitter(gen), coord(gen) * cell_y + jitter(gen));
+    } else {
+      points.emplace_back(coord(gen) * cell_x, coord(gen) * cell_y);
+    }
+  }
+  return points;
+}
+
+// random segments from [-range, range] x [-range, range], of a random vector of [-length, length] x [-length, length]
+// (none too short at DP_THREE); rounded to integers on_grid, for many crossings, touching ends, parallel and collinear
+// pairs
+inline std::vector<geompp::LineSegment2D> random_segments(int size, std::mt19937& gen, double range, double length,
+                                                          bool on_grid = false) {
+  std::uniform_real_distribution<double> start(-range, range);
+  std::uniform_real_distribution<double> step(-length, length);
+  std::vector<geompp::LineSegment2D> segments;
+  while (segments.size() < size) {
+    geompp::Point2D p0(start(gen), start(gen));
+    geompp::Point2D p1 = p0 + geompp::Vector2D(step(gen), step(gen));
+    if (on_grid) {
+      p0 = geompp::Point2D(std::round(p0.x()), std::round(p0.y()));
+      p1 = geompp::Point2D(std::round(p1.x()), std::round(p1.y()));
+    }
+    if (!p0.AlmostEquals(p1)) {
+      segments.push_back(geompp::LineSegment2D::Make(p0, p1));
+    }
+  }
+  return segments;
+}
+
+// random polylines of min_knots to max_knots knots, starting in [-100, 100] x [-100, 100], by steps of up to 2
+inline std::vector<geompp::Polyline2D> random_polylines(int size, std::mt19937& gen, int min_knots, int max_knots,
+                                                        int decimal_precision = geompp::DP_THREE) {
+  std::uniform_real_distribution<double> center(-100, 100);
+  std::uniform_real_distribution<double> step(-2, 2);
+  std::uniform_int_distribution<int> knots(min_knots, max_knots);
+  std::vector<geompp::Polyline2D> polylines;
+  while (polylines.size() < size) {
+    std::vector<geompp::Point2D> points{geompp::Point2D(center(gen), center(gen))};
+    for (int i = knots(gen); i > 1; --i) {
+      points.push_back(points.back() + geompp::Vector2D(step(gen), step(gen)));
+    }
+    polylines.push_back(geompp::Polyline2D::Make(points, decimal_precision));
+  }
+  return polylines;
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
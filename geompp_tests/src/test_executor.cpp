@@ -0,0 +1,85 @@
+#include "executor.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(Executor, ParallelFor) {
+  for (int threads : {1, 2, 5}) {
+    g::Executor executor(threads);
+    ASSERT_EQ(threads, executor.Concurrency());
+    for (int grain : {0, 1, 100}) {
+      std::vector<std::atomic<int>> calls(1000);
+      executor.parallel_for(0, calls.size(), [&calls](int i) { ++calls[i]; }, grain);
+      for (auto const& c : calls) {
+        ASSERT_EQ(1, c);
+      }
+    }
+    executor.parallel_for(5, 5, [](int) { FAIL(); });
+  }
+  EXPECT_LE(1, g::Executor::Default().Concurrency());
+}
+
+TEST(Executor, Nested) {
+  // a parallel_for in each task of a parallel_for, on the same pool
+  g::Executor executor(3, true);
+  std::vector<std::atomic<int>> calls(64 * 64);
+  executor.parallel_for(
+      0, 64,
+      [&](int i) { executor.parallel_for(0, 64, [&calls, i](int j) { ++calls[64 * i + j]; }, 4); }, 1);
+  for (auto const& c : calls) {
+    ASSERT_EQ(1, c);
+  }
+
+  int a = 0, b = 0, c = 0;
+  executor.Join([&] { executor.Join([&] { a = 1; }, [&] { b = 2; }); }, [&] { c = 3; });
+  EXPECT_EQ(1, a);
+  EXPECT_EQ(2, b);
+  EXPECT_EQ(3, c);
+}
+
+TEST(Executor, ReduceAndSort) {
+  g::Executor executor(4);
+  long long sum = executor.parallel_reduce(
+      0, 100000, 0LL, [](int i) { return static_cast<long long>(i); }, [](long long a, long long b) { return a + b; });
+  EXPECT_EQ(99999LL * 100000 / 2, sum);
+  EXPECT_EQ(7, executor.parallel_reduce(3, 3, 7, [](int i) { return i; }, [](int a, int b) { return a + b; }));
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> value(-1000, 1000);
+  std::vector<int> values(50000);
+  for (auto& v : values) {
+    v = value(gen);
+  }
+  auto expected = values;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  executor.parallel_sort(values.begin(), values.end(), std::greater<>(), 1000);
+  EXPECT_EQ(expected, values);
+}
+
+TEST(Executor, Exceptions) {
+  g::Executor executor(3);
+  EXPECT_THROW(executor.parallel_for(0, 100,
+                                     [](int i) {
+                                       if (i == 42) {
+                                         throw std::runtime_error("fail");
+                                       }
+                                     },
+                                     1),
+               std::runtime_error);
+
+  // still working
+  std::atomic<int> count = 0;
+  executor.parallel_for(0, 100, [&count](int) { ++count; });
+  EXPECT_EQ(100, count);
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
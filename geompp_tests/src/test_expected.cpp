@@ -0,0 +1,61 @@
+#include "expected.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+namespace {
+
+// a value whose copy throws when asked to, and whose move may throw
+struct Fragile {
+  static inline bool THROW = false;
+  std::string NAME;
+
+  explicit Fragile(std::string name) : NAME(std::move(name)) {}
+  Fragile(Fragile const& other) : NAME(other.NAME) {
+    if (THROW) {
+      throw std::runtime_error("copy");
+    }
+  }
+  Fragile(Fragile&& other) : NAME(std::move(other.NAME)) {}
+};
+
+}  // namespace
+
+TEST(Expected, NoexceptMove) {
+  static_assert(std::is_nothrow_move_constructible_v<g::expected<std::string, g::GeomError>>);
+  static_assert(std::is_nothrow_move_assignable_v<g::expected<std::string, g::GeomError>>);
+  static_assert(!std::is_nothrow_move_constructible_v<g::expected<Fragile, g::GeomError>>);
+}
+
+TEST(Expected, AssignmentThatThrows) {
+  g::expected<Fragile, g::GeomError> a = Fragile("a");
+  g::expected<Fragile, g::GeomError> b = Fragile("b");
+  g::expected<Fragile, g::GeomError> error = g::unexpected(g::GeomError::BAD_WKT);
+
+  Fragile::THROW = true;
+  // a value over a value, and over an error: left as they were
+  EXPECT_THROW(a = b, std::runtime_error);
+  ASSERT_TRUE(a.has_value());
+  EXPECT_EQ("a", a->NAME);
+  EXPECT_THROW(error = b, std::runtime_error);
+  ASSERT_FALSE(error.has_value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, error.error());
+  Fragile::THROW = false;
+
+  a = b;
+  EXPECT_EQ("b", a->NAME);
+  error = b;
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ("b", error->NAME);
+  b = g::expected<Fragile, g::GeomError>(g::unexpected(g::GeomError::TOO_FEW_POINTS));
+  ASSERT_FALSE(b.has_value());
+  EXPECT_EQ(g::GeomError::TOO_FEW_POINTS, b.error());
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "kd_tree2d.hpp"
+
+#include "point2d.hpp"
+#include "point_buffer2d.hpp"
+#include "test_data.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+namespace {
+
+// (squared distance, index) of all the points, by increasing distance, then index
+std::vector<std::pair<double, int>> sorted_by_distance(std::vector<g::Point2D> const& points, g::Point2D const& p) {
+  std::vector<std::pair<double, int>> sorted;
+  for (int i = 0; i < points.size(); ++i) {
+    double dx = points[i].x() - p.x(), dy = points[i].y() - p.y();
+    sorted.emplace_back(dx * dx + dy * dy, i);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+void expect_same_as_scan(std::vector<g::Point2D> const& points, g::KDTree2D const& tree, std::mt19937& gen) {
+  ASSERT_EQ(points.size(), tree.Size());
+
+  std::uniform_int_distribution<int> coord(-220, 220);
+  for (int q = 0; q < 30; ++q) {
+    g::Point2D p(coord(gen) * 0.5, coord(gen) * 0.25);
+    auto expected = sorted_by_distance(points, p);
+
+    auto nearest = tree.Nearest(p);
+    ASSERT_EQ(expected[0].second, nearest.index);
+    ASSERT_EQ(expected[0].first, nearest.squared_distance);
+
+    for (int k : {1, 7, 100}) {
+      auto k_nearest = tree.KNearest(p, k);
+      ASSERT_EQ(std::min<int>(k, points.size()), k_nearest.size());
+      for (int i = 0; i < k_nearest.size(); ++i) {
+        ASSERT_EQ(expected[i].second, k_nearest[i].index);
+        ASSERT_EQ(expected[i].first, k_nearest[i].squared_distance);
+      }
+    }
+
+    for (double radius : {0.0, 1.5, 12.0}) {
+      std::vector<int> within;
+      for (auto const& [squared_distance, index] : expected) {
+        if (squared_distance <= radius * radius) {
+          within.push_back(index);
+        }
+      }
+      std::sort(within.begin(), within.end());
+      ASSERT_EQ(within, tree.Within(p, radius));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(KDTree2D, SameAsScan) {
+  std::mt19937 gen(1);
+  for (int size : {1, 16, 17, 100, 5000}) {
+    auto points = random_points(size, gen, 200, 0.5, 0.25);
+    expect_same_as_scan(points, g::KDTree2D::Make(points), gen);
+    expect_same_as_scan(points, g::KDTree2D::Make(g::PointBuffer2D::Make(points)), gen);
+  }
+}
+
+TEST(KDTree2D, Parallel) {
+  std::mt19937 gen(2);
+  auto points = random_points(100000, gen, 200, 0.5, 0.25);
+  auto tree = g::KDTree2D::Make(points, 4);
+  expect_same_as_scan(points, tree, gen);
+
+  auto queries = random_points(1000, gen, 200, 0.5, 0.25);
+  auto nearest = tree.Nearest(queries, 3);
+  auto k_nearest = tree.KNearest(queries, 5, 3);
+  auto within = tree.Within(queries, 2.0, 3);
+  ASSERT_EQ(queries.size(), nearest.size());
+  ASSERT_EQ(queries.size(), k_nearest.size());
+  ASSERT_EQ(queries.size(), within.size());
+  for (int i = 0; i < queries.size(); ++i) {
+    ASSERT_EQ(tree.Nearest(queries[i]).index, nearest[i].index);
+    auto expected = tree.KNearest(queries[i], 5);
+    ASSERT_EQ(expected.size(), k_nearest[i].size());
+    for (int j = 0; j < expected.size(); ++j) {
+      ASSERT_EQ(expected[j].index, k_nearest[i][j].index);
+    }
+    ASSERT_EQ(tree.Within(queries[i], 2.0), within[i]);
+  }
+}
+
+TEST(KDTree2D, Empty) {
+  auto tree = g::KDTree2D::Make(std::vector<g::Point2D>{});
+  ASSERT_EQ(0, tree.Size());
+  ASSERT_TRUE(tree.BoundingBox().IsEmpty());
+  ASSERT_ANY_THROW(tree.Nearest(g::Point2D(0, 0)));
+  ASSERT_TRUE(tree.KNearest(g::Point2D(0, 0), 3).empty());
+  ASSERT_TRUE(tree.Within(g::Point2D(0, 0), 10).empty());
+  ASSERT_TRUE(tree.Nearest(std::vector<g::Point2D>{}, 2).empty());
+}
+
+TEST(KDTree2D, BoundingBox) {
+  auto tree = g::KDTree2D::Make({g::Point2D(0, 0), g::Point2D(5, -2), g::Point2D(3, 4)});
+  ASSERT_TRUE(tree.BoundingBox().AlmostEquals(g::BoundingBox2D::Make({0, -2}, {5, 4})));
+  ASSERT_EQ((std::vector<int>{1, 2}), tree.Within(g::Point2D(4, 1), 3.2));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -82,6 +82,20 @@ TEST(Line2D, Wkt) {
   EXPECT_ANY_THROW(g::Line2D::FromWkt("LINE ( -7.5 -64.4 15.5, 0 0 0)"));
 }
 
+TEST(Line2D, TryMake) {
+  auto line = g::Line2D::TryMake(g::Point2D(1, 2), g::Point2D(3, 4));
+  ASSERT_TRUE(line.has_value());
+  EXPECT_EQ(g::Line2D::Make(g::Point2D(1, 2), g::Point2D(3, 4)), *line);
+  EXPECT_EQ(g::GeomError::POINTS_TOO_CLOSE, g::Line2D::TryMake(g::Point2D(1, 2), g::Point2D(1, 2.0001)).error());
+  EXPECT_TRUE(g::Line2D::TryMake(g::Point2D(1, 2), g::Vector2D(0, 1)).has_value());
+  EXPECT_EQ(g::GeomError::ZERO_DIRECTION, g::Line2D::TryMake(g::Point2D(1, 2), g::Vector2D(0, 0.0001)).error());
+
+  EXPECT_EQ(g::Line2D::FromWkt("LINE (0 0, 1 1)"), g::Line2D::TryFromWkt("LINE (0 0, 1 1)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Line2D::TryFromWkt("LINE (-7.5 -64.4, 0 ").error());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Line2D::TryFromWkt("LINE ( -7.5 -64.4 15.5, 0 0 0)").error());
+  EXPECT_EQ(g::GeomError::POINTS_TOO_CLOSE, g::Line2D::TryFromWkt("LINE (1 1, 1 1)").error());
+}
+
 TEST(Line2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "line.wkt").string();
@@ -142,6 +156,10 @@ TEST(Line2D, DistanceTo) {
   // Q4
   auto p8 = g::Point2D(3, -7);
   EXPECT_EQ(7, line.DistanceTo(p8, prec));
+
+  // not a whole number
+  auto p9 = g::Point2D(1, -2.5);
+  EXPECT_EQ(2.5, line.DistanceTo(p9, prec));
 }
 
 }  // namespace geompp_tests
\ No newline at end of file
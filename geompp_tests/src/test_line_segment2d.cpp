@@ -60,6 +60,16 @@ TEST(LineSegment2D, Location) {
   ASSERT_TRUE(std::isinf(s1.Location(g::Point2D(1, -1), prec)));
 }
 
+TEST(LineSegment2D, LocationOnShortSegment) {
+  // shorter than 1e-3: its line is only defined at a higher precision
+  int prec = 6;
+  auto s1 = g::LineSegment2D::Make(g::Point2D(0, 0), g::Point2D(0.0004, 0.0003), prec);
+
+  ASSERT_EQ(0.5, g::round_to(s1.Location(g::Point2D(0.0002, 0.00015), prec), prec));
+  ASSERT_EQ(2, g::round_to(s1.Location(g::Point2D(0.0008, 0.0006), prec), prec));
+  ASSERT_TRUE(std::isinf(s1.Location(g::Point2D(0.0003, 0), prec)));
+}
+
 TEST(LineSegment2D, Interpolate) {
   int prec = 4;
   auto seg = g::LineSegment2D::FromWkt("LINESTRING (0 0, 3 0)");
@@ -236,6 +246,46 @@ TEST(LineSegment2D, Wkt) {
   EXPECT_ANY_THROW(g::LineSegment2D::FromWkt("linestring ( -7.5 -64.4 15.5, 0 0 0)"));
 }
 
+TEST(LineSegment2D, TryMake) {
+  auto segment = g::LineSegment2D::TryMake(g::Point2D(1, 2), g::Point2D(3, 4));
+  ASSERT_TRUE(segment.has_value());
+  EXPECT_EQ(g::LineSegment2D::Make(g::Point2D(1, 2), g::Point2D(3, 4)), *segment);
+  EXPECT_EQ(g::GeomError::POINTS_TOO_CLOSE, g::LineSegment2D::TryMake(g::Point2D(1, 2), g::Point2D(1, 2)).error());
+  EXPECT_TRUE(g::LineSegment2D::TryMake(g::Point2D(1, 2), g::Point2D(1, 2.0001), g::DP_SIX).has_value());
+
+  EXPECT_EQ(g::LineSegment2D::FromWkt("LINESTRING (0 0, 1 1)"),
+            g::LineSegment2D::TryFromWkt("LINESTRING (0 0, 1 1)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::LineSegment2D::TryFromWkt("line string ( -7.5 -60.7, 0 0)").error());
+  EXPECT_EQ(g::GeomError::POINTS_TOO_CLOSE, g::LineSegment2D::TryFromWkt("LINESTRING (1 1, 1 1)").error());
+}
+
+TEST(LineSegment2D, Float) {
+  auto segment = g::LineSegment2Df::Make(g::Point2Df(-1, -1), g::Point2Df(1, 1));
+  auto other = g::LineSegment2Df::Make(g::Point2Df(-1, 1), g::Point2Df(1, -1));
+  auto inter = segment.Intersection(other);
+  ASSERT_TRUE(inter.has_value());
+  ASSERT_EQ(g::Point2Df(0, 0), std::get<g::Point2Df>(*inter));
+  ASSERT_TRUE(segment.Intersects(other, g::EXACT));
+  ASSERT_TRUE(segment.Intersects(g::Line2D::Make(g::Point2D(0, -5), g::Point2D(0, 5))));
+  ASSERT_NEAR(std::sqrt(8), segment.Length(), 1e-6);
+  ASSERT_EQ(g::Point2Df(0.5f, 0.5f), segment.Interpolate(0.75));
+  ASSERT_EQ(segment, g::LineSegment2Df::FromWkt(segment.ToWkt()));
+
+  // float to double is exact, double to float checks the points again
+  g::LineSegment2D wide(segment);
+  ASSERT_EQ(g::Point2D(-1, -1), wide.First());
+  ASSERT_EQ(segment, g::LineSegment2Df::Make(wide));
+  auto close = g::LineSegment2D::Make(g::Point2D(1, 1), g::Point2D(1, 1 + 1e-9), 12);
+  EXPECT_EQ(g::GeomError::POINTS_TOO_CLOSE, g::LineSegment2Df::TryMake(close, g::DP_SIX).error());
+
+  // no more decimals than the coordinates hold
+  EXPECT_EQ(g::GeomError::BAD_PRECISION,
+            g::LineSegment2Df::TryMake(g::Point2Df(0, 0), g::Point2Df(1, 1), g::DP_NINE).error());
+  EXPECT_THROW(g::LineSegment2Df::Make(g::Point2Df(0, 0), g::Point2Df(1, 1), g::DP_NINE), std::runtime_error);
+  EXPECT_TRUE(g::LineSegment2D::TryMake(g::Point2D(0, 0), g::Point2D(1, 1), g::DP_NINE).has_value());
+  EXPECT_EQ(g::GeomError::BAD_PRECISION, g::LineSegment2D::TryMake(g::Point2D(0, 0), g::Point2D(1, 1), 16).error());
+}
+
 TEST(LineSegment2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "line_segment.wkt").string();
@@ -0,0 +1,117 @@
+#include "line_segment_buffer2d.hpp"
+
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "test_data.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(LineSegmentBuffer2D, Conversion) {
+  std::mt19937 gen(1);
+  auto segments = random_segments(101, gen, 10, 10, true);
+  auto buffer = g::LineSegmentBuffer2D::Make(segments);
+  ASSERT_EQ(segments.size(), buffer.Size());
+
+  auto back = buffer.ToSegments();
+  for (int i = 0; i < segments.size(); ++i) {
+    ASSERT_TRUE(segments[i].AlmostEquals(back[i]));
+    ASSERT_TRUE(segments[i].AlmostEquals(buffer.At(i)));
+  }
+
+  auto bbox = buffer.BoundingBox();
+  for (auto const& seg : segments) {
+    ASSERT_TRUE(bbox.Contains(seg.First()));
+    ASSERT_TRUE(bbox.Contains(seg.Last()));
+  }
+  ASSERT_TRUE(g::LineSegmentBuffer2D().BoundingBox().IsEmpty());
+}
+
+TEST(LineSegmentBuffer2D, Intersection) {
+  auto seg = g::LineSegment2D::Make({0, 0}, {4, 4});
+  auto buffer = g::LineSegmentBuffer2D::Make({
+      g::LineSegment2D::Make({0, 4}, {4, 0}),  // crosses in the middle
+      g::LineSegment2D::Make({4, 4}, {6, 0}),  // touches the end point
+      g::LineSegment2D::Make({1, 0}, {5, 4}),  // parallel
+      g::LineSegment2D::Make({5, 0}, {5, 9}),  // beyond
+      g::LineSegment2D::Make({2, 2}, {3, 3}),  // collinear
+  });
+
+  auto result = buffer.Intersection(seg);
+  ASSERT_EQ((std::vector<std::uint8_t>{1, 1, 0, 0, 0}), result.hits);
+  ASSERT_DOUBLE_EQ(0.5, result.t[0]);
+  ASSERT_DOUBLE_EQ(0.5, result.s[0]);
+  ASSERT_DOUBLE_EQ(1.0, result.t[1]);
+  ASSERT_DOUBLE_EQ(0.0, result.s[1]);
+  ASSERT_EQ(result.hits, buffer.Intersects(seg));
+
+  std::vector<std::uint8_t> hits(4);
+  std::vector<double> t(5), s(5);
+  ASSERT_THROW(buffer.Intersection(seg, hits, t, s), std::runtime_error);
+}
+
+TEST(LineSegmentBuffer2D, SameAsLineSegment2D) {
+  for (int size : {1, 3, 5, 997}) {
+    std::mt19937 gen(size);
+    auto segments = random_segments(size, gen, 10, 10, true);
+    auto buffer = g::LineSegmentBuffer2D::Make(segments);
+    for (auto const& seg : random_segments(20, gen, 10, 10, true)) {
+      for (int prec : {g::DP_THREE, g::DP_SIX}) {
+        auto result = buffer.Intersection(seg, prec);
+        for (int i = 0; i < size; ++i) {
+          auto expected = seg.Intersection(segments[i], prec);
+          ASSERT_EQ(expected.has_value(), result.hits[i] == 1) << seg.ToWkt() << " " << segments[i].ToWkt();
+          if (expected.has_value()) {
+            auto p = std::get<g::Point2D>(expected.value());
+            ASSERT_TRUE(p.AlmostEquals(seg.First() + result.t[i] * (seg.Last() - seg.First()), prec));
+            auto const& other = segments[i];
+            ASSERT_TRUE(p.AlmostEquals(other.First() + result.s[i] * (other.Last() - other.First()), prec));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(LineSegmentBuffer2D, EndsAtTheTolerance) {
+  // the intersections fall within a few tolerances of the ends of the segments, behind and beyond, where the short
+  // segments (|v| < 1) take a wider tolerance behind their first point, as Location does
+  auto query = g::LineSegment2D::Make(g::Point2D(-2, 0), g::Point2D(2, 0.001));
+  auto short_one = g::LineSegment2D::Make(g::Point2D(-0.277478, 0.000857), g::Point2D(-0.026193, 0.296073));
+  EXPECT_EQ(short_one.Intersects(query), g::LineSegmentBuffer2D::Make({short_one}).Intersects(query)[0] == 1);
+
+  for (int prec : {g::DP_THREE, g::DP_SIX}) {
+    double near = 3 * std::pow(10, -prec);
+    std::mt19937 gen(prec);
+    std::uniform_real_distribution<double> along(-0.1, 1.1), offset(-near, near), angle(0, 2 * M_PI), length(0.05, 1);
+    std::vector<g::LineSegment2D> segments;
+    while (segments.size() < 4003) {
+      // one end near the query: near its line, or near one of its ends
+      g::Point2D p = query.First() + along(gen) * (query.Last() - query.First());
+      if (gen() % 3 == 0) {
+        p = gen() % 2 == 0 ? query.First() : query.Last();
+      }
+      p = p + g::Vector2D(offset(gen), offset(gen));
+      double a = angle(gen), l = length(gen);
+      g::Point2D q = p + g::Vector2D(l * std::cos(a), l * std::sin(a));
+      segments.push_back(gen() % 2 == 0 ? g::LineSegment2D::Make(p, q) : g::LineSegment2D::Make(q, p));
+    }
+
+    auto hits = g::LineSegmentBuffer2D::Make(segments).Intersects(query, prec);
+    int count = 0;
+    for (int i = 0; i < segments.size(); ++i) {
+      bool expected = segments[i].Intersects(query, prec);
+      ASSERT_EQ(expected, hits[i] == 1) << segments[i].ToWkt(g::DP_NINE) << " at " << prec;
+      count += expected ? 1 : 0;
+    }
+    ASSERT_GT(count, segments.size() / 4);
+  }
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -5,7 +5,9 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <random>
 #include <vector>
 
 namespace g = geompp;
@@ -46,6 +48,37 @@ TEST(Point2D, AddVector) {
   ASSERT_EQ(g::Point2D(3.05, 3.77), pv);
 }
 
+TEST(Point2D, CopyAndConstexpr) {
+  constexpr g::Point2D p = g::Point2D(1, 2) + g::Vector2D(3, 4) * 2 - g::Vector2D(1, 1);
+  static_assert(p.x() == 6 && p.y() == 9);
+  static_assert((g::Point2D(3, 5) - g::Point2D(1, 1)).Cross(g::Vector2D(1, 0)) == -4);
+
+  std::vector<g::Point2D> points{{1, 2}, {3, 4}};
+  points[0] = points[1];
+  ASSERT_EQ(g::Point2D(3, 4), points[0]);
+
+  double xy[4];
+  std::memcpy(xy, points.data(), sizeof(xy));
+  ASSERT_EQ(3, xy[0]);
+  ASSERT_EQ(4, xy[1]);
+}
+
+TEST(Point2D, Float) {
+  static_assert(sizeof(g::Point2Df) == sizeof(g::Point2D) / 2);
+  g::Point2Df p(1.5f, -2.25f);
+  g::Point2D wide(p);  // exact
+  ASSERT_EQ(1.5, wide.x());
+  ASSERT_EQ(-2.25, wide.y());
+  ASSERT_EQ(0.1f, g::Point2Df(g::Point2D(0.1, 0)).x());  // rounded
+
+  ASSERT_EQ(g::Point2Df(2.5f, -1.25f), p + g::Vector2Df(1, 1));
+  ASSERT_EQ(5, g::Point2Df(0, 0).DistanceTo(g::Point2Df(3, 4)));
+  ASSERT_EQ("POINT (1.5 -2.25)", p.ToWkt());
+  ASSERT_EQ(p, g::Point2Df::FromWkt("POINT (1.5 -2.25)"));
+  ASSERT_EQ(p, g::Point2Df::FromWkb(p.ToWkb()));
+  ASSERT_EQ(2, g::Point2Df::remove_duplicates({p, p, g::Point2Df(0, 0)}).size());
+}
+
 TEST(Point2D, Wkt) {
   ASSERT_EQ("POINT (0 0)", g::Point2D().ToWkt());
   ASSERT_EQ("POINT (56491.62 -795.97)", g::Point2D(56491.6164, -795.97416).ToWkt(2));
@@ -63,6 +96,12 @@ TEST(Point2D, Wkt) {
   EXPECT_ANY_THROW(g::Point2D::FromWkt("point ( -7.5 -64.4 15.5)"));
 }
 
+TEST(Point2D, TryFromWkt) {
+  EXPECT_EQ(g::Point2D(-7.5, -60.7), g::Point2D::TryFromWkt("  point( -7.5    -60.7)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Point2D::TryFromWkt("point ( -7.5 -64.4 15.5)").error());
+  EXPECT_EQ(g::Point2D(1, 2), g::Point2D::TryFromWkt("point ( )").value_or(g::Point2D(1, 2)));
+}
+
 TEST(Point2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "point.wkt").string();
@@ -126,6 +165,60 @@ TEST(Point2D, RemoveDuplicates) {
   ASSERT_EQ(g::Point2D(3, 2), unique_pts[4]);
 }
 
+TEST(Point2D, RemoveDuplicatesGlobal) {
+  std::vector<g::Point2D> pts{g::Point2D(0, 0), g::Point2D(1, 0), g::Point2D(0.0001, 0),  // duplicate of the first
+                              g::Point2D(2, 2), g::Point2D(1, 0.0004),                    // duplicate of the second
+                              g::Point2D(0, 0.0006)};
+
+  auto consecutive = g::Point2D::remove_duplicates(pts);
+  ASSERT_EQ(6, consecutive.size());
+
+  auto unique_pts = g::Point2D::remove_duplicates(pts, g::DP_THREE, g::Point2D::Duplicates::GLOBAL);
+  ASSERT_EQ(4, unique_pts.size());
+  ASSERT_EQ(g::Point2D(0, 0), unique_pts[0]);
+  ASSERT_EQ(g::Point2D(1, 0), unique_pts[1]);
+  ASSERT_EQ(g::Point2D(2, 2), unique_pts[2]);
+  ASSERT_EQ(g::Point2D(0, 0.0006), unique_pts[3]);  // 0.001 away from (0, 0) at 3 decimals
+
+  ASSERT_TRUE(g::Point2D::remove_duplicates({}, g::DP_THREE, g::Point2D::Duplicates::GLOBAL).empty());
+}
+
+TEST(Point2D, RemoveDuplicatesSameAsPairs) {
+  // clustered points, around the rounding thresholds of the precisions
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> cluster(-5, 5);
+  std::uniform_real_distribution<double> noise(-0.002, 0.002);
+  std::vector<g::Point2D> pts;
+  for (int i = 0; i < 2000; ++i) {
+    pts.emplace_back(cluster(gen) * 0.01 + noise(gen), cluster(gen) * 0.01 + noise(gen));
+  }
+
+  for (int prec : {1, 2, g::DP_THREE, g::DP_SIX}) {
+    std::vector<g::Point2D> expected;  // a point is kept if it isn't equal to any point kept before it
+    for (auto const& p : pts) {
+      bool duplicate = false;
+      for (auto const& u : expected) {
+        duplicate = duplicate || u.AlmostEquals(p, prec);
+      }
+      if (!duplicate) {
+        expected.push_back(p);
+      }
+    }
+
+    auto unique_pts = g::Point2D::remove_duplicates(pts, prec, g::Point2D::Duplicates::GLOBAL);
+    ASSERT_EQ(expected.size(), unique_pts.size()) << prec;
+    for (int i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].x(), unique_pts[i].x());
+      ASSERT_EQ(expected[i].y(), unique_pts[i].y());
+    }
+
+    auto consecutive = g::Point2D::remove_duplicates(pts, prec);
+    for (int i = 1; i < consecutive.size(); ++i) {
+      ASSERT_FALSE(consecutive[i - 1].AlmostEquals(consecutive[i], prec));
+    }
+  }
+}
+
 TEST(Point2D, RemoveCollinear) {
   // clang-format off
   std::vector<g::Point2D> pts{g::Point2D(0, 0), 
@@ -156,4 +249,50 @@ TEST(Point2D, RemoveCollinear) {
   ASSERT_EQ(g::Point2D(7, 0), unique_pts[6]);
 }
 
+TEST(Point2D, RemoveDuplicatesAndCollinear) {
+  // clang-format off
+  std::vector<g::Point2D> pts{g::Point2D(0, 0),
+                              g::Point2D(0, 0.0001),  // duplicate
+                              g::Point2D(1, 0),       // collinear
+                              g::Point2D(2, 0),
+                              g::Point2D(2, 0),       // duplicate
+                              g::Point2D(1.5, 0),     // back over the last segment
+                              g::Point2D(2, 2),       // collinear
+                              g::Point2D(2, 5),
+                              g::Point2D(3, 6),
+                              g::Point2D(4, 5),       // collinear
+                              g::Point2D(5, 4),
+                              g::Point2D(6, 0),
+                              g::Point2D(6, 0),       // duplicate
+                              g::Point2D(7, 0)
+                              };
+  // clang-format on
+
+  auto const* data = pts.data();
+  g::Point2D::remove_duplicates_and_collinear(pts);
+
+  ASSERT_EQ(data, pts.data());  // in place
+  ASSERT_EQ(7, pts.size());
+  EXPECT_EQ(g::Point2D(0, 0), pts[0]);
+  EXPECT_EQ(g::Point2D(2, 0), pts[1]);
+  EXPECT_EQ(g::Point2D(2, 5), pts[2]);
+  EXPECT_EQ(g::Point2D(3, 6), pts[3]);
+  EXPECT_EQ(g::Point2D(5, 4), pts[4]);
+  EXPECT_EQ(g::Point2D(6, 0), pts[5]);
+  EXPECT_EQ(g::Point2D(7, 0), pts[6]);
+
+  // all the same point, or on a line
+  std::vector<g::Point2D> same(5, g::Point2D(1, 1));
+  g::Point2D::remove_duplicates_and_collinear(same);
+  EXPECT_EQ(1, same.size());
+  std::vector<g::Point2D> line{g::Point2D(0, 0), g::Point2D(1, 1), g::Point2D(2, 2), g::Point2D(3, 3)};
+  g::Point2D::remove_duplicates_and_collinear(line);
+  ASSERT_EQ(2, line.size());
+  EXPECT_EQ(g::Point2D(3, 3), line[1]);
+
+  std::vector<g::Point2D> none;
+  g::Point2D::remove_duplicates_and_collinear(none);
+  EXPECT_TRUE(none.empty());
+}
+
 }  // namespace geompp_tests
\ No newline at end of file
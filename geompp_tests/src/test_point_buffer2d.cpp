@@ -0,0 +1,117 @@
+#include "point_buffer2d.hpp"
+
+#include "point2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(PointBuffer2D, Conversion) {
+  std::mt19937 gen(1);
+  auto points = random_points(1003, gen, 20, 0.5, 0.5, 0.001);
+  auto buffer = g::PointBuffer2D::Make(points);
+  ASSERT_EQ(points.size(), buffer.Size());
+
+  auto back = buffer.ToPoints();
+  ASSERT_EQ(points.size(), back.size());
+  for (int i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(points[i].x(), back[i].x());
+    ASSERT_EQ(points[i].y(), back[i].y());
+    ASSERT_EQ(points[i].x(), buffer.Xs()[i]);
+    ASSERT_EQ(points[i].y(), buffer.At(i).y());
+  }
+
+  g::PointBuffer2D pushed;
+  pushed.Reserve(2);
+  pushed.PushBack({1, 2});
+  pushed.PushBack({3, 4});
+  ASSERT_EQ(2, pushed.Size());
+  ASSERT_TRUE(pushed.At(1).AlmostEquals({3, 4}));
+}
+
+TEST(PointBuffer2D, DistancesTo) {
+  for (int size : {0, 1, 3, 5, 1003}) {
+    std::mt19937 gen(size);
+    auto points = random_points(size, gen, 20, 0.5, 0.5, 0.001);
+    auto buffer = g::PointBuffer2D::Make(points);
+    g::Point2D p(0.25, -1.75);
+    auto distances = buffer.DistancesTo(p);
+    ASSERT_EQ(size, distances.size());
+    for (int i = 0; i < size; ++i) {
+      ASSERT_DOUBLE_EQ((points[i] - p).Length(), distances[i]);
+    }
+  }
+
+  auto buffer = g::PointBuffer2D::Make({{0, 0}, {3, 4}});
+  std::vector<double> out(1);
+  ASSERT_THROW(buffer.DistancesTo({0, 0}, out), std::runtime_error);
+}
+
+TEST(PointBuffer2D, AlmostEquals) {
+  for (int size : {0, 1, 3, 5, 1003}) {
+    std::mt19937 gen(size + 10);
+    auto points = random_points(size, gen, 20, 0.5, 0.5, 0.001);
+    auto buffer = g::PointBuffer2D::Make(points);
+    for (int prec : {0, 1, g::DP_THREE, g::DP_SIX}) {
+      g::Point2D p(1.0, -0.5);
+      auto mask = buffer.AlmostEquals(p, prec);
+      ASSERT_EQ(size, mask.size());
+      for (int i = 0; i < size; ++i) {
+        ASSERT_EQ(points[i].AlmostEquals(p, prec), mask[i] == 1) << i;
+      }
+    }
+  }
+}
+
+TEST(PointBuffer2D, TranslateScale) {
+  std::mt19937 gen(2);
+  auto points = random_points(1003, gen, 20, 0.5, 0.5, 0.001);
+  auto buffer = g::PointBuffer2D::Make(points);
+  g::Vector2D v(1.5, -2.25);
+
+  buffer.Translate(v);
+  for (int i = 0; i < points.size(); ++i) {
+    auto expected = points[i] + v;
+    ASSERT_EQ(expected.x(), buffer.At(i).x());
+    ASSERT_EQ(expected.y(), buffer.At(i).y());
+  }
+
+  buffer.Scale(-3.0);
+  for (int i = 0; i < points.size(); ++i) {
+    auto expected = (points[i] + v) * -3.0;
+    ASSERT_EQ(expected.x(), buffer.At(i).x());
+    ASSERT_EQ(expected.y(), buffer.At(i).y());
+  }
+}
+
+TEST(PointBuffer2D, BoundingBox) {
+  ASSERT_TRUE(g::PointBuffer2D().BoundingBox().IsEmpty());
+
+  for (int size : {1, 3, 5, 1003}) {
+    std::mt19937 gen(size + 20);
+    auto points = random_points(size, gen, 20, 0.5, 0.5, 0.001);
+    auto expected = g::BoundingBox2D::Empty();
+    for (auto const& p : points) {
+      expected = expected.Union(p);
+    }
+    auto bbox = g::PointBuffer2D::Make(points).BoundingBox();
+    ASSERT_FALSE(bbox.IsEmpty());
+    ASSERT_EQ(expected.MinX(), bbox.MinX());
+    ASSERT_EQ(expected.MinY(), bbox.MinY());
+    ASSERT_EQ(expected.MaxX(), bbox.MaxX());
+    ASSERT_EQ(expected.MaxY(), bbox.MaxY());
+  }
+
+  auto bbox = g::PointBuffer2D::Make({{1, 5}, {-2, 3}, {4, -1}}).BoundingBox();
+  ASSERT_TRUE(bbox.AlmostEquals(g::BoundingBox2D::Make({-2, -1}, {4, 5})));
+  ASSERT_TRUE(bbox.Contains({0, 0}));
+  ASSERT_FALSE(bbox.Contains({0, 6}));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "polygon2d.hpp"
+
+#include "batch.hpp"
+#include "edge_grid.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "utils.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+namespace fs = std::filesystem;
+
+namespace geompp_tests {
+
+extern fs::path test_res_path;
+
+namespace {
+
+// the same as Contains, edge by edge (the distance to the segments at a finer precision than the query)
+bool contains_by_scan(g::Polygon2D const& polygon, g::Point2D const& point, int decimal_precision) {
+  for (int r = 0; r < polygon.Rings(); ++r) {
+    auto ring = polygon.Ring(r);
+    for (int i = 0; i + 1 < ring.size(); ++i) {
+      auto segment = g::LineSegment2D::Make(ring[i], ring[i + 1], g::DP_NINE);
+      if (g::round_to(segment.DistanceTo(point, g::DP_NINE), decimal_precision) == 0) {
+        return true;
+      }
+    }
+  }
+  return polygon.WindingNumber(point) != 0;
+}
+
+// star shaped ring around the center, of n knots at random distances
+std::vector<g::Point2D> random_star(g::Point2D const& center, double min_radius, double max_radius, int n,
+                                    std::mt19937& gen) {
+  std::uniform_real_distribution<double> radius(min_radius, max_radius);
+  std::vector<g::Point2D> ring;
+  for (int i = 0; i < n; ++i) {
+    double a = 2 * M_PI * i / n;
+    double r = radius(gen);
+    ring.push_back(center + g::Vector2D(r * std::cos(a), r * std::sin(a)));
+  }
+  return ring;
+}
+
+}  // namespace
+
+TEST(Polygon2D, Make) {
+  // clockwise and not closed: closed, turned counterclockwise, without the collinear (1 0)
+  auto square = g::Polygon2D::Make({g::Point2D(0, 0), g::Point2D(0, 2), g::Point2D(2, 2), g::Point2D(2, 0),
+                                    g::Point2D(1, 0)});
+  ASSERT_EQ(1, square.Rings());
+  ASSERT_EQ(0, square.Holes());
+  ASSERT_EQ(5, square.Size());
+  EXPECT_EQ(square.Exterior().front(), square.Exterior().back());
+  EXPECT_DOUBLE_EQ(4, square.Area());
+  EXPECT_TRUE(square.BoundingBox().AlmostEquals(g::BoundingBox2D::Make(g::Point2D(0, 0), g::Point2D(2, 2))));
+
+  // the hole counterclockwise and closed: turned clockwise
+  auto holed = g::Polygon2D::Make(
+      {g::Point2D(0, 0), g::Point2D(4, 0), g::Point2D(4, 4), g::Point2D(0, 4), g::Point2D(0, 0)},
+      {{g::Point2D(1, 1), g::Point2D(2, 1), g::Point2D(2, 2), g::Point2D(1, 2), g::Point2D(1, 1)}});
+  ASSERT_EQ(2, holed.Rings());
+  ASSERT_EQ(5, holed.Hole(0).size());
+  EXPECT_DOUBLE_EQ(15, holed.Area());
+
+  EXPECT_EQ(g::GeomError::DEGENERATE_RING,
+            g::Polygon2D::TryMake({g::Point2D(0, 0), g::Point2D(1, 1), g::Point2D(2, 2)}).error());
+  EXPECT_EQ(g::GeomError::DEGENERATE_RING,
+            g::Polygon2D::TryMake({g::Point2D(0, 0), g::Point2D(1, 0), g::Point2D(0, 0)}).error());
+  EXPECT_EQ(g::GeomError::DEGENERATE_RING,
+            g::Polygon2D::TryMake({g::Point2D(0, 0), g::Point2D(1, 0), g::Point2D(1, 1)},
+                                  {{g::Point2D(0.5, 0.1), g::Point2D(0.5, 0.1001), g::Point2D(0.5001, 0.1)}})
+                .error());
+  EXPECT_ANY_THROW(g::Polygon2D::Make({g::Point2D(0, 0), g::Point2D(1, 1)}));
+  EXPECT_ANY_THROW(g::Polygon2D::Make({}));
+}
+
+TEST(Polygon2D, Contains) {
+  auto polygon = g::Polygon2D::FromWkt("POLYGON ((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 1 2, 2 2, 2 1, 1 1))");
+
+  EXPECT_TRUE(polygon.Contains(g::Point2D(3, 3)));
+  EXPECT_TRUE(polygon.Contains(g::Point2D(0.5, 1.5)));
+  EXPECT_FALSE(polygon.Contains(g::Point2D(1.5, 1.5)));  // in the hole
+  EXPECT_FALSE(polygon.Contains(g::Point2D(5, 1)));
+  EXPECT_FALSE(polygon.Contains(g::Point2D(-1, 2)));
+
+  // on the rings, at the precision
+  EXPECT_TRUE(polygon.Contains(g::Point2D(4, 2)));
+  EXPECT_TRUE(polygon.Contains(g::Point2D(0, 0)));
+  EXPECT_TRUE(polygon.Contains(g::Point2D(4.0004, 2)));
+  EXPECT_FALSE(polygon.Contains(g::Point2D(4.0004, 2), g::DP_SIX));
+  EXPECT_TRUE(polygon.Contains(g::Point2D(1.5, 1.0001)));
+  EXPECT_FALSE(polygon.Contains(g::Point2D(1.5, 1.0001), g::DP_SIX));
+
+  EXPECT_EQ(1, polygon.WindingNumber(g::Point2D(3, 3)));
+  EXPECT_EQ(0, polygon.WindingNumber(g::Point2D(1.5, 1.5)));
+  EXPECT_EQ(0, polygon.WindingNumber(g::Point2D(10, 10)));
+
+  std::vector<g::Point2D> points{g::Point2D(3, 3), g::Point2D(1.5, 1.5), g::Point2D(4, 2), g::Point2D(5, 1)};
+  EXPECT_EQ((std::vector<std::uint8_t>{1, 0, 1, 0}), g::batch::Contains(std::span<g::Point2D const>(points), polygon));
+}
+
+TEST(Polygon2D, ContainsWithGrid) {
+  std::mt19937 gen(3);
+  auto exterior = random_star(g::Point2D(10, -20), 50, 100, 3000, gen);
+  std::vector<std::vector<g::Point2D>> holes{random_star(g::Point2D(10, -20), 10, 30, 500, gen),
+                                             random_star(g::Point2D(10, 50), 5, 10, 100, gen)};
+  auto polygon = g::Polygon2D::Make(exterior, holes, g::DP_SIX);
+  polygon.Prepare();
+
+  // anywhere, near the knots and on the edges
+  std::vector<g::Point2D> queries;
+  std::uniform_real_distribution<double> anywhere(-100, 120);
+  std::uniform_real_distribution<double> offset(-0.0006, 0.0006);
+  std::uniform_real_distribution<double> unit(0, 1);
+  for (int i = 0; i < 3000; ++i) {
+    queries.push_back(g::Point2D(anywhere(gen) - 10, anywhere(gen) - 20));
+  }
+  for (int r = 0; r < polygon.Rings(); ++r) {
+    auto ring = polygon.Ring(r);
+    for (int i = 0; i + 1 < ring.size(); i += 7) {
+      queries.push_back(ring[i]);
+      queries.push_back(ring[i] + g::Vector2D(offset(gen), offset(gen)));
+      queries.push_back(ring[i] + unit(gen) * (ring[i + 1] - ring[i]));
+    }
+  }
+
+  int inside = 0;
+  for (int prec : {g::DP_THREE, g::DP_SIX}) {
+    for (auto const& q : queries) {
+      bool expected = contains_by_scan(polygon, q, prec);
+      ASSERT_EQ(expected, polygon.Contains(q, prec)) << q.ToWkt(prec) << " at " << prec;
+      inside += expected ? 1 : 0;
+    }
+  }
+  ASSERT_GT(inside, queries.size() / 4);
+
+  // copies share the grid
+  auto copy = polygon;
+  ASSERT_EQ(polygon.Contains(queries[0]), copy.Contains(queries[0]));
+}
+
+TEST(Polygon2D, ContainsWithGridOnAxes) {
+  // a staircase of integer knots: the centers of the cells, the corners of the ways and the queries fall on edges
+  std::vector<g::Point2D> exterior{g::Point2D(0, 0)};
+  for (int i = 0; i < 100; ++i) {
+    exterior.push_back(g::Point2D(i + 1, i));
+    exterior.push_back(g::Point2D(i + 1, i + 1));
+  }
+  exterior.push_back(g::Point2D(0, 100));
+  auto polygon = g::Polygon2D::Make(exterior);
+
+  for (double x = -0.5; x <= 101; x += 0.25) {
+    for (double y = -0.5; y <= 101; y += 0.25) {
+      g::Point2D q(x, y);
+      ASSERT_EQ(contains_by_scan(polygon, q, g::DP_THREE), polygon.Contains(q)) << q.ToWkt();
+    }
+  }
+}
+
+TEST(Polygon2D, EdgeGridOnLongEdges) {
+  // a snake of sqrt(n) diagonals across the square, back along n teeth under it: listed by their boxes, the diagonals
+  // would fill about n^1.5 cells, walked only the about 2 sqrt(n) each crosses
+  for (int n : {2'500, 10'000, 40'000}) {
+    int diagonals = static_cast<int>(std::sqrt(n));
+    double side = n;
+    // the diagonal y = x + c between the sides of the square, from its lower end up
+    auto lower = [side](double c) { return c < 0 ? g::Point2D(-c, 0) : g::Point2D(0, c); };
+    auto upper = [side](double c) { return c < 0 ? g::Point2D(side, side + c) : g::Point2D(side - c, side); };
+    std::vector<g::Point2D> ring;
+    for (int i = 0; i < diagonals; ++i) {
+      double c = -side + (i + 0.5) * 2 * side / diagonals;
+      double next = c + 2 * side / diagonals;
+      if (i % 2 == 0) {
+        ring.push_back(lower(c));
+        ring.push_back(upper(c));
+        if (c < 0 && 0 < next) {
+          ring.push_back(g::Point2D(side, side));
+        }
+      } else {
+        ring.push_back(upper(c));
+        ring.push_back(lower(c));
+        if (c < 0 && 0 < next) {
+          ring.push_back(g::Point2D(0, 0));
+        }
+      }
+    }
+    ring.push_back(g::Point2D(-1, ring.back().y()));
+    ring.push_back(g::Point2D(-1, -1));
+    double teeth = ring.front().x() + 1;
+    for (int i = 0; i < n; ++i) {
+      ring.push_back(g::Point2D(-1 + teeth * i / n, -1));
+      ring.push_back(g::Point2D(-1 + teeth * (i + 0.5) / n, -2));
+    }
+    ring.push_back(g::Point2D(ring.front().x(), -1));
+    auto polygon = g::Polygon2D::Make(ring, {}, g::DP_NINE);
+
+    std::vector<g::Point2D> knots(polygon.Exterior().begin(), polygon.Exterior().end());
+    auto grid = g::EdgeGrid::Make(knots, {0, static_cast<int>(knots.size())});
+    ASSERT_LT(grid.Entries(), 4 * (knots.size() - 1)) << n;
+
+    std::mt19937 gen(n);
+    std::uniform_real_distribution<double> coordinate(-2, side + 1);
+    for (int i = 0; i < 2000; ++i) {
+      g::Point2D q(coordinate(gen), coordinate(gen));
+      auto winding = grid.WindingNumber(knots, q);
+      if (winding.has_value()) {
+        ASSERT_EQ(polygon.WindingNumber(q), *winding) << q.ToWkt(g::DP_SIX);
+      }
+    }
+  }
+}
+
+TEST(Polygon2D, Wkt) {
+  auto polygon = g::Polygon2D::FromWkt("POLYGON ((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 1 2, 2 2, 2 1, 1 1))");
+  EXPECT_EQ("POLYGON ((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 1 2, 2 2, 2 1, 1 1))", polygon.ToWkt());
+  EXPECT_EQ(polygon, g::Polygon2D::FromWkt(polygon.ToWkt()));
+
+  // turned
+  EXPECT_EQ("POLYGON ((0 0, 1.5 0, 0 1.5, 0 0))", g::Polygon2D::FromWkt("polygon((0 0,0 1.5,1.5 0,0 0))").ToWkt());
+
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Polygon2D::TryFromWkt("POLYGON (0 0, 1 0, 1 1, 0 0)").error());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Polygon2D::TryFromWkt("POLYGON ((0 0, 1 0, 1 1, 0 0)").error());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Polygon2D::TryFromWkt("LINESTRING (0 0, 1 0, 1 1, 0 0)").error());
+  EXPECT_EQ(g::GeomError::DEGENERATE_RING, g::Polygon2D::TryFromWkt("POLYGON ((0 0, 1 0, 2 0, 0 0))").error());
+  EXPECT_ANY_THROW(g::Polygon2D::FromWkt("POLYGON ((0 0, 1 0, 1 1, 0 0), )"));
+}
+
+TEST(Polygon2D, Wkb) {
+  auto polygon = g::Polygon2D::FromWkt("POLYGON ((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 1 2, 2 2, 2 1, 1 1))");
+  for (auto endian : {g::Endian::LITTLE, g::Endian::BIG}) {
+    auto wkb = polygon.ToWkb(endian);
+    ASSERT_EQ(1 + 4 + 4 + 2 * (4 + 5 * 16), wkb.size());
+    EXPECT_EQ(polygon, g::Polygon2D::FromWkb(wkb));
+  }
+
+  std::string path = (test_res_path / "temp" / "polygon.wkb").string();
+  polygon.ToWkbFile(path);
+  EXPECT_EQ(polygon, g::Polygon2D::FromWkbFile(path));
+  EXPECT_NO_THROW(fs::remove(path));
+
+  auto wkb = polygon.ToWkb();
+  EXPECT_ANY_THROW(g::Polygon2D::FromWkb(std::span<std::uint8_t const>(wkb).first(wkb.size() - 1)));
+  EXPECT_ANY_THROW(g::Polygon2D::FromWkb(g::Point2D(1, 1).ToWkb()));
+}
+
+TEST(Polygon2D, ToFile) {
+  auto polygon = g::Polygon2D::FromWkt("POLYGON ((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 1 2, 2 2, 2 1, 1 1))");
+  std::string path = (test_res_path / "temp" / "polygon.wkt").string();
+  polygon.ToFile(path);
+  EXPECT_EQ(polygon, g::Polygon2D::FromFile(path));
+  EXPECT_NO_THROW(fs::remove(path));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "polyline2d.hpp"
 
+#include "executor.hpp"
 #include "line2d.hpp"
 #include "line_segment2d.hpp"
 #include "point2d.hpp"
 #include "ray2d.hpp"
+#include "test_data.hpp"
 #include "utils.hpp"
 #include "vector2d.hpp"
 
@@ -11,6 +13,7 @@
 #include <cmath>
 #include <filesystem>
 #include <limits>
+#include <random>
 #include <vector>
 
 namespace g = geompp;
@@ -40,6 +43,22 @@ TEST(Polyline2D, Constructor) {
             g::Polyline2D::Make({g::Point2D(), g::Point2D(1, 0), g::Point2D(3, 0)}).Size());  // removed collinear point
 }
 
+TEST(Polyline2D, Segments) {
+  auto polyline = g::Polyline2D::Make({g::Point2D(-2, -5), g::Point2D(-2, -3), g::Point2D(2, -3), g::Point2D(2, 2)});
+  auto segs = polyline.ToSegments();
+
+  ASSERT_EQ(3, segs.size());
+  ASSERT_EQ(3, polyline.Segments().size());
+
+  int i = 0;
+  for (auto const& s : polyline.Segments()) {
+    ASSERT_EQ(segs[i], s);
+    ASSERT_EQ(polyline.Knots()[i], s.First());
+    ASSERT_EQ(polyline.Knots()[i + 1], s.Last());
+    ++i;
+  }
+}
+
 TEST(Polyline2D, Contains) {
   int prec = 4;
   std::vector<g::Point2D> points{g::Point2D(-2, -5), g::Point2D(-2, -3), g::Point2D(2, -3), g::Point2D(2, 2)};
@@ -99,6 +118,27 @@ TEST(Polyline2D, Interpolate) {
   ASSERT_EQ(0.0, g::round_to(poly.Location(poly.Interpolate(-0.2), prec), 1));
 }
 
+TEST(Polyline2D, InterpolateMultiSegment) {
+  int prec = 4;
+  auto poly = g::Polyline2D::FromWkt("LINESTRING (0 0, 3 0, 3 4, 4.5 6)");  // lengths 3 + 4 + 2.5
+  ASSERT_EQ(9.5, poly.Length());
+
+  // knots
+  ASSERT_EQ(g::Point2D(0, 0), poly.Interpolate(0));
+  ASSERT_EQ(g::Point2D(3, 0), poly.Interpolate(3 / 9.5));
+  ASSERT_EQ(g::Point2D(3, 4), poly.Interpolate(7 / 9.5));
+  ASSERT_EQ(g::Point2D(4.5, 6), poly.Interpolate(1));
+
+  // middle of segments
+  ASSERT_EQ(g::Point2D(1.5, 0), poly.Interpolate(1.5 / 9.5));
+  ASSERT_EQ(g::Point2D(3, 2), poly.Interpolate(5 / 9.5));
+  ASSERT_EQ(g::Point2D(3.75, 5), poly.Interpolate(8.25 / 9.5));
+
+  for (double pct : {0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 0.9, 1.0}) {
+    ASSERT_EQ(g::round_to(pct, prec), g::round_to(poly.Location(poly.Interpolate(pct), prec), prec));
+  }
+}
+
 TEST(Polyline2D, IntersectionWLine) {
   int prec = 4;
   auto poly1 = g::Polyline2D::FromWkt("LINESTRING (-1 2, -1 -2, 1 -2, 1 2)");  // intersects x (-1 0, 1 0) and y (0 -2)
@@ -280,6 +320,31 @@ TEST(Polyline2D, Intersection) {
   ASSERT_FALSE(poly2.Intersects(poly3, prec));
 }
 
+TEST(Polyline2D, ParallelIntersection) {
+  // two long random walks over the same area, crossing many times
+  std::mt19937 gen(3);
+  auto poly1 = random_walk(5000, gen, 0, 40), poly2 = random_walk(3000, gen, 0, 40);
+
+  g::Executor executor(4);
+  auto expect_same = [](g::Polyline2D::ReturnSet const& expected, g::Polyline2D::ReturnSet const& actual) {
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_TRUE(actual.has_value());
+    auto const& e = std::get<g::Polyline2D::MultiPoint>(*expected);
+    auto const& a = std::get<g::Polyline2D::MultiPoint>(*actual);
+    ASSERT_EQ(e.size(), a.size());
+    for (int i = 0; i < e.size(); ++i) {
+      ASSERT_EQ(e[i].x(), a[i].x());
+      ASSERT_EQ(e[i].y(), a[i].y());
+    }
+  };
+  expect_same(poly1.Intersection(poly2, g::DP_THREE), poly1.Intersection(poly2, executor, g::DP_THREE));
+  expect_same(poly1.Intersection(poly2, g::EXACT), poly1.Intersection(poly2, executor, g::EXACT));
+  expect_same(poly2.Intersection(poly1, g::DP_SIX), poly2.Intersection(poly1, executor, g::DP_SIX));
+
+  auto far = g::Polyline2D::Make({{100, 100}, {101, 101}, {102, 100}});
+  ASSERT_FALSE(poly1.Intersection(far, executor).has_value());
+}
+
 TEST(Polyline2D, Wkt) {
   ASSERT_EQ("LINESTRING (0 0, 1 1)", g::Polyline2D::Make({g::Point2D(), g::Point2D(1, 1)}).ToWkt());
   ASSERT_EQ("LINESTRING (56491.62 -795.97, -9137.37 10.36, -10351.52 7.61)",
@@ -307,6 +372,84 @@ TEST(Polyline2D, Wkt) {
   EXPECT_ANY_THROW(g::Polyline2D::FromWkt("linestring ( -7.5 -64.4 15.5, 0 0 0)"));
 }
 
+TEST(Polyline2D, TryMake) {
+  auto polyline = g::Polyline2D::TryMake({g::Point2D(0, 0), g::Point2D(1, 1), g::Point2D(2, 0)});
+  ASSERT_TRUE(polyline.has_value());
+  EXPECT_EQ(3, polyline->Size());
+  EXPECT_EQ(g::GeomError::TOO_FEW_POINTS, g::Polyline2D::TryMake({g::Point2D(0, 0), g::Point2D(0, 0)}).error());
+  EXPECT_EQ(g::GeomError::TOO_FEW_POINTS, g::Polyline2D::TryMake({}).error());
+  EXPECT_THROW(g::Polyline2D::TryMake({}).value(), g::bad_expected_access<g::GeomError>);
+
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 1 1, 2 0)"),
+            g::Polyline2D::TryFromWkt("LINESTRING (0 0, 1 1, 2 0)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Polyline2D::TryFromWkt("linestring (-7.5 -64.4, ").error());
+  EXPECT_EQ(g::GeomError::TOO_FEW_POINTS, g::Polyline2D::TryFromWkt("LINESTRING (1 1, 1 1, 1 1)").error());
+}
+
+TEST(Polyline2D, MakeFromTemporary) {
+  std::vector<g::Point2D> points{g::Point2D(0, 0), g::Point2D(0, 0), g::Point2D(1, 0), g::Point2D(2, 0),
+                                 g::Point2D(2, 1), g::Point2D(3, 2), g::Point2D(3, 2)};
+  auto copy = g::Polyline2D::Make(points);
+  EXPECT_EQ(7, points.size());  // untouched
+
+  auto const* data = points.data();
+  auto polyline = g::Polyline2D::Make(std::move(points));
+  EXPECT_EQ(data, polyline.Knots().data());  // the same buffer, cleaned in place
+  ASSERT_EQ(4, polyline.Size());
+  EXPECT_EQ(copy, polyline);
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 0, 2 1, 3 2)"), polyline);
+
+  EXPECT_EQ(g::GeomError::TOO_FEW_POINTS,
+            g::Polyline2D::TryMake(std::vector<g::Point2D>{g::Point2D(1, 1), g::Point2D(1, 1)}).error());
+}
+
+TEST(Polyline2D, Float) {
+  auto poly1 = g::Polyline2Df::FromWkt("LINESTRING (-1 2, -1 -2, 1 -2, 1 2)");
+  auto poly2 = g::Polyline2Df::FromWkt("LINESTRING (-2 1, -0.5 1, -0.5 -3, 0.5 -3, 0.5 1, 2 1)");
+  EXPECT_EQ(10, poly1.Length());
+  EXPECT_EQ(g::Point2Df(0, -2), poly1.Interpolate(0.5));
+  EXPECT_TRUE(poly1.Contains(g::Point2Df(1, 0)));
+  EXPECT_EQ(1, poly1.DistanceTo(g::Point2Df(0, 0)));
+
+  auto inter = poly1.Intersection(poly2);
+  ASSERT_TRUE(inter.has_value());
+  auto mpoint = std::get<g::Polyline2Df::MultiPoint>(*inter);
+  ASSERT_EQ(4, mpoint.size());
+  EXPECT_EQ(g::Point2Df(-1, 1), mpoint[0]);
+  EXPECT_EQ(g::Point2Df(1, 1), mpoint[3]);
+
+  // the same polyline in double, exactly, and back
+  g::Polyline2D wide(poly1);
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (-1 2, -1 -2, 1 -2, 1 2)"), wide);
+  EXPECT_EQ(poly1, g::Polyline2Df::Make(wide));
+  EXPECT_EQ(poly1, g::Polyline2Df::FromWkb(poly1.ToWkb()));
+  EXPECT_EQ(g::Polyline2D::Make(wide.Knots()).ToWkb(), poly1.ToWkb());
+
+  EXPECT_EQ(g::GeomError::BAD_PRECISION, g::Polyline2Df::TryMake(poly1.Knots(), g::DP_NINE).error());
+  // the text has more decimals than a float: read at the most it can hold
+  EXPECT_TRUE(g::Polyline2Df::TryFromWkt("LINESTRING (0 0, 1.123456789 1)").has_value());
+}
+
+TEST(Polyline2D, FloatLong) {
+  // a zigzag of 200k integer knots (exact in float): a float sum of its lengths would drift by more than a knot ulp
+  int n = 200'000;
+  std::vector<g::Point2Df> knots;
+  for (int i = 0; i <= n; ++i) {
+    knots.push_back(g::Point2Df(i, i % 2));
+  }
+  auto polyline = g::Polyline2Df::Make(knots);
+  ASSERT_EQ(n + 1, polyline.Size());
+  EXPECT_NEAR(n * std::sqrt(2.0), polyline.Length(), 1e-6);
+
+  // the middle of the last segments, where the lengths are the largest
+  for (int i = n - 3; i < n; ++i) {
+    g::Point2Df middle(i + 0.5f, 0.5f);
+    double pct = (i + 0.5) / n;
+    EXPECT_EQ(middle, polyline.Interpolate(pct)) << i;
+    EXPECT_NEAR(pct, polyline.Location(middle), 1e-9) << i;
+  }
+}
+
 TEST(Polyline2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "polyline.wkt").string();
@@ -355,4 +498,147 @@ TEST(Polyline2D, DistanceTo) {
   ASSERT_EQ(1, polyline.DistanceTo(g::Point2D(0, -2), prec));
 }
 
+TEST(Polyline2D, LongPolylineSameAsScan) {
+  // random walk with long and very short steps, large enough to use the segment hierarchy
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+  std::uniform_real_distribution<double> unit(0, 1);
+  std::vector<g::Point2D> points{g::Point2D(0, 0)};
+  for (int i = 0; i < 2000; ++i) {
+    double a = angle(gen), len = unit(gen) < 0.2 ? 0.01 : 5 * unit(gen) + 0.01;
+    points.push_back(points.back() + g::Vector2D(len * std::cos(a), len * std::sin(a)));
+  }
+  auto polyline = g::Polyline2D::Make(points);
+  auto segs = polyline.ToSegments();
+  ASSERT_GT(segs.size(), 1000);
+
+  // queries around the knots, on the segments, just off them and anywhere
+  std::vector<g::Point2D> queries;
+  std::uniform_real_distribution<double> anywhere(-60, 60);
+  std::uniform_real_distribution<double> offset(-0.0006, 0.0006);
+  for (int i = 0; i < 80; ++i) {
+    auto const& s = segs[gen() % segs.size()];
+    queries.push_back(s.First());
+    queries.push_back(s.Interpolate(unit(gen)) + g::Vector2D(offset(gen), offset(gen)));
+    queries.push_back(s.Interpolate(1 + offset(gen)));
+    queries.push_back(g::Point2D(anywhere(gen), anywhere(gen)));
+  }
+
+  auto scan = [&segs](auto const& other, int prec) {
+    std::vector<g::Point2D> found;
+    for (auto const& s : segs) {
+      auto inter = other.Intersection(s, prec);
+      if (inter.has_value()) {
+        found.push_back(std::get<g::Point2D>(*inter));
+      }
+    }
+    return found;
+  };
+  auto to_vector = [](g::Polyline2D::ReturnSet const& inter) {
+    if (!inter.has_value()) {
+      return std::vector<g::Point2D>{};
+    }
+    if (std::holds_alternative<g::Point2D>(*inter)) {
+      return std::vector<g::Point2D>{std::get<g::Point2D>(*inter)};
+    }
+    return std::get<g::Polyline2D::MultiPoint>(*inter);
+  };
+  auto expect_same = [](std::vector<g::Point2D> const& expected, std::vector<g::Point2D> const& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].x(), actual[i].x());
+      ASSERT_EQ(expected[i].y(), actual[i].y());
+    }
+  };
+
+  for (int prec : {g::DP_THREE, g::DP_SIX}) {
+    for (int i = 0; i < queries.size(); ++i) {
+      auto const& q = queries[i];
+      double distance = std::numeric_limits<double>::infinity();
+      bool contained = false;
+      for (auto const& s : segs) {
+        distance = std::min(distance, s.DistanceTo(q, prec));
+        contained = contained || s.Contains(q, prec);
+      }
+      ASSERT_EQ(distance, polyline.DistanceTo(q, prec)) << q.ToWkt(prec);
+      ASSERT_EQ(contained, polyline.Contains(q, prec)) << q.ToWkt(prec);
+
+      auto const& p = queries[(i * 7 + 3) % queries.size()];
+      if (p.AlmostEquals(q, prec) || p.DistanceTo(q, prec) == 0) {
+        continue;
+      }
+      auto line = g::Line2D::Make(q, p, prec);
+      auto ray = g::Ray2D::Make(q, p - q, prec);
+      auto segment = g::LineSegment2D::Make(q, p, prec);
+      expect_same(scan(line, prec), to_vector(polyline.Intersection(line, prec)));
+      expect_same(scan(ray, prec), to_vector(polyline.Intersection(ray, prec)));
+      expect_same(scan(segment, prec), to_vector(polyline.Intersection(segment, prec)));
+    }
+  }
+
+  // copies share the hierarchy
+  auto copy = polyline;
+  ASSERT_EQ(polyline.DistanceTo(queries[0]), copy.DistanceTo(queries[0]));
+}
+
+TEST(Polyline2D, Simplify) {
+  auto polyline = g::Polyline2D::FromWkt("LINESTRING (0 0, 1 0.01, 2 0, 2 2)");
+  using S = g::Simplification;
+
+  // Douglas-Peucker: (2 0) is 1.414 from the chord, then (1 0.01) is 0.01 from (0 0, 2 0)
+  EXPECT_EQ(polyline, polyline.Simplify(0.005));
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 0, 2 2)"), polyline.Simplify(0.1));
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 2)"), polyline.Simplify(2));
+
+  // Visvalingam-Whyatt: the triangle of (1 0.01) has area 0.01, then the one of (2 0) has area 2
+  EXPECT_EQ(polyline, polyline.Simplify(0.005, S::VISVALINGAM_WHYATT));
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 0, 2 2)"), polyline.Simplify(1.5, S::VISVALINGAM_WHYATT));
+  EXPECT_EQ(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 2)"), polyline.Simplify(3, S::VISVALINGAM_WHYATT));
+
+  auto significance = polyline.Significance(S::VISVALINGAM_WHYATT);
+  ASSERT_EQ(4, significance.size());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), significance[0]);
+  EXPECT_NEAR(0.01, significance[1], 1e-12);
+  EXPECT_NEAR(2, significance[2], 1e-12);
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), significance[3]);
+
+  // a closed polyline down to its ends
+  EXPECT_ANY_THROW(g::Polyline2D::FromWkt("LINESTRING (0 0, 1 0, 1 1, 0 0)").Simplify(10));
+
+  auto polyline_f = g::Polyline2Df::Make(polyline);
+  EXPECT_EQ(g::Polyline2Df::Make(g::Polyline2D::FromWkt("LINESTRING (0 0, 2 0, 2 2)")), polyline_f.Simplify(0.1));
+}
+
+TEST(Polyline2D, SimplifyRandomWalk) {
+  std::mt19937 gen(11);
+  auto polyline = random_walk(3001, gen, 0, 0, g::DP_SIX);
+
+  for (auto method : {g::Simplification::DOUGLAS_PEUCKER, g::Simplification::VISVALINGAM_WHYATT}) {
+    auto significance = polyline.Significance(method);
+    int previous = polyline.Size();
+    for (double tolerance : {0.1, 0.5, 1.0, 2.0, 5.0}) {
+      auto simplified = polyline.Simplify(tolerance, method, g::DP_SIX);
+      ASSERT_LE(simplified.Size(), previous);
+      previous = simplified.Size();
+
+      // the knots of significance above the tolerance
+      std::vector<g::Point2D> kept;
+      for (int i = 0; i < polyline.Size(); ++i) {
+        if (significance[i] > tolerance) {
+          kept.push_back(polyline.Knots()[i]);
+        }
+      }
+      ASSERT_EQ(g::Polyline2D::Make(kept, g::DP_SIX), simplified);
+      ASSERT_EQ(polyline.Knots().front(), simplified.Knots().front());
+      ASSERT_EQ(polyline.Knots().back(), simplified.Knots().back());
+
+      if (method == g::Simplification::DOUGLAS_PEUCKER) {  // no knot farther than the tolerance
+        for (auto const& knot : polyline.Knots()) {
+          ASSERT_LE(simplified.DistanceTo(knot, g::DP_SIX), tolerance);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace geompp_tests
\ No newline at end of file
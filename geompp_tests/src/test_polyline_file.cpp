@@ -0,0 +1,114 @@
+#include "polyline_file.hpp"
+
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+namespace fs = std::filesystem;
+
+namespace geompp_tests {
+
+extern fs::path test_res_path;
+
+TEST(PolylineFile, WriteAndMap) {
+  std::string path = (test_res_path / "temp" / "polylines.bin").string();
+  std::mt19937 gen(1);
+  auto polylines = random_polylines(500, gen, 2, 40, g::DP_SIX);
+
+  for (auto layout : {g::CoordinateLayout::SEPARATE, g::CoordinateLayout::INTERLEAVED}) {
+    g::PolylineFile::Write(path, polylines, layout);
+    auto file = g::PolylineFile::Open(path);
+    ASSERT_EQ(polylines.size(), file.Size());
+    ASSERT_EQ(layout, file.Layout());
+
+    int vertices = 0;
+    for (int i = 0; i < polylines.size(); ++i) {
+      auto view = file.At(i);
+      ASSERT_EQ(polylines[i].Size(), view.Size());
+      for (int k = 0; k < view.Size(); ++k) {
+        ASSERT_EQ(polylines[i].Knots()[k].x(), view.At(k).x());
+        ASSERT_EQ(polylines[i].Knots()[k].y(), view.At(k).y());
+      }
+      ASSERT_TRUE(polylines[i].BoundingBox().AlmostEquals(view.BoundingBox(), g::DP_NINE));
+      ASSERT_EQ(polylines[i], view.ToPolyline(g::DP_SIX));
+      vertices += view.Size();
+    }
+    ASSERT_EQ(vertices, file.Vertices());
+
+    auto window = g::BoundingBox2D::Make({-10, -10}, {30, 20});
+    std::vector<int> expected;
+    for (int i = 0; i < polylines.size(); ++i) {
+      if (polylines[i].BoundingBox().Intersects(window)) {
+        expected.push_back(i);
+      }
+    }
+    ASSERT_EQ(expected, file.Window(window));
+  }
+
+  EXPECT_NO_THROW(fs::remove(path));
+}
+
+TEST(PolylineFile, Streaming) {
+  std::string path = (test_res_path / "temp" / "polylines.bin").string();
+  std::mt19937 gen(2);
+  auto polylines = random_polylines(3, gen, 2, 40, g::DP_SIX);
+  {
+    auto writer = g::PolylineFileWriter::Open(path);
+    for (auto const& polyline : polylines) {
+      writer.Write(polyline);
+    }
+  }  // closed by the destructor
+
+  auto file = g::PolylineFile::Open(path);
+  ASSERT_EQ(3, file.Size());
+  ASSERT_EQ(polylines[2], file.At(2).ToPolyline(g::DP_SIX));
+  ASSERT_ANY_THROW(file.At(3));
+
+  // moved, the views still read the same mapping
+  auto moved = std::move(file);
+  ASSERT_EQ(polylines[0], moved.At(0).ToPolyline(g::DP_SIX));
+
+  EXPECT_NO_THROW(fs::remove(path));
+}
+
+TEST(PolylineFile, Errors) {
+  std::string path = (test_res_path / "temp" / "polylines.bin").string();
+  EXPECT_ANY_THROW(g::PolylineFile::Open(path));  // no file
+
+  std::ofstream(path, std::ios::binary) << "LINESTRING (0 0, 1 1)";
+  EXPECT_ANY_THROW(g::PolylineFile::Open(path));  // too short
+
+  std::ofstream(path, std::ios::binary) << std::string(64, 'x');
+  EXPECT_ANY_THROW(g::PolylineFile::Open(path));  // not a polyline file
+
+  // cut
+  g::PolylineFile::Write(path, {g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}})});
+  fs::resize_file(path, fs::file_size(path) - 8);
+  EXPECT_ANY_THROW(g::PolylineFile::Open(path));
+
+  // more polylines than an int counts
+  g::PolylineFile::Write(path, {g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}})});
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    std::uint64_t size = std::uint64_t{1} << 32 | 1;  // 1 once narrowed to an int
+    file.seekp(16);
+    file.write(reinterpret_cast<char const*>(&size), sizeof(size));
+  }
+  EXPECT_ANY_THROW(g::PolylineFile::Open(path));
+
+  // empty
+  g::PolylineFile::Write(path, {});
+  EXPECT_EQ(0, g::PolylineFile::Open(path).Size());
+
+  EXPECT_NO_THROW(fs::remove(path));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "polyline_pyramid.hpp"
+
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(PolylinePyramid, SameAsSimplify) {
+  std::mt19937 gen(5);
+  auto polyline = random_walk(2000, gen, 0, 0, g::DP_SIX);
+
+  for (auto method : {g::Simplification::DOUGLAS_PEUCKER, g::Simplification::VISVALINGAM_WHYATT}) {
+    auto pyramid = g::PolylinePyramid::Make(polyline, method);
+    ASSERT_EQ(polyline.Size(), pyramid.Size());
+    ASSERT_EQ(method, pyramid.Method());
+    ASSERT_EQ(polyline.Size(), pyramid.Count(-1));
+    ASSERT_EQ(2, pyramid.Count(1e9));
+
+    for (double tolerance : {0.0, 0.05, 0.3, 1.0, 4.0, 20.0}) {
+      auto simplified = polyline.Simplify(tolerance, method, g::DP_SIX);
+      ASSERT_EQ(simplified.Size(), pyramid.Count(tolerance));
+      ASSERT_EQ(simplified, pyramid.At(tolerance, g::DP_SIX)) << tolerance;
+    }
+  }
+}
+
+TEST(PolylinePyramid, Levels) {
+  std::mt19937 gen(9);
+  auto polyline = random_walk(1000, gen, 0, 0, g::DP_SIX);
+  auto pyramid = g::PolylinePyramid::Make(polyline);
+
+  // each level has at most half the knots of the one below, with a tolerance not below it
+  double below = pyramid.Tolerance(pyramid.Size());
+  EXPECT_EQ(pyramid.Size(), pyramid.Count(below));
+  for (int level = 1; (pyramid.Size() >> level) >= 2; ++level) {
+    int knots = pyramid.Size() >> level;
+    double tolerance = pyramid.Tolerance(knots);
+    ASSERT_LE(pyramid.Count(tolerance), knots);
+    ASSERT_GE(tolerance, below);
+    ASSERT_EQ(polyline.Simplify(tolerance, g::Simplification::DOUGLAS_PEUCKER, g::DP_SIX),
+              pyramid.At(tolerance, g::DP_SIX));
+    below = tolerance;
+  }
+  EXPECT_EQ(2, pyramid.At(pyramid.Tolerance(0)).Size());
+}
+
+}  // namespace geompp_tests
@@ -0,0 +1,94 @@
+#include "predicates.hpp"
+
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "segment_sweep.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(Predicates, Orient2D) {
+  ASSERT_GT(g::orient2d(g::Point2D(0, 0), g::Point2D(1, 0), g::Point2D(0, 1)), 0);
+  ASSERT_LT(g::orient2d(g::Point2D(0, 0), g::Point2D(0, 1), g::Point2D(1, 0)), 0);
+  ASSERT_EQ(0, g::orient2d(g::Point2D(0, 0), g::Point2D(1, 1), g::Point2D(3, 3)));
+
+  // a point a few ulps away from the line y = x: orient2d(a, b, c) = 12 * (ay - ax) exactly, the naive
+  // floating point determinant gets the sign wrong for many of these
+  double ulp = std::pow(2, -53);
+  for (int i = 0; i < 64; ++i) {
+    for (int j = 0; j < 64; ++j) {
+      g::Point2D a(0.5 + i * ulp, 0.5 + j * ulp);
+      int expected = (j > i) - (j < i);
+      ASSERT_EQ(expected, g::orientation(a, g::Point2D(12, 12), g::Point2D(24, 24))) << i << " " << j;
+    }
+  }
+}
+
+TEST(Predicates, InCircle) {
+  g::Point2D a(1, 0), b(0, 1), c(-1, 0);
+  ASSERT_GT(g::incircle(a, b, c, g::Point2D(0, 0)), 0);
+  ASSERT_LT(g::incircle(a, b, c, g::Point2D(2, 2)), 0);
+  ASSERT_EQ(0, g::incircle(a, b, c, g::Point2D(0, -1)));
+
+  // cocircular points far from the origin, and a point moved by one ulp
+  double off = 1e8;
+  g::Point2D fa(off + 3, off), fb(off, off + 3), fc(off - 3, off);
+  ASSERT_EQ(0, g::incircle(fa, fb, fc, g::Point2D(off, off - 3)));
+  ASSERT_GT(g::incircle(fa, fb, fc, g::Point2D(off, std::nextafter(off - 3, off))), 0);
+  ASSERT_LT(g::incircle(fa, fb, fc, g::Point2D(off, std::nextafter(off - 3, 0.0))), 0);
+}
+
+TEST(Predicates, SegmentsIntersect) {
+  ASSERT_TRUE(g::segments_intersect(g::Point2D(0, 0), g::Point2D(2, 2), g::Point2D(0, 2), g::Point2D(2, 0)));
+  ASSERT_TRUE(g::segments_intersect(g::Point2D(0, 0), g::Point2D(2, 0), g::Point2D(1, 0), g::Point2D(1, 1)));  // touch
+  // overlap
+  ASSERT_TRUE(g::segments_intersect(g::Point2D(0, 0), g::Point2D(2, 0), g::Point2D(1, 0), g::Point2D(3, 0)));
+  ASSERT_FALSE(g::segments_intersect(g::Point2D(0, 0), g::Point2D(2, 0), g::Point2D(3, 0), g::Point2D(4, 0)));
+  ASSERT_FALSE(g::segments_intersect(g::Point2D(0, 0), g::Point2D(2, 0), g::Point2D(0, 1e-300), g::Point2D(2, 1e-300)));
+
+  // exact opt-in of the segment intersection: no tolerance, a 1e-6 gap is a gap
+  auto s1 = g::LineSegment2D::Make(g::Point2D(0, 0), g::Point2D(2, 0));
+  auto s2 = g::LineSegment2D::Make(g::Point2D(1, 1e-6), g::Point2D(1, 1));
+  ASSERT_TRUE(s1.Intersects(s2, g::DP_THREE));
+  ASSERT_FALSE(s1.Intersects(s2, g::EXACT));
+
+  auto s3 = g::LineSegment2D::Make(g::Point2D(1, -1), g::Point2D(1, 1));
+  auto inter = s1.Intersection(s3, g::EXACT);
+  ASSERT_TRUE(inter.has_value());
+  ASSERT_EQ(g::Point2D(1, 0), std::get<g::Point2D>(*inter));
+}
+
+TEST(Predicates, ExactSweep) {
+  // many nearly-degenerate segments all passing by (about) the same point
+  std::vector<g::LineSegment2D> segs;
+  double ulp = std::pow(2, -50);
+  for (int i = 0; i < 40; ++i) {
+    double a = i * 0.07;
+    segs.push_back(g::LineSegment2D::Make(g::Point2D(-std::cos(a) + i * ulp, -std::sin(a)),
+                                          g::Point2D(std::cos(a), std::sin(a) + i * ulp)));
+  }
+
+  int expected = 0;
+  for (int i = 0; i < segs.size(); ++i) {
+    for (int j = i + 1; j < segs.size(); ++j) {
+      expected += segs[i].Intersects(segs[j], g::EXACT);
+    }
+  }
+  ASSERT_EQ(expected, g::SegmentSweep::Make(segs).Intersection(g::EXACT).size());
+
+  auto poly1 = g::Polyline2D::FromWkt("LINESTRING (-1 2, -1 -2, 1 -2, 1 2)");
+  auto poly2 = g::Polyline2D::FromWkt("LINESTRING (-2 1, -0.5 1, -0.5 -3, 0.5 -3, 0.5 1, 2 1)");
+  ASSERT_TRUE(poly1.Intersects(poly2, g::EXACT));
+  auto mpoint = std::get<g::Polyline2D::MultiPoint>(*poly1.Intersection(poly2, g::EXACT));
+  ASSERT_EQ(4, mpoint.size());
+  ASSERT_EQ(g::Point2D(-1, 1), mpoint[0]);
+  ASSERT_EQ(g::Point2D(1, 1), mpoint[3]);
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
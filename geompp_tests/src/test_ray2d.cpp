@@ -157,6 +157,17 @@ TEST(Ray2D, Wkt) {
   EXPECT_ANY_THROW(g::Ray2D::FromWkt("ray ( -7.5 -64.4 15.5, 0 0 0)"));
 }
 
+TEST(Ray2D, TryMake) {
+  auto ray = g::Ray2D::TryMake(g::Point2D(1, 2), g::Vector2D(3, 4));
+  ASSERT_TRUE(ray.has_value());
+  EXPECT_EQ(g::Ray2D::Make(g::Point2D(1, 2), g::Vector2D(3, 4)), *ray);
+  EXPECT_EQ(g::GeomError::ZERO_DIRECTION, g::Ray2D::TryMake(g::Point2D(1, 2), g::Vector2D()).error());
+
+  EXPECT_EQ(g::Ray2D::FromWkt("RAY (0 0, 1 1)"), g::Ray2D::TryFromWkt("RAY (0 0, 1 1)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Ray2D::TryFromWkt("ray ( -7.5 )").error());
+  EXPECT_EQ(g::GeomError::ZERO_DIRECTION, g::Ray2D::TryFromWkt("RAY (1 1, 0 0)").error());
+}
+
 TEST(Ray2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "ray.wkt").string();
@@ -0,0 +1,104 @@
+#include "rtree.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "ray2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+namespace {
+
+// the indices of all the items where pred is true
+template <typename Geometry, typename Pred>
+std::vector<int> scan(std::vector<Geometry> const& items, Pred&& pred) {
+  std::vector<int> found;
+  for (int i = 0; i < items.size(); ++i) {
+    if (pred(items[i])) {
+      found.push_back(i);
+    }
+  }
+  return found;
+}
+
+template <typename Geometry>
+void expect_same_as_scan(std::vector<Geometry> const& items, std::mt19937& gen) {
+  auto tree = g::RTree<Geometry>::Make(items);
+  ASSERT_EQ(items.size(), tree.Size());
+
+  std::uniform_real_distribution<double> coord(-110, 110);
+  for (int q = 0; q < 50; ++q) {
+    g::Point2D p0(coord(gen), coord(gen)), p1(coord(gen), coord(gen));
+    auto window = g::BoundingBox2D::Make(p0, p1);
+    ASSERT_EQ(scan(items, [&window](auto const& item) { return item.BoundingBox().Intersects(window); }),
+              tree.Window(window));
+
+    auto line = g::Line2D::Make(p0, p1);
+    auto ray = g::Ray2D::Make(p0, p1 - p0);
+    auto segment = g::LineSegment2D::Make(p0, p0 + 0.1 * (p1 - p0));
+    ASSERT_EQ(scan(items, [&line](auto const& item) { return item.Intersects(line); }), tree.Intersecting(line));
+    ASSERT_EQ(scan(items, [&ray](auto const& item) { return item.Intersects(ray); }), tree.Intersecting(ray));
+    ASSERT_EQ(scan(items, [&segment](auto const& item) { return item.Intersects(segment); }),
+              tree.Intersecting(segment));
+
+    for (int k : {1, 5, 40}) {
+      std::vector<std::tuple<double, int>> expected;
+      for (int i = 0; i < items.size(); ++i) {
+        expected.emplace_back(items[i].DistanceTo(p0), i);
+      }
+      std::sort(expected.begin(), expected.end());
+      auto nearest = tree.Nearest(p0, k);
+      ASSERT_EQ(std::min<int>(k, items.size()), nearest.size());
+      for (int i = 0; i < nearest.size(); ++i) {
+        ASSERT_EQ(std::get<0>(expected[i]), nearest[i].distance) << p0.ToWkt();
+        ASSERT_EQ(std::get<1>(expected[i]), nearest[i].index);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(RTree, Segments) {
+  std::mt19937 gen(1);
+  for (int size : {1, 16, 17, 3000}) {
+    expect_same_as_scan(random_segments(size, gen, 100, 3), gen);
+  }
+}
+
+TEST(RTree, Polylines) {
+  std::mt19937 gen(2);
+  for (int size : {1, 300}) {
+    expect_same_as_scan(random_polylines(size, gen, 11, 11), gen);
+  }
+}
+
+TEST(RTree, Empty) {
+  auto tree = g::SegmentRTree::Make({});
+  ASSERT_EQ(0, tree.Size());
+  ASSERT_TRUE(tree.BoundingBox().IsEmpty());
+  ASSERT_TRUE(tree.Window(g::BoundingBox2D::Make({0, 0}, {1, 1})).empty());
+  ASSERT_TRUE(tree.Nearest({0, 0}, 3).empty());
+}
+
+TEST(RTree, BoundingBox) {
+  auto tree = g::SegmentRTree::Make(
+      {g::LineSegment2D::Make({0, 0}, {1, 1}), g::LineSegment2D::Make({5, -2}, {3, 4})});
+  ASSERT_TRUE(tree.BoundingBox().AlmostEquals(g::BoundingBox2D::Make({0, -2}, {5, 4})));
+  ASSERT_EQ((std::vector<int>{1}), tree.Window(g::BoundingBox2D::Make({2, 2}, {6, 3})));
+  ASSERT_TRUE(tree.At(1).AlmostEquals(g::LineSegment2D::Make({5, -2}, {3, 4})));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "segment_sweep.hpp"
+
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "test_data.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(SegmentSweep, Crossings) {
+  int prec = 4;
+  std::vector<g::LineSegment2D> segs{
+      g::LineSegment2D::FromWkt("LINESTRING (-2 -2, 2 2)"),  // 0
+      g::LineSegment2D::FromWkt("LINESTRING (-2 2, 2 -2)"),  // 1, crosses 0 at (0 0)
+      g::LineSegment2D::FromWkt("LINESTRING (0 -3, 0 3)"),   // 2, vertical, crosses 0 and 1 at (0 0), 3 at (0 1)
+      g::LineSegment2D::FromWkt("LINESTRING (-3 1, 3 1)"),   // 3, crosses 0, 1, 2
+      g::LineSegment2D::FromWkt("LINESTRING (5 5, 6 6)"),    // 4, far away
+  };
+
+  auto sweep = g::SegmentSweep::Make(segs);
+  ASSERT_TRUE(sweep.Intersects(prec));
+
+  auto crossings = sweep.Intersection(prec);
+  ASSERT_EQ(6, crossings.size());
+  EXPECT_EQ(0, crossings[0].first);
+  EXPECT_EQ(1, crossings[0].second);
+  EXPECT_EQ(g::Point2D(0, 0), crossings[0].point);
+  EXPECT_EQ(g::Point2D(0, 0), crossings[1].point);
+  EXPECT_EQ(g::Point2D(1, 1), crossings[2].point);
+  EXPECT_EQ(g::Point2D(0, 0), crossings[3].point);
+  EXPECT_EQ(g::Point2D(-1, 1), crossings[4].point);
+  EXPECT_EQ(2, crossings[5].first);
+  EXPECT_EQ(3, crossings[5].second);
+  EXPECT_EQ(g::Point2D(0, 1), crossings[5].point);
+
+  // parallel and touching at the end point
+  std::vector<g::LineSegment2D> no_cross{g::LineSegment2D::FromWkt("LINESTRING (0 0, 1 0)"),
+                                         g::LineSegment2D::FromWkt("LINESTRING (0 1, 1 1)")};
+  ASSERT_FALSE(g::SegmentSweep::Make(no_cross).Intersects(prec));
+
+  std::vector<g::LineSegment2D> touch{g::LineSegment2D::FromWkt("LINESTRING (0 0, 2 0)"),
+                                      g::LineSegment2D::FromWkt("LINESTRING (1 0, 1 1)")};
+  auto touch_crossings = g::SegmentSweep::Make(touch).Intersection(prec);
+  ASSERT_EQ(1, touch_crossings.size());
+  EXPECT_EQ(g::Point2D(1, 0), touch_crossings[0].point);
+}
+
+TEST(SegmentSweep, RedBlue) {
+  int prec = 4;
+  auto red = g::Polyline2D::FromWkt("LINESTRING (-1 2, -1 -2, 1 -2, 1 2)").ToSegments();
+  auto blue = g::Polyline2D::FromWkt("LINESTRING (-2 1, -0.5 1, -0.5 -3, 0.5 -3, 0.5 1, 2 1)").ToSegments();
+
+  // the consecutive segments of a polyline touch at their knots, but only red/blue pairs are reported
+  auto crossings = g::SegmentSweep::Make(red, blue).Intersection(prec);
+  ASSERT_EQ(4, crossings.size());
+  EXPECT_EQ(0, crossings[0].first);
+  EXPECT_EQ(0, crossings[0].second);
+  EXPECT_EQ(g::Point2D(-1, 1), crossings[0].point);
+  EXPECT_EQ(g::Point2D(-0.5, -2), crossings[1].point);
+  EXPECT_EQ(g::Point2D(0.5, -2), crossings[2].point);
+  EXPECT_EQ(2, crossings[3].first);
+  EXPECT_EQ(4, crossings[3].second);
+  EXPECT_EQ(g::Point2D(1, 1), crossings[3].point);
+}
+
+TEST(SegmentSweep, SameAsBruteForce) {
+  int prec = 6;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(-100, 100);
+
+  std::vector<g::LineSegment2D> segs;
+  for (int i = 0; i < 300; ++i) {
+    segs.push_back(g::LineSegment2D::Make(g::Point2D(coord(gen), coord(gen)), g::Point2D(coord(gen), coord(gen))));
+  }
+
+  std::vector<std::pair<int, int>> expected;
+  for (int i = 0; i < segs.size(); ++i) {
+    for (int j = i + 1; j < segs.size(); ++j) {
+      if (segs[i].Intersects(segs[j], prec)) {
+        expected.push_back({i, j});
+      }
+    }
+  }
+
+  auto crossings = g::SegmentSweep::Make(segs).Intersection(prec);
+  ASSERT_EQ(expected.size(), crossings.size());
+  for (int i = 0; i < crossings.size(); ++i) {
+    EXPECT_EQ(expected[i].first, crossings[i].first);
+    EXPECT_EQ(expected[i].second, crossings[i].second);
+  }
+}
+
+TEST(SegmentSweep, PolylinesSameAsBruteForce) {
+  int prec = 4;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> step(0.5, 1.5);
+  std::uniform_real_distribution<double> amplitude(-3, 3);
+
+  // two zig-zags along the x axis, crossing each other many times, sharing some knots
+  std::vector<g::Point2D> knots1, knots2;
+  double x1 = 0, x2 = 0;
+  for (int i = 0; i < 200; ++i) {
+    knots1.push_back(g::Point2D(x1, amplitude(gen)));
+    knots2.push_back(g::Point2D(x2, (i % 10 == 0) ? knots1.back().y() : amplitude(gen)));
+    x1 += step(gen);
+    x2 = x1;
+  }
+  auto poly1 = g::Polyline2D::Make(knots1, prec);
+  auto poly2 = g::Polyline2D::Make(knots2, prec);
+
+  g::Polyline2D::MultiPoint expected;
+  for (auto const& s1 : poly1.ToSegments()) {
+    for (auto const& s2 : poly2.ToSegments()) {
+      auto inter = s1.Intersection(s2, prec);
+      if (inter.has_value()) {
+        expected.push_back(std::get<g::Point2D>(*inter));
+      }
+    }
+  }
+
+  auto inter = poly1.Intersection(poly2, prec);
+  ASSERT_TRUE(inter.has_value());
+  ASSERT_TRUE(std::holds_alternative<g::Polyline2D::MultiPoint>(*inter));
+  auto mpoint = std::get<g::Polyline2D::MultiPoint>(*inter);
+  ASSERT_EQ(expected.size(), mpoint.size());
+  for (int i = 0; i < mpoint.size(); ++i) {
+    EXPECT_EQ(expected[i], mpoint[i]);
+  }
+}
+
+TEST(SegmentSweep, WalksSameAsBruteForce) {
+  // two random walks folded in a small square: dense, with steep and short segments, and segments touching within the
+  // tolerance without crossing
+  std::mt19937 gen(3);
+  auto red = random_walk(3000, gen, 0, 40).ToSegments(), blue = random_walk(2000, gen, 0, 40).ToSegments();
+  auto sweep = g::SegmentSweep::Make(red, blue);
+
+  auto expect_same = [&red, &blue](auto const& intersection, std::vector<g::SegmentSweep::Crossing> const& crossings) {
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < red.size(); ++i) {
+      for (int j = 0; j < blue.size(); ++j) {
+        if (intersection(red[i], blue[j])) {
+          expected.push_back({i, j});
+        }
+      }
+    }
+    ASSERT_EQ(expected.size(), crossings.size());
+    for (int i = 0; i < crossings.size(); ++i) {
+      ASSERT_EQ(expected[i].first, crossings[i].first);
+      ASSERT_EQ(expected[i].second, crossings[i].second);
+    }
+  };
+  expect_same([](auto const& s1, auto const& s2) { return s1.Intersects(s2, g::DP_THREE); },
+              sweep.Intersection(g::DP_THREE));
+  expect_same([](auto const& s1, auto const& s2) { return s1.Intersects(s2, g::EXACT); }, sweep.Intersection(g::EXACT));
+}
+
+TEST(SegmentSweep, ZigZagsApart) {
+  // two zig-zags side by side, mirrored, each with all its segments across the same x range: all the boxes of one are
+  // open together in the sweep
+  int size = 20000;
+  auto zig_zags = [size](double offset) {
+    std::vector<g::LineSegment2D> red, blue;
+    for (int i = 0; i < size; ++i) {
+      red.push_back(g::LineSegment2D::Make(g::Point2D(i % 2, i), g::Point2D(1 - i % 2, i + 1)));
+      blue.push_back(g::LineSegment2D::Make(g::Point2D(offset + 1 - i % 2, i), g::Point2D(offset + i % 2, i + 1)));
+    }
+    return std::make_pair(red, blue);
+  };
+
+  // apart: none touches the other zig-zag
+  auto [red, blue] = zig_zags(2);
+  auto sweep = g::SegmentSweep::Make(red, blue);
+  EXPECT_FALSE(sweep.Intersects(g::DP_THREE));
+  EXPECT_TRUE(sweep.Intersection(g::DP_THREE).empty());
+
+  // within the tolerance: they touch at every other knot, only segments at most one apart can meet
+  std::tie(red, blue) = zig_zags(1.0001);
+  std::vector<std::pair<int, int>> expected;
+  for (int i = 0; i < size; ++i) {
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, size - 1); ++j) {
+      if (red[i].Intersects(blue[j], g::DP_THREE)) {
+        expected.push_back({i, j});
+      }
+    }
+  }
+  auto crossings = g::SegmentSweep::Make(red, blue).Intersection(g::DP_THREE);
+  ASSERT_LE(size, expected.size());
+  ASSERT_EQ(expected.size(), crossings.size());
+  for (int i = 0; i < crossings.size(); ++i) {
+    ASSERT_EQ(expected[i].first, crossings[i].first);
+    ASSERT_EQ(expected[i].second, crossings[i].second);
+  }
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
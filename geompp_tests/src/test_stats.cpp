@@ -0,0 +1,76 @@
+#include "stats.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "ray2d.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+namespace {
+
+// the entry of that name, or a zero one
+g::stats::Entry find(std::vector<g::stats::Entry> const& entries, std::string const& name) {
+  auto found = std::ranges::find(entries, name, &g::stats::Entry::name);
+  return found != entries.end() ? *found : g::stats::Entry{name};
+}
+
+}  // namespace
+
+TEST(Stats, Counters) {
+  g::stats::Reset();
+  for (int i = 1; i <= 3; ++i) {
+    g::LineSegment2D::Make({0, 0}, {1.0 * i, 1});
+  }
+  EXPECT_ANY_THROW(g::Polyline2D::FromWkt("LINESTRING (0 0, 1"));
+  std::thread([] { g::LineSegment2D::Make({0, 0}, {5, 5}); }).join();  // ended, and still counted
+
+  auto entries = g::stats::Snapshot();
+  if (!g::stats::ENABLED) {
+    EXPECT_TRUE(entries.empty());
+    return;
+  }
+  ASSERT_TRUE(std::ranges::is_sorted(entries, {}, &g::stats::Entry::name));
+  EXPECT_EQ(4, find(entries, "LineSegment2D::Make").calls);
+  EXPECT_LT(0, find(entries, "LineSegment2D::Make").cycles);
+  EXPECT_EQ(1, find(entries, "Polyline2D::FromWkt failed").calls);
+  EXPECT_EQ(0, find(entries, "Polyline2D::FromWkt failed").cycles);
+  EXPECT_NE(std::string::npos, g::stats::Dump(entries).find("LineSegment2D::Make"));
+
+  g::stats::Reset();
+  EXPECT_TRUE(g::stats::Snapshot().empty());
+}
+
+TEST(Stats, ParallelIntersections) {
+  g::stats::Reset();
+  auto segment = g::LineSegment2D::Make({0, 0}, {2, 0});
+  auto ray = g::Ray2D::Make({0, 1}, g::Vector2D(1, 0));
+  auto line = g::Line2D::Make(g::Point2D(0, 2), g::Point2D(1, 2));
+  EXPECT_FALSE(segment.Intersection(g::LineSegment2D::Make({0, 1}, {2, 1})).has_value());
+  EXPECT_FALSE(segment.Intersection(ray).has_value());
+  EXPECT_FALSE(segment.Intersection(line).has_value());
+  EXPECT_FALSE(ray.Intersection(line).has_value());
+  EXPECT_FALSE(ray.Intersection(g::Ray2D::Make({0, 3}, g::Vector2D(-1, 0))).has_value());
+  EXPECT_FALSE(line.Intersection(g::Line2D::Make(g::Point2D(0, 3), g::Point2D(1, 3))).has_value());
+  EXPECT_TRUE(segment.Intersection(g::LineSegment2D::Make({1, -1}, {1, 1})).has_value());  // not parallel
+
+  auto entries = g::stats::Snapshot();
+  if (!g::stats::ENABLED) {
+    EXPECT_TRUE(entries.empty());
+    return;
+  }
+  EXPECT_EQ(3, find(entries, "LineSegment2D::Intersection parallel").calls);
+  EXPECT_EQ(2, find(entries, "Ray2D::Intersection parallel").calls);
+  EXPECT_EQ(1, find(entries, "Line2D::Intersection parallel").calls);
+  g::stats::Reset();
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "tolerance.hpp"
+
+#include "utils.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+namespace {
+
+// values around the rounding thresholds of the precision, and some random ones
+std::vector<double> sample_values(int prec) {
+  std::vector<double> values{0.0, -0.0, 1.0, -1.0, 0.5, -0.5, 1e-12, -1e-12, 123.456, -987.654321};
+  double half = 0.5 / std::pow(10, prec);
+  for (double x : {half, 1.0 + half, 2.0 + half}) {
+    for (double v : {x, std::nextafter(x, 0.0), std::nextafter(x, 10.0)}) {
+      values.push_back(v);
+      values.push_back(-v);
+    }
+  }
+  std::mt19937 gen(prec + 100);
+  std::uniform_real_distribution<double> dist(-3 * half, 3 * half);
+  std::uniform_real_distribution<double> dist_one(1 - 3 * half, 1 + 3 * half);
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(dist(gen));
+    values.push_back(dist_one(gen));
+  }
+  return values;
+}
+
+template <typename Tol>
+void expect_same_as_round_to(Tol const& tol, int prec) {
+  for (double x : sample_values(prec)) {
+    ASSERT_EQ(g::round_to(x, prec) == 0, tol.IsZero(x)) << x;
+    ASSERT_EQ(g::round_to(x, prec) > 0, tol.IsPositive(x)) << x;
+    ASSERT_EQ(g::round_to(x, prec) < 0, tol.IsNegative(x)) << x;
+    ASSERT_EQ(g::round_to(x, prec) >= 0, tol.IsNonNegative(x)) << x;
+    ASSERT_EQ(g::round_to(x, prec) <= 0, tol.IsNonPositive(x)) << x;
+    ASSERT_EQ(g::round_to(x, prec) > 1, tol.IsAbove(x, 1)) << x;
+    ASSERT_EQ(g::sign(x, prec), tol.Sign(x)) << x;
+  }
+}
+
+}  // namespace
+
+TEST(Tolerance, PowerOfTen) {
+  for (int i = -5; i <= 25; ++i) {
+    ASSERT_EQ(std::pow(10, i), g::power_of_ten(i));
+  }
+  static_assert(g::power_of_ten(g::DP_SIX) == 1e6);
+  static_assert(g::Tolerance<g::DP_NINE>().Scale() == 1e9);
+}
+
+TEST(Tolerance, SameAsRoundTo) {
+  expect_same_as_round_to(g::Tolerance<g::DP_THREE>(), g::DP_THREE);
+  expect_same_as_round_to(g::Tolerance<g::DP_SIX>(), g::DP_SIX);
+  expect_same_as_round_to(g::Tolerance<g::DP_NINE>(), g::DP_NINE);
+
+  for (int prec : {-1, 0, 1, 2, 4, 5, 12}) {
+    expect_same_as_round_to(g::Tolerance(prec), prec);
+  }
+
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_FALSE(g::Tolerance<g::DP_THREE>().IsZero(nan));
+  ASSERT_FALSE(g::Tolerance<g::DP_THREE>().IsNonNegative(nan));
+}
+
+TEST(Tolerance, WithTolerance) {
+  for (int prec : {g::DP_THREE, g::DP_SIX, g::DP_NINE, 4}) {
+    double scale = g::with_tolerance(prec, [](auto tol) { return tol.Scale(); });
+    ASSERT_EQ(std::pow(10, prec), scale);
+  }
+
+  ASSERT_TRUE(g::with_tolerance(g::DP_THREE, [](auto tol) { return tol.AlmostEquals(1.0, 1.0004); }));
+  ASSERT_FALSE(g::with_tolerance(g::DP_SIX, [](auto tol) { return tol.AlmostEquals(1.0, 1.0004); }));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
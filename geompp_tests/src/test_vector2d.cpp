@@ -54,6 +54,16 @@ TEST(Vector2D, PerpDotCross) {
   EXPECT_EQ(-1.0, g::round_to(v2.Cross(v1), prec));
 }
 
+TEST(Vector2D, Constexpr) {
+  constexpr g::Vector2D v = -(g::Vector2D(1, 2) + g::Vector2D(3, 4)) / 2;
+  static_assert(v.x() == -2 && v.y() == -3);
+  static_assert(v.Perp().Dot(v) == 0 && v * g::Vector2D::BasisX() == -2);
+
+  g::Vector2D w;
+  w = v;
+  ASSERT_EQ(g::Vector2D(-2, -3), w);
+}
+
 TEST(Vector2D, Wkt) {
   ASSERT_EQ("VECTOR (0 0)", g::Vector2D().ToWkt());
   ASSERT_EQ("VECTOR (56491.62 -795.97)", g::Vector2D(56491.6164, -795.97416).ToWkt(2));
@@ -71,6 +81,11 @@ TEST(Vector2D, Wkt) {
   EXPECT_ANY_THROW(g::Vector2D::FromWkt("vector ( -7.5 -64.4 15.5)"));
 }
 
+TEST(Vector2D, TryFromWkt) {
+  EXPECT_EQ(g::Vector2D(-7.5, -60.7), g::Vector2D::TryFromWkt("  vector( -7.5    -60.7)").value());
+  EXPECT_EQ(g::GeomError::BAD_WKT, g::Vector2D::TryFromWkt("vecto ( -7.5 -60.7)").error());
+}
+
 TEST(Vector2D, ToFile) {
   int prec = 4;
   std::string path = (test_res_path / "temp" / "vector.wkt").string();
@@ -0,0 +1,138 @@
+#include "wkb.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "ray2d.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace g = geompp;
+namespace fs = std::filesystem;
+
+namespace geompp_tests {
+
+extern fs::path test_res_path;
+
+TEST(Wkb, Bytes) {
+  // POINT (1 2): byte order, type 1, x = 1.0, y = 2.0
+  std::vector<std::uint8_t> little{0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0,
+                                   0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40};
+  std::vector<std::uint8_t> big{0x00, 0x00, 0x00, 0x00, 0x01, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  auto p = g::Point2D(1, 2);
+  EXPECT_EQ(little, p.ToWkb());
+  EXPECT_EQ(big, p.ToWkb(g::Endian::BIG));
+  EXPECT_EQ(p, g::Point2D::FromWkb(little));
+  EXPECT_EQ(p, g::Point2D::FromWkb(big));
+
+  // LINESTRING of 2 points: header, count, coordinates
+  auto segment = g::LineSegment2D::Make({0, 0}, {1, 1});
+  EXPECT_EQ(1 + 4 + 4 + 2 * 16, segment.ToWkb().size());
+}
+
+TEST(Wkb, RoundTrip) {
+  auto p = g::Point2D(56491.6164, -795.97416);
+  auto v = g::Vector2D(-0.125, 1e-9);
+  auto line = g::Line2D::Make(g::Point2D(256.1343, -684.64971), g::Point2D(-601.674503, 7.361975));
+  auto ray = g::Ray2D::Make(g::Point2D(-7.5, -60.7), g::Vector2D(3, 4));
+  auto segment = g::LineSegment2D::Make(g::Point2D(0.645, -1.689741), g::Point2D(1, 0));
+  auto polyline = g::Polyline2D::Make({{0, 0}, {1, 0.5}, {2, 0}, {3, 1.25}, {-4, 7}});
+
+  for (auto endian : {g::Endian::LITTLE, g::Endian::BIG}) {
+    // exact, no rounding through text
+    auto p_wkb = g::Point2D::FromWkb(p.ToWkb(endian));
+    EXPECT_EQ(p.x(), p_wkb.x());
+    EXPECT_EQ(p.y(), p_wkb.y());
+    auto v_wkb = g::Vector2D::FromWkb(v.ToWkb(endian));
+    EXPECT_EQ(v.x(), v_wkb.x());
+    EXPECT_EQ(v.y(), v_wkb.y());
+    EXPECT_EQ(line.First().x(), g::Line2D::FromWkb(line.ToWkb(endian)).First().x());
+
+    EXPECT_EQ(line, g::Line2D::FromWkb(line.ToWkb(endian)));
+    EXPECT_EQ(ray, g::Ray2D::FromWkb(ray.ToWkb(endian)));
+    EXPECT_EQ(segment, g::LineSegment2D::FromWkb(segment.ToWkb(endian)));
+    EXPECT_EQ(polyline, g::Polyline2D::FromWkb(polyline.ToWkb(endian)));
+  }
+}
+
+TEST(Wkb, Collections) {
+  std::vector<g::Point2D> points{{0, 0}, {1.5, -2}, {3, 4}};
+  std::vector<g::LineSegment2D> segments{g::LineSegment2D::Make({0, 0}, {1, 1}),
+                                         g::LineSegment2D::Make({2, 2}, {3, 0})};
+  std::vector<g::Polyline2D> polylines{g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}}),
+                                       g::Polyline2D::Make({{5, 5}, {6, 7}})};
+
+  for (auto endian : {g::Endian::LITTLE, g::Endian::BIG}) {
+    auto points_wkb = g::points_from_wkb(g::to_wkb(points, endian));
+    ASSERT_EQ(points.size(), points_wkb.size());
+    for (int i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(points[i], points_wkb[i]);
+    }
+
+    auto segments_wkb = g::segments_from_wkb(g::to_wkb(segments, endian));
+    ASSERT_EQ(segments.size(), segments_wkb.size());
+    for (int i = 0; i < segments.size(); ++i) {
+      EXPECT_EQ(segments[i], segments_wkb[i]);
+    }
+
+    auto polylines_wkb = g::polylines_from_wkb(g::to_wkb(polylines, endian));
+    ASSERT_EQ(polylines.size(), polylines_wkb.size());
+    for (int i = 0; i < polylines.size(); ++i) {
+      EXPECT_EQ(polylines[i], polylines_wkb[i]);
+    }
+  }
+
+  // the segments are also 2 point polylines, not the other way around
+  EXPECT_EQ(2, g::polylines_from_wkb(g::to_wkb(segments)).size());
+  EXPECT_ANY_THROW(g::segments_from_wkb(g::to_wkb(polylines)));
+  EXPECT_TRUE(g::points_from_wkb(g::to_wkb(std::vector<g::Point2D>{})).empty());
+}
+
+TEST(Wkb, Errors) {
+  auto wkb = g::Point2D(1, 2).ToWkb();
+  EXPECT_ANY_THROW(g::Point2D::FromWkb(std::span(wkb).first(wkb.size() - 1)));  // too short
+  EXPECT_ANY_THROW(g::Point2D::FromWkb({}));
+  EXPECT_ANY_THROW(g::Vector2D::FromWkb(g::LineSegment2D::Make({0, 0}, {1, 1}).ToWkb()));  // not a point
+
+  auto more = wkb;
+  more.push_back(0);
+  EXPECT_ANY_THROW(g::Point2D::FromWkb(more));  // bytes left
+
+  auto bad_flag = wkb;
+  bad_flag[0] = 2;
+  EXPECT_ANY_THROW(g::Point2D::FromWkb(bad_flag));
+
+  auto z = wkb;  // POINT Z
+  z[1] = 0xe9;
+  z[2] = 0x03;
+  EXPECT_ANY_THROW(g::Point2D::FromWkb(z));
+
+  // a count larger than the bytes
+  auto polyline = g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}}).ToWkb();
+  polyline[5] = 0xff;
+  EXPECT_ANY_THROW(g::Polyline2D::FromWkb(polyline));
+}
+
+TEST(Wkb, ToFile) {
+  std::string path = (test_res_path / "temp" / "polyline.wkb").string();
+  auto polyline = g::Polyline2D::Make({{12.32, -61.6164}, {-14.64661, -9.1641}, {3, 3}});
+
+  polyline.ToWkbFile(path, g::Endian::BIG);
+  ASSERT_TRUE(fs::exists(path));
+  EXPECT_EQ(polyline, g::Polyline2D::FromWkbFile(path));
+
+  std::vector<g::Point2D> points{{0, 0}, {1.5, -2}};
+  g::write_wkb_file(path, g::to_wkb(points));
+  EXPECT_EQ(2, g::points_from_wkb(g::read_wkb_file(path)).size());
+
+  EXPECT_NO_THROW(fs::remove(path));
+  EXPECT_ANY_THROW(g::Polyline2D::FromWkbFile(path));
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "wkt_reader.hpp"
+
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(WktReader, Tokens) {
+  g::WktReader reader("  multi  ( 1.5 -2, +3e2   4.25E-1 ) ");
+  reader.Tag("MULTI");
+  reader.Expect('(');
+  EXPECT_EQ(g::Point2D(1.5, -2), reader.Point());
+  EXPECT_FALSE(reader.Accept(')'));
+  EXPECT_TRUE(reader.Accept(','));
+  auto v = reader.Vector();
+  EXPECT_EQ(300, v.x());
+  EXPECT_EQ(0.425, v.y());
+  reader.Expect(')');
+  EXPECT_NO_THROW(reader.End());
+}
+
+TEST(WktReader, DecimalPlaces) {
+  auto places = [](std::string const& number) {
+    g::WktReader reader(number);
+    reader.Number();
+    return reader.DecimalPlaces();
+  };
+  EXPECT_EQ(0, places("12"));
+  EXPECT_EQ(0, places("12."));
+  EXPECT_EQ(2, places("12.3400"));
+  EXPECT_EQ(3, places("-5e-3"));
+  EXPECT_EQ(4, places("1.5e-3"));
+  EXPECT_EQ(0, places("1.5e2"));
+  EXPECT_EQ(1, places("1.25e+1"));
+
+  // the most of all the numbers read
+  g::WktReader reader("(1.5 2, 3 4.125, 5 6)");
+  EXPECT_EQ(3, reader.Points().size());
+  EXPECT_EQ(3, reader.DecimalPlaces());
+
+  // and the precision of Polyline2D::FromWkt: the middle knot is not collinear at 4 decimal places
+  EXPECT_EQ(3, g::Polyline2D::FromWkt("LINESTRING (0 0, 1 0.0004, 2 0)").Size());
+}
+
+TEST(WktReader, Errors) {
+  EXPECT_ANY_THROW(g::WktReader("POINTS (1 2)").Tag("POINT"));
+  EXPECT_ANY_THROW(g::WktReader("POIN (1 2)").Tag("POINT"));
+  EXPECT_ANY_THROW(g::WktReader("x").Number());
+  EXPECT_ANY_THROW(g::WktReader("+-1").Number());
+  EXPECT_ANY_THROW(g::WktReader("").Number());
+  EXPECT_ANY_THROW(g::WktReader("1-2").Point());
+  EXPECT_ANY_THROW(g::WktReader("1,2").Point());
+  EXPECT_ANY_THROW(g::WktReader("()").Points());
+  EXPECT_ANY_THROW(g::WktReader("(1 2,)").Points());
+  EXPECT_ANY_THROW(g::WktReader("(1 2").Points());
+  EXPECT_ANY_THROW(g::WktReader(") x").End());
+  EXPECT_ANY_THROW(g::Point2D::FromWkt("POINT (1 2) 3"));
+  EXPECT_NO_THROW(g::Point2D::FromWkt("POINT (1 2)\r\n"));
+}
+
+TEST(WktReader, ErrorsWithoutThrowing) {
+  g::WktReader reader("LINESTRING (1 2, 3 x, 5 6)", false);
+  reader.Tag("LINESTRING");
+  EXPECT_FALSE(reader.Failed());
+  EXPECT_NO_THROW(reader.Points());
+  EXPECT_TRUE(reader.Failed());
+  EXPECT_NO_THROW(reader.End());  // still failed, at the first error
+  EXPECT_TRUE(reader.Failed());
+
+  g::WktReader good("POINT (1 2)", false);
+  good.Tag("POINT");
+  good.Expect('(');
+  EXPECT_EQ(g::Point2D(1, 2), good.Point());
+  good.Expect(')');
+  good.End();
+  EXPECT_FALSE(good.Failed());
+}
+
+}  // namespace geompp_tests
\ No newline at end of file
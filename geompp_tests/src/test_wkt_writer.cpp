@@ -0,0 +1,97 @@
+#include "wkt_writer.hpp"
+
+#include "line2d.hpp"
+#include "line_segment2d.hpp"
+#include "point2d.hpp"
+#include "polyline2d.hpp"
+#include "ray2d.hpp"
+#include "utils.hpp"
+#include "vector2d.hpp"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace g = geompp;
+
+namespace geompp_tests {
+
+TEST(WktWriter, Numbers) {
+  char buf[32];
+  auto text = [&buf](double x, int dp) { return std::string(buf, g::format_number(x, dp, buf)); };
+  EXPECT_EQ("0", text(0, g::DP_THREE));
+  EXPECT_EQ("-795.97", text(-795.9700001, 2));
+  EXPECT_EQ("1.5", text(1.4999999, g::DP_THREE));
+  EXPECT_EQ("-12", text(-12.0004, g::DP_THREE));
+  EXPECT_EQ("1e+300", text(1e300, g::DP_THREE));
+  EXPECT_EQ("-0", text(-0.0001, g::DP_THREE));
+  EXPECT_EQ("1e+06", text(1e6, g::DP_THREE));  // scientific, when shorter
+  EXPECT_EQ("10000", text(1e4, g::DP_THREE));
+  EXPECT_EQ("1e-04", text(0.0001, g::DP_SIX));
+  EXPECT_EQ("0.0012", text(0.0012, g::DP_SIX));
+
+  // as std::to_chars (and std::format) of the rounded value
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> mantissa(-10, 10);
+  std::uniform_int_distribution<int> exponent(-12, 18);
+  for (int i = 0; i < 10000; ++i) {
+    double x = mantissa(gen) * std::pow(10, exponent(gen));
+    for (int dp : {-1, 0, 1, g::DP_THREE, g::DP_SIX, g::DP_NINE, 20}) {
+      char expected[32];
+      auto end = std::to_chars(expected, expected + sizeof(expected), g::round_to(x, dp)).ptr;
+      ASSERT_EQ(std::string(expected, end), text(x, dp));
+    }
+  }
+}
+
+TEST(WktWriter, Geometries) {
+  std::string wkt;
+  g::WktWriter writer(g::StringSink(wkt), 2);
+  writer.Write(g::Line2D::Make(g::Point2D(56491.62, -795.97), g::Point2D(-9137.37, 10.36)));
+  EXPECT_EQ("LINE (56491.62 -795.97, -9137.37 10.36)", wkt);
+
+  auto ray = g::Ray2D::Make(g::Point2D(1, 2), g::Vector2D(3, 4));
+  EXPECT_EQ(std::format("RAY (1 2, {} {})", g::round_to(ray.Direction().x(), g::DP_THREE),
+                        g::round_to(ray.Direction().y(), g::DP_THREE)),
+            ray.ToWkt());
+  EXPECT_EQ("POINT (1.23 -4)", g::Point2D(1.2345, -4).ToWkt(2));
+  EXPECT_EQ("VECTOR (0.5 0.25)", g::Vector2D(0.5, 0.25).ToWkt());
+  EXPECT_EQ("LINESTRING (0 0, 1 1)", g::LineSegment2D::Make(g::Point2D(0, 0), g::Point2D(1, 1)).ToWkt());
+  EXPECT_EQ("LINESTRING (0 0, 1 1, 2 0)", g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}}).ToWkt());
+}
+
+TEST(WktWriter, Sinks) {
+  auto point = g::Point2D(1, 2);
+
+  std::array<char, 16> buffer;
+  g::WktWriter fits(g::BufferSink(buffer), g::DP_THREE);
+  fits.Write(point);
+  EXPECT_EQ("POINT (1 2)", fits.GetSink().View());
+  EXPECT_ANY_THROW(fits.Write(point));  // no more space
+
+  std::vector<char> chars;
+  g::WktWriter iterator(g::IteratorSink(std::back_inserter(chars)));
+  iterator.Write(point);
+  EXPECT_EQ("POINT (1 2)", std::string(chars.begin(), chars.end()));
+}
+
+TEST(WktWriter, Batch) {
+  std::vector<g::Point2D> points{{0, 0}, {1.5, -2}, {3, 4}};
+  EXPECT_EQ("POINT (0 0)\nPOINT (1.5 -2)\nPOINT (3 4)", g::to_wkt(points));
+  EXPECT_EQ("POINT (0 0); POINT (2 -2); POINT (3 4)", g::to_wkt(points, 0, "; "));
+  EXPECT_EQ("", g::to_wkt(std::vector<g::Point2D>{}));
+
+  std::vector<g::Polyline2D> polylines{g::Polyline2D::Make({{0, 0}, {1, 1}, {2, 0}}),
+                                       g::Polyline2D::Make({{5, 5}, {6, 7}})};
+  std::string wkt = "GEOMETRIES\n";
+  g::append_wkt(wkt, std::span<g::Polyline2D const>(polylines));
+  EXPECT_EQ("GEOMETRIES\n" + polylines[0].ToWkt() + "\n" + polylines[1].ToWkt(), wkt);
+}
+
+}  // namespace geompp_tests
\ No newline at end of file